@@ -0,0 +1,139 @@
+// File:        art.h
+// Author:      Zakhary Kaplan <https://zakhary.dev>
+// Created:     17 Oct 2026
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include <stdbool.h> // for bool
+
+#include "zakc/types.h" // for usize
+
+// Adaptive radix tree structure
+//
+// Keys are arbitrary byte strings, and are stored in lexicographic order. A
+// key may be a prefix of another key, so C-strings can be used directly with
+// their length from `strlen()`. Keys are not copied, and must outlive their
+// items.
+struct art;
+
+/**
+ * Create a new adaptive radix tree.
+ *
+ * @return  Pointer to the newly-created tree, or `NULL` if memory allocation
+ *          failed.
+ */
+struct art *art_new(void);
+
+/**
+ * Delete the adaptive radix tree.
+ *
+ * @param tree  Pointer to the tree to delete.
+ */
+void art_drop(struct art *tree);
+
+/**
+ * Insert an item into the adaptive radix tree.
+ *
+ * If the key already exists in the tree, the item's data will be replaced with
+ * the new data.
+ *
+ * @param tree  Pointer to the tree.
+ * @param key   Key of the item to insert.
+ * @param len   Length of the key in bytes.
+ * @param data  Data of the item to insert.
+ * @return      `true` if the operation was successful, `false` otherwise.
+ */
+bool art_insert(struct art *tree, const void *key, usize len, void *data);
+
+/**
+ * Remove an item with the given key from the adaptive radix tree.
+ *
+ * @param tree  Pointer to the tree.
+ * @param key   Key of the item to remove.
+ * @param len   Length of the key in bytes.
+ * @return      Pointer to the removed data, or `NULL` if the key was not
+ *              found.
+ */
+void *art_remove(struct art *tree, const void *key, usize len);
+
+/**
+ * Check if a key is in the adaptive radix tree.
+ *
+ * @param tree  Pointer to the tree.
+ * @param key   Key to search for.
+ * @param len   Length of the key in bytes.
+ * @return      `true` if the key exists in the tree, `false` otherwise.
+ */
+bool art_contains(const struct art *tree, const void *key, usize len);
+
+/**
+ * Get the data associated with a key in the adaptive radix tree.
+ *
+ * @param tree  Pointer to the tree.
+ * @param key   Key to look up.
+ * @param len   Length of the key in bytes.
+ * @return      Pointer to the data associated with the key, or `NULL` if the
+ *              key was not found.
+ */
+void *art_get(const struct art *tree, const void *key, usize len);
+
+/**
+ * Get the number of items in the adaptive radix tree.
+ *
+ * @param tree  Pointer to the tree.
+ * @return      Number of items in the tree, or 0 if the tree is `NULL`.
+ */
+usize art_len(const struct art *tree);
+
+/**
+ * Iterate over the items in the adaptive radix tree in order of their keys.
+ *
+ * @param tree      Pointer to the tree.
+ * @param callback  Callback function to call for each item.
+ * @param context   User-defined context to pass to the callback function.
+ */
+void art_iter(
+    const struct art *tree,
+    void (*callback)(const void *key, usize len, void *data, void *context),
+    void *context
+);
+
+/**
+ * Iterate over the items whose keys start with a given prefix, in order.
+ *
+ * @param tree      Pointer to the tree.
+ * @param prefix    Prefix of the keys to visit.
+ * @param len       Length of the prefix in bytes.
+ * @param callback  Callback function to call for each item.
+ * @param context   User-defined context to pass to the callback function.
+ */
+void art_prefix(
+    const struct art *tree,
+    const void *prefix,
+    usize len,
+    void (*callback)(const void *key, usize len, void *data, void *context),
+    void *context
+);
+
+/**
+ * Iterate over the items in a range of keys, in order.
+ *
+ * @param tree      Pointer to the tree.
+ * @param lo        First key of the range, or `NULL` for no lower bound.
+ * @param lolen     Length of the first key in bytes.
+ * @param hi        Key one past the end of the range, or `NULL` for no upper
+ *                  bound.
+ * @param hilen     Length of the end key in bytes.
+ * @param callback  Callback function to call for each item.
+ * @param context   User-defined context to pass to the callback function.
+ */
+void art_range(
+    const struct art *tree,
+    const void *lo,
+    usize lolen,
+    const void *hi,
+    usize hilen,
+    void (*callback)(const void *key, usize len, void *data, void *context),
+    void *context
+);
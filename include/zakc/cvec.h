@@ -0,0 +1,118 @@
+// File:        cvec.h
+// Author:      Zakhary Kaplan <https://zakhary.dev>
+// Created:     17 Oct 2026
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include <stdbool.h> // for bool
+
+#include "zakc/types.h" // for usize
+
+// Concurrent vector structure
+//
+// Elements are stored in a table of buckets, where each bucket is twice the
+// size of the previous one. Buckets are never reallocated, so elements never
+// move once appended. Appending, getting and setting elements may be done
+// concurrently from any number of threads.
+struct cvec;
+
+/**
+ * Create a new concurrent vector.
+ *
+ * @return  Pointer to the newly-created concurrent vector, or `NULL` if
+ *          memory allocation failed.
+ */
+struct cvec *cvec_new(void);
+
+/**
+ * Delete the concurrent vector.
+ *
+ * This must not be called concurrently with any other operation.
+ *
+ * @param vec  Pointer to the concurrent vector to delete.
+ */
+void cvec_drop(struct cvec *vec);
+
+/**
+ * Append an element to the end of the concurrent vector.
+ *
+ * A slot is reserved atomically, so concurrent appends never contend on a
+ * lock. The element is published once the function returns.
+ *
+ * The slot is reserved even if allocating its bucket fails, in which case it
+ * reads as `NULL` until the element is published with `cvec_set()` at the
+ * index stored in `index`.
+ *
+ * @param vec    Pointer to the concurrent vector.
+ * @param data   Pointer to the element to append.
+ * @param index  Optional pointer to store the index of the element, which is
+ *               stored even if the operation fails.
+ * @return       `true` if the operation was successful, `false` otherwise.
+ */
+bool cvec_append(struct cvec *vec, void *data, usize *index);
+
+/**
+ * Reserve a contiguous range of elements at the end of the concurrent vector.
+ *
+ * The reserved elements are initialized to `NULL`, and can be filled in with
+ * `cvec_set()`. The range is reserved even if allocating its buckets fails,
+ * and can still be filled in with `cvec_set()`, which retries the allocation.
+ *
+ * @param vec    Pointer to the concurrent vector.
+ * @param n      Number of elements to reserve.
+ * @param index  Optional pointer to store the index of the first element,
+ *               which is stored even if the operation fails.
+ * @return       `true` if the operation was successful, `false` otherwise.
+ */
+bool cvec_grow_by(struct cvec *vec, usize n, usize *index);
+
+/**
+ * Get the element at a given index in the concurrent vector.
+ *
+ * This operation is wait-free.
+ *
+ * @param vec    Pointer to the concurrent vector.
+ * @param index  Index of the element to get.
+ * @return       Pointer to the element at the given index, or `NULL` if the
+ *               index is out of bounds or the element is not yet published.
+ */
+void *cvec_get(const struct cvec *vec, usize index);
+
+/**
+ * Set the element at a given index in the concurrent vector.
+ *
+ * @param vec    Pointer to the concurrent vector.
+ * @param index  Index of the element to set.
+ * @param data   Pointer to the element to set.
+ * @return       `true` if the operation was successful, `false` otherwise.
+ */
+bool cvec_set(struct cvec *vec, usize index, void *data);
+
+/**
+ * Get the number of elements in the concurrent vector.
+ *
+ * This includes elements which have been reserved but not yet published,
+ * including those whose reservation failed to allocate a bucket.
+ *
+ * @param vec  Pointer to the concurrent vector.
+ * @return     The number of elements in the concurrent vector.
+ */
+usize cvec_len(const struct cvec *vec);
+
+/**
+ * Get the capacity of the concurrent vector.
+ *
+ * @param vec  Pointer to the concurrent vector.
+ * @return     The number of elements that can be stored without allocating.
+ */
+usize cvec_capacity(const struct cvec *vec);
+
+/**
+ * Reserve a given amount of capacity for the concurrent vector.
+ *
+ * @param vec       Pointer to the concurrent vector.
+ * @param capacity  Amount of capacity to reserve.
+ * @return          `true` if the operation was successful, `false` otherwise.
+ */
+bool cvec_reserve(struct cvec *vec, usize capacity);
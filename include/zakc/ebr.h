@@ -0,0 +1,194 @@
+// File:        ebr.h
+// Author:      Zakhary Kaplan <https://zakhary.dev>
+// Created:     17 Oct 2026
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include <stdbool.h> // for bool
+
+#include "zakc/types.h" // for usize
+
+/*
+ * Epoch-Based Reclamation
+ */
+
+// Epoch-based reclamation domain
+//
+// Objects unlinked from a concurrent data structure are retired to the
+// domain, which frees them once no thread can still be reading them. Each
+// thread keeps its own lists of retired objects, which are freed in batches.
+struct ebr;
+
+// Mode of an epoch-based reclamation domain
+enum ebr_mode {
+    // Readers announce themselves on entering each critical section
+    EbrEpoch,
+    // Readers announce quiescent states between critical sections
+    EbrQsbr,
+};
+
+/**
+ * Create a new epoch-based reclamation domain.
+ *
+ * In `EbrEpoch` mode, entering a critical section costs a single atomic
+ * exchange, and threads need not do anything between critical sections.
+ *
+ * In `EbrQsbr` (quiescent-state-based reclamation) mode, entering and exiting
+ * a critical section costs no atomic read-modify-write operations at all.
+ * Instead, every thread which has entered a critical section is assumed to
+ * be reading until it calls `ebr_quiescent()` or `ebr_offline()`, so each
+ * thread must do so regularly for objects to be freed.
+ *
+ * @param mode  Mode of the domain.
+ * @return      Pointer to the newly-created domain, or `NULL` if memory
+ *              allocation failed.
+ */
+struct ebr *ebr_new(enum ebr_mode mode);
+
+/**
+ * Delete the epoch-based reclamation domain, freeing every retired object.
+ *
+ * This must not be called concurrently with any other operation.
+ *
+ * @param ebr  Pointer to the domain to delete.
+ */
+void ebr_drop(struct ebr *ebr);
+
+/**
+ * Enter a critical section, during which no object reachable by the calling
+ * thread will be freed.
+ *
+ * Critical sections may be nested.
+ *
+ * @param ebr  Pointer to the domain.
+ * @return     `true` if the operation was successful, `false` if memory
+ *             allocation failed while registering the thread.
+ */
+bool ebr_enter(struct ebr *ebr);
+
+/**
+ * Exit a critical section.
+ *
+ * @param ebr  Pointer to the domain.
+ */
+void ebr_exit(struct ebr *ebr);
+
+/**
+ * Announce that the calling thread holds no references to shared objects,
+ * then free any of its retired objects which are now safe to free.
+ *
+ * This must not be called within a critical section. In `EbrEpoch` mode it
+ * only attempts to free retired objects.
+ *
+ * @param ebr  Pointer to the domain.
+ */
+void ebr_quiescent(struct ebr *ebr);
+
+/**
+ * Take the calling thread offline, so that it is no longer waited for until
+ * it next enters a critical section.
+ *
+ * In `EbrQsbr` mode, threads must go offline before blocking for a long time
+ * or exiting. In `EbrEpoch` mode this has no effect.
+ *
+ * @param ebr  Pointer to the domain.
+ */
+void ebr_offline(struct ebr *ebr);
+
+/**
+ * Retire an object which has been unlinked from a shared data structure, to
+ * be freed once no thread can still be reading it.
+ *
+ * @param ebr   Pointer to the domain.
+ * @param ptr   Pointer to the object to retire.
+ * @param func  Function to free the object with, such as `free()`.
+ * @return      `true` if the object was retired, `false` if memory
+ *              allocation failed, in which case it will never be freed.
+ */
+bool ebr_retire(struct ebr *ebr, void *ptr, void (*func)(void *ptr));
+
+/*
+ * Hazard Pointers
+ */
+
+// Hazard pointer domain
+//
+// Each thread has a fixed number of hazard pointer slots, each of which
+// protects a single object from being freed. Unlike epoch-based reclamation,
+// a stalled thread can only keep the objects it protects from being freed,
+// so the number of retired objects awaiting reclamation stays bounded.
+struct hazard;
+
+/**
+ * Create a new hazard pointer domain.
+ *
+ * @param nslots  Number of hazard pointer slots per thread.
+ * @return        Pointer to the newly-created domain, or `NULL` if memory
+ *                allocation failed.
+ */
+struct hazard *hazard_new(usize nslots);
+
+/**
+ * Delete the hazard pointer domain, freeing every retired object.
+ *
+ * This must not be called concurrently with any other operation.
+ *
+ * @param hazard  Pointer to the domain to delete.
+ */
+void hazard_drop(struct hazard *hazard);
+
+/**
+ * Prepare the calling thread to protect objects.
+ *
+ * @param hazard  Pointer to the domain.
+ * @return        `true` if the operation was successful, `false` if memory
+ *                allocation failed while registering the thread.
+ */
+bool hazard_enter(struct hazard *hazard);
+
+/**
+ * Clear every hazard pointer slot of the calling thread.
+ *
+ * @param hazard  Pointer to the domain.
+ */
+void hazard_exit(struct hazard *hazard);
+
+/**
+ * Load a pointer from a shared location and protect the object it points to.
+ *
+ * The pointer is reloaded until it is known to have been protected before
+ * being retired. The calling thread must have called `hazard_enter()`.
+ *
+ * @param hazard  Pointer to the domain.
+ * @param slot    Index of the slot to protect the object with.
+ * @param src     Pointer to the shared location, an `_Atomic` pointer.
+ * @return        The protected pointer.
+ */
+void *hazard_protect(struct hazard *hazard, usize slot, const void *src);
+
+/**
+ * Protect an object with a hazard pointer slot.
+ *
+ * The caller must then check that the object is still reachable before
+ * reading it, such as by reloading the pointer it was read from. The calling
+ * thread must have called `hazard_enter()`.
+ *
+ * @param hazard  Pointer to the domain.
+ * @param slot    Index of the slot to protect the object with.
+ * @param ptr     Pointer to the object to protect, or `NULL` to clear the
+ *                slot.
+ */
+void hazard_set(struct hazard *hazard, usize slot, const void *ptr);
+
+/**
+ * Retire an object which has been unlinked from a shared data structure, to
+ * be freed once no hazard pointer protects it.
+ *
+ * @param hazard  Pointer to the domain.
+ * @param ptr     Pointer to the object to retire.
+ * @param func    Function to free the object with, such as `free()`.
+ * @return        `true` if the object was retired, `false` if memory
+ *                allocation failed, in which case it will never be freed.
+ */
+bool hazard_retire(struct hazard *hazard, void *ptr, void (*func)(void *ptr));
@@ -0,0 +1,189 @@
+// File:        gvec.h
+// Author:      Zakhary Kaplan <https://zakhary.dev>
+// Created:     17 Oct 2026
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include <stdbool.h> // for bool
+
+#include "zakc/types.h"  // for usize
+#include "zakc/vector.h" // for slice
+
+// Gap vector structure
+//
+// A gap vector is a vector whose unused capacity sits at a movable position
+// within its elements, rather than after them. Insertions and removals are
+// made at the gap, which only moves the elements between its old and new
+// positions. Edits clustered around one position therefore take amortized O(1)
+// time, however far they are from the end of the vector.
+struct gvec;
+
+/**
+ * Create a new gap vector.
+ *
+ * @return  Pointer to the newly-created gap vector, or `NULL` if memory
+ *          allocation failed.
+ */
+struct gvec *gvec_new(void);
+
+/**
+ * Set the destructor of the gap vector's elements.
+ *
+ * Once set, the gap vector owns its elements: they are destroyed when the
+ * gap vector is deleted or cleared, and when they are replaced by
+ * `gvec_set()`. Elements removed from the gap vector are returned to the
+ * caller instead.
+ *
+ * @param vec        Pointer to the gap vector.
+ * @param data_free  Destructor for elements, or `NULL` to not free elements.
+ */
+void gvec_set_free(struct gvec *vec, void (*data_free)(void *data));
+
+/**
+ * Delete the gap vector.
+ *
+ * Each element is passed to the gap vector's destructor, if any.
+ *
+ * @param vec  Pointer to the gap vector to delete.
+ */
+void gvec_drop(struct gvec *vec);
+
+/**
+ * Remove every element from the gap vector, keeping its capacity.
+ *
+ * Each element is passed to the gap vector's destructor, if any.
+ *
+ * @param vec  Pointer to the gap vector.
+ */
+void gvec_clear(struct gvec *vec);
+
+/**
+ * Append an element to the end of the gap vector.
+ *
+ * @param vec   Pointer to the gap vector.
+ * @param data  Pointer to the element to append.
+ * @return      `true` if the operation was successful, `false` otherwise.
+ */
+bool gvec_append(struct gvec *vec, void *data);
+
+/**
+ * Remove the last element of the gap vector.
+ *
+ * @param vec  Pointer to the gap vector.
+ * @return     Pointer to the removed element, or `NULL` if the gap vector is
+ *             empty.
+ */
+void *gvec_pop(struct gvec *vec);
+
+/**
+ * Insert an element into the gap vector.
+ *
+ * The gap is first moved to the index, then the element is placed at its
+ * start. Inserting again at the following index is then O(1).
+ *
+ * @param vec    Pointer to the gap vector.
+ * @param index  Index at which to insert the element.
+ * @param data   Pointer to the element to insert.
+ * @return       `true` if the operation was successful, `false` otherwise.
+ */
+bool gvec_insert(struct gvec *vec, usize index, void *data);
+
+/**
+ * Remove an element from the gap vector.
+ *
+ * The gap is moved to the element, which is then absorbed into it. Removing
+ * the element just before or just after the gap is O(1).
+ *
+ * @param vec    Pointer to the gap vector.
+ * @param index  Index of the element to remove.
+ * @return       Pointer to the removed element, or `NULL` if the operation
+ *               was invalid.
+ */
+void *gvec_remove(struct gvec *vec, usize index);
+
+/**
+ * Get an element from the gap vector.
+ *
+ * This is O(1), wherever the gap is.
+ *
+ * @param vec    Pointer to the gap vector.
+ * @param index  Index of the element to get.
+ * @return       Pointer to the element, or `NULL` if the index is out of
+ *               bounds.
+ */
+void *gvec_get(const struct gvec *vec, usize index);
+
+/**
+ * Set an element of the gap vector.
+ *
+ * @param vec    Pointer to the gap vector.
+ * @param index  Index of the element to set.
+ * @param data   Pointer to the element to set.
+ * @return       `true` if the operation was successful, `false` otherwise.
+ */
+bool gvec_set(struct gvec *vec, usize index, void *data);
+
+/**
+ * Get the number of elements in the gap vector.
+ *
+ * @param vec  Pointer to the gap vector.
+ * @return     The number of elements in the gap vector.
+ */
+usize gvec_len(const struct gvec *vec);
+
+/**
+ * Get the capacity of the gap vector.
+ *
+ * @param vec  Pointer to the gap vector.
+ * @return     The number of elements the gap vector can hold without
+ *             reallocating.
+ */
+usize gvec_capacity(const struct gvec *vec);
+
+/**
+ * Get the position of the gap, which is the index of the first element after
+ * it.
+ *
+ * @param vec  Pointer to the gap vector.
+ * @return     The position of the gap.
+ */
+usize gvec_gap(const struct gvec *vec);
+
+/**
+ * Move the gap to the given index.
+ *
+ * This moves the elements between the gap and the index, and is done
+ * implicitly by `gvec_insert()` and `gvec_remove()`.
+ *
+ * @param vec    Pointer to the gap vector.
+ * @param index  Index to move the gap to.
+ * @return       `true` if the operation was successful, `false` if the index
+ *               is out of bounds.
+ */
+bool gvec_seek(struct gvec *vec, usize index);
+
+/**
+ * Reserve a given amount of capacity for the gap vector.
+ *
+ * If the new capacity is smaller than the current size of the gap vector,
+ * the operation will be considered invalid.
+ *
+ * @param vec       Pointer to the gap vector.
+ * @param capacity  Amount of capacity to reserve.
+ * @return          `true` if the operation was successful, `false` otherwise.
+ */
+bool gvec_reserve(struct gvec *vec, usize capacity);
+
+/**
+ * Get a contiguous slice of every element of the gap vector.
+ *
+ * The gap is moved to the end of the gap vector, so that its elements lie in
+ * order at the start of its storage. The slice is invalidated by the next
+ * operation which moves the gap or the storage.
+ *
+ * @param vec  Pointer to the gap vector.
+ * @return     Slice of every element, or an empty slice if the gap vector is
+ *             `NULL`.
+ */
+struct slice gvec_as_slice(struct gvec *vec);
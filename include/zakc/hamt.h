@@ -0,0 +1,196 @@
+// File:        hamt.h
+// Author:      Zakhary Kaplan <https://zakhary.dev>
+// Created:     17 Oct 2026
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include <stdbool.h> // for bool
+
+#include "zakc/types.h" // for u64, usize
+
+// Persistent hash map structure
+//
+// Each `struct hamt` is a handle to one version of a hash array mapped trie.
+// Versions share their structure through reference-counted nodes, so
+// snapshots are O(1) and updates only copy the path to the changed item.
+// Handles may be passed to other threads, but a single handle must not be
+// used concurrently.
+struct hamt;
+
+// Kind of difference between two versions
+enum hamt_change {
+    HamtAdded,
+    HamtRemoved,
+    HamtChanged,
+};
+
+/**
+ * Create a new persistent hash map.
+ *
+ * @param hash  Hash function for keys.
+ * @param cmp   Comparison function for keys.
+ * @return      Pointer to the newly-created persistent hash map, or `NULL` if
+ *              memory allocation failed.
+ */
+struct hamt *hamt_new(
+    u64 (*hash)(const void *key),
+    bool (*cmp)(const void *left, const void *right)
+);
+
+/**
+ * Delete a version of the persistent hash map.
+ *
+ * Structure shared with other versions is kept alive until every version
+ * referencing it has been deleted.
+ *
+ * @param map  Pointer to the version to delete.
+ */
+void hamt_drop(struct hamt *map);
+
+/**
+ * Take a snapshot of the persistent hash map.
+ *
+ * This is an O(1) operation which shares all structure with the original.
+ *
+ * @param map  Pointer to the persistent hash map.
+ * @return     Pointer to the snapshot, or `NULL` if memory allocation failed.
+ */
+struct hamt *hamt_snapshot(const struct hamt *map);
+
+/**
+ * Create a new version with an item inserted.
+ *
+ * If the key already exists in the map, the item will be replaced with the
+ * new item.
+ *
+ * @param map   Pointer to the persistent hash map.
+ * @param key   Key of the item to insert.
+ * @param data  Data of the item to insert.
+ * @return      Pointer to the new version, or `NULL` if the operation failed.
+ */
+struct hamt *hamt_insert(const struct hamt *map, const void *key, void *data);
+
+/**
+ * Create a new version with the item with the given key removed.
+ *
+ * If the key is not present in the map, the new version is identical to the
+ * original.
+ *
+ * @param map  Pointer to the persistent hash map.
+ * @param key  Key of the item to remove.
+ * @return     Pointer to the new version, or `NULL` if the operation failed.
+ */
+struct hamt *hamt_remove(const struct hamt *map, const void *key);
+
+/**
+ * Check if a key is in the persistent hash map.
+ *
+ * @param map  The persistent hash map to search.
+ * @param key  The key to search for.
+ * @return     `true` if the key exists in the map, `false` otherwise.
+ */
+bool hamt_contains(const struct hamt *map, const void *key);
+
+/**
+ * Get the value associated with a key in the persistent hash map.
+ *
+ * @param map  Pointer to the persistent hash map.
+ * @param key  Key to look up.
+ * @return     Pointer to the value associated with the key, or `NULL` if the
+ *             item was not found.
+ */
+void *hamt_get(const struct hamt *map, const void *key);
+
+/**
+ * Get the number of items in the persistent hash map.
+ *
+ * @param map  Pointer to the persistent hash map.
+ * @return     Number of items in the persistent hash map, or 0 if the map is
+ *             `NULL`.
+ */
+usize hamt_len(const struct hamt *map);
+
+/**
+ * Iterate over the items in the persistent hash map.
+ *
+ * @param map       Pointer to the persistent hash map.
+ * @param callback  Callback function to call for each item.
+ * @param context   User-defined context to pass to the callback function.
+ */
+void hamt_iter(
+    const struct hamt *map,
+    void (*callback)(const void *key, void *data, void *context),
+    void *context
+);
+
+/**
+ * Iterate over the differences between two versions.
+ *
+ * Subtrees shared by both versions are skipped, so the cost is proportional
+ * to the size of the changes rather than the size of the maps. Items are
+ * considered changed if their data pointers differ.
+ *
+ * @param prev      Pointer to the older version.
+ * @param next      Pointer to the newer version.
+ * @param callback  Callback function to call for each difference, with the
+ *                  data in each version (`NULL` where absent).
+ * @param context   User-defined context to pass to the callback function.
+ */
+void hamt_diff(
+    const struct hamt *prev,
+    const struct hamt *next,
+    void (*callback)(
+        enum hamt_change change,
+        const void *key,
+        void *prev,
+        void *next,
+        void *context
+    ),
+    void *context
+);
+
+/*
+ * Transient Mode
+ */
+
+/**
+ * Create a transient (mutable) version of the persistent hash map.
+ *
+ * Transient versions are updated in place, only copying structure that is
+ * still shared with other versions. This makes them suitable for batch
+ * inserts.
+ *
+ * @param map  Pointer to the persistent hash map.
+ * @return     Pointer to the transient version, or `NULL` if memory
+ *             allocation failed.
+ */
+struct hamt *hamt_transient(const struct hamt *map);
+
+/**
+ * Freeze a transient version, making it persistent.
+ *
+ * @param map  Pointer to the transient version.
+ * @return     Pointer to the now-persistent version.
+ */
+struct hamt *hamt_persistent(struct hamt *map);
+
+/**
+ * Insert an item into a transient version.
+ *
+ * @param map   Pointer to the transient version.
+ * @param key   Key of the item to insert.
+ * @param data  Data of the item to insert.
+ * @return      `true` if the operation was successful, `false` otherwise.
+ */
+bool hamt_transient_insert(struct hamt *map, const void *key, void *data);
+
+/**
+ * Remove an item with the given key from a transient version.
+ *
+ * @param map  Pointer to the transient version.
+ * @param key  Key of the item to remove.
+ * @return     Pointer to the removed data, or `NULL` if the operation was
+ *             invalid.
+ */
+void *hamt_transient_remove(struct hamt *map, const void *key);
@@ -7,11 +7,23 @@
 
 #include <stdbool.h> // for bool
 
-#include "zakc/types.h" // for 64, usize
+#include "zakc/types.h" // for u64, usize
 
 // Hash map structure
 struct hashmap;
 
+// Number of bytes needed by `hashmap_init_in()` for a hash map of `n` items,
+// which is a constant expression if `n` is
+#define HASHMAP_SIZEOF(n)                                                      \
+    ((17 + (usize)(n) + (usize)(n) / 4) * sizeof(void *)                       \
+     + (usize)(n) * 4 * sizeof(u64))
+
+// Policy for keys present in both maps when merging
+enum hashmap_policy {
+    HashmapKeep,
+    HashmapReplace,
+};
+
 /*
  * Hash Functions
  */
@@ -21,6 +33,24 @@ bool str_cmp(const void *left, const void *right);
 // Raw bytes
 u64 bytes_hash(const void *key, usize len);
 bool bytes_cmp(const void *left, const void *right, usize len);
+// Integers and pointers, passed by value
+u64 u64_hash(const void *key);
+bool u64_cmp(const void *left, const void *right);
+
+// Get the high 64 bits of the product of two integers, which maps a well-mixed
+// hash `a` onto `[0, b)` without a division
+static inline u64 mulhi64(u64 a, u64 b) {
+#ifdef __SIZEOF_INT128__
+    return ((unsigned __int128)a * b) >> 64;
+#else
+    // Multiply the 32-bit halves, carrying the middle products into the high
+    // half
+    u64 lo = (a & 0xffffffff) * (b & 0xffffffff);
+    u64 mid = (a >> 32) * (b & 0xffffffff) + (lo >> 32);
+    u64 cross = (a & 0xffffffff) * (b >> 32) + (mid & 0xffffffff);
+    return (a >> 32) * (b >> 32) + (mid >> 32) + (cross >> 32);
+#endif
+}
 
 /**
  * Create a new hash map.
@@ -35,18 +65,131 @@ struct hashmap *hashmap_new(
     bool (*cmp)(const void *left, const void *right)
 );
 
+/**
+ * Create a new hash map keyed by 64-bit integers.
+ *
+ * Keys are stored by value rather than pointed to, and are passed by casting
+ * them to pointers (e.g. `(void *)(uintptr_t)id`). Keys are hashed with a
+ * built-in mixer and compared with `==`, without calling through function
+ * pointers.
+ *
+ * @return  Pointer to the newly-created hash map, or `NULL` if memory
+ *          allocation failed.
+ */
+struct hashmap *hashmap_new_u64(void);
+
+/**
+ * Create a new hash map keyed by pointer identity.
+ *
+ * Keys are compared by address rather than by the objects they point to.
+ * Keys are hashed with a built-in mixer and compared with `==`, without
+ * calling through function pointers.
+ *
+ * @return  Pointer to the newly-created hash map, or `NULL` if memory
+ *          allocation failed.
+ */
+struct hashmap *hashmap_new_ptr(void);
+
+/**
+ * Create a new hash map backed by a bucketized cuckoo table.
+ *
+ * Items are stored directly in buckets of several slots, each item having two
+ * candidate buckets. This sustains a load of 95% with no per-item allocation,
+ * and every lookup inspects at most two buckets. Inserting an item fails if
+ * it cannot be placed even after the table is grown a few times, as happens
+ * when too many keys share their hashes.
+ *
+ * If `concurrent` is set, lookups (`hashmap_contains()` and `hashmap_get()`)
+ * may run concurrently with each other and with a single writer. Writes must
+ * still be serialized by the caller. Tables outgrown by a concurrent map are
+ * only freed once the map is deleted. A lookup may still compare a key, or
+ * return data, which the writer has just removed or replaced, so removed keys
+ * and data must stay valid until every concurrent lookup has finished. In
+ * particular, the map should not have destructors while lookups run.
+ *
+ * @param hash        Hash function for keys.
+ * @param cmp         Comparison function for keys.
+ * @param concurrent  Whether to allow lookups concurrently with a writer.
+ * @return            Pointer to the newly-created hash map, or `NULL` if
+ *                    memory allocation failed.
+ */
+struct hashmap *hashmap_new_cuckoo(
+    u64 (*hash)(const void *key),
+    bool (*cmp)(const void *left, const void *right),
+    bool concurrent
+);
+
+/**
+ * Create a new fixed-capacity hash map in caller-provided memory.
+ *
+ * The map, its array of linked lists and a pool of items are stored entirely
+ * in the buffer, which must be aligned for a pointer. A buffer of
+ * `HASHMAP_SIZEOF(n)` bytes holds `n` items. No memory is ever allocated:
+ * items are taken from and returned to the pool, and inserting a new key once
+ * the pool is empty fails instead. Deleting the map destroys its keys and data
+ * but leaves the buffer to the caller.
+ *
+ * @param buf    Pointer to the buffer.
+ * @param bytes  Size of the buffer, in bytes.
+ * @param hash   Hash function for keys.
+ * @param cmp    Comparison function for keys.
+ * @return       Pointer to the hash map, which is at the start of the buffer,
+ *               or `NULL` if the buffer is `NULL`, misaligned or too small to
+ *               hold the map.
+ */
+struct hashmap *hashmap_init_in(
+    void *buf,
+    usize bytes,
+    u64 (*hash)(const void *key),
+    bool (*cmp)(const void *left, const void *right)
+);
+
+/**
+ * Set the destructors of the hash map's keys and data.
+ *
+ * Once set, the map owns the keys and data of its items: they are destroyed
+ * when the map is deleted or cleared, and when an insertion leaves them
+ * unused. Removing an item destroys its key, but returns its data to the
+ * caller. Destructors should not be set on a concurrent map, as a removed key
+ * may still be read by a concurrent lookup.
+ *
+ * @param map         Pointer to the hash map.
+ * @param key_free    Destructor for keys, or `NULL` to not free keys.
+ * @param value_free  Destructor for data, or `NULL` to not free data.
+ */
+void hashmap_set_free(
+    struct hashmap *map,
+    void (*key_free)(void *key),
+    void (*value_free)(void *data)
+);
+
 /**
  * Delete the hash map.
  *
+ * Every key and data is passed to the map's destructors, if any, in the same
+ * pass that frees the items.
+ *
  * @param map  Pointer to the hash map to delete.
  */
 void hashmap_drop(struct hashmap *map);
 
+/**
+ * Remove every item from the hash map, keeping its capacity.
+ *
+ * Every key and data is passed to the map's destructors, if any. A cuckoo
+ * table without destructors is cleared in constant time, by advancing a
+ * generation which marks every bucket as stale.
+ *
+ * @param map  Pointer to the hash map.
+ */
+void hashmap_clear(struct hashmap *map);
+
 /**
  * Insert an item into the hash map.
  *
  * If the key already exists in the map, the item will be replaced with the
- * new item.
+ * new item. The existing key is kept, so if the map has destructors, the
+ * new key and the replaced data are destroyed.
  *
  * @param map   Pointer to the hash map.
  * @param key   Key of the item to insert.
@@ -90,6 +233,8 @@ void *hashmap_get(const struct hashmap *map, const void *key);
 /**
  * Get the capacity of the hash map.
  *
+ * The capacity of a fixed-capacity map is the number of items in its pool.
+ *
  * @param map  Pointer to the hash map.
  * @return     The capacity of the hash map.
  */
@@ -109,7 +254,8 @@ usize hashmap_len(const struct hashmap *map);
  * If the given capacity is less than the current number of items, the function
  * will have no effect. If the given capacity is greater than the current number
  * of items, the capacity of the hash map will be increased to accommodate the
- * additional items.
+ * additional items. A fixed-capacity map is never resized, so this fails if
+ * the given capacity exceeds its pool.
  *
  * @param map       Pointer to the hash map.
  * @param capacity  Number of items to reserve space for.
@@ -129,3 +275,38 @@ void hashmap_iter(
     void (*callback)(const void *key, void *data, void *context),
     void *context
 );
+
+/**
+ * Create a copy of the hash map.
+ *
+ * The copy has the same capacity and layout as the original, so no keys are
+ * rehashed, and all of its items are allocated as a single block. Keys and
+ * data are shared with the original rather than copied, so the copy has no
+ * destructors.
+ *
+ * @param map  Pointer to the hash map to copy.
+ * @return     Pointer to the newly-created copy, or `NULL` if the map is
+ *             `NULL` or memory allocation failed.
+ */
+struct hashmap *hashmap_clone(const struct hashmap *map);
+
+/**
+ * Merge the items of one hash map into another, leaving it empty.
+ *
+ * The destination is resized at most once, and the source's stored hashes
+ * are reused if both maps use the same hash function. With `HashmapKeep`,
+ * keys already in the destination keep their data; with `HashmapReplace`,
+ * they take the data from the source. Each item is removed from the source
+ * as it is moved, and the destination takes ownership of its key and data,
+ * passing those it does not keep to its own destructors. The source's
+ * destructors are not transferred. If the merge fails, the items not yet
+ * moved remain in the source.
+ *
+ * @param dst     Pointer to the hash map to merge into.
+ * @param src     Pointer to the hash map to merge from.
+ * @param policy  Which data to keep for keys present in both maps.
+ * @return        `true` if the operation was successful, `false` otherwise.
+ */
+bool hashmap_merge(
+    struct hashmap *dst, struct hashmap *src, enum hashmap_policy policy
+);
@@ -0,0 +1,211 @@
+// File:        hashset.h
+// Author:      Zakhary Kaplan <https://zakhary.dev>
+// Created:     17 Oct 2026
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include <stdbool.h> // for bool
+
+#include "zakc/types.h" // for u64, usize
+
+// Hash set structure
+//
+// Keys are hashed and compared with the same functions as a hash map (see
+// `zakc/hashmap.h`), but no data is stored alongside them: each entry holds
+// only its key, the key's hash, and a link. Keys are not copied, and must
+// outlive the set unless it owns them (see `hashset_set_free()`).
+struct hashset;
+
+/**
+ * Create a new hash set.
+ *
+ * @param hash  Hash function for keys.
+ * @param cmp   Comparison function for keys.
+ * @return      Pointer to the newly-created hash set, or `NULL` if memory
+ *              allocation failed.
+ */
+struct hashset *hashset_new(
+    u64 (*hash)(const void *key),
+    bool (*cmp)(const void *left, const void *right)
+);
+
+/**
+ * Create a new hash set of 64-bit integers.
+ *
+ * Keys are stored by value rather than pointed to, and are passed by casting
+ * them to pointers (e.g. `(void *)(uintptr_t)id`). Keys are hashed with a
+ * built-in mixer and compared with `==`, without calling through function
+ * pointers.
+ *
+ * @return  Pointer to the newly-created hash set, or `NULL` if memory
+ *          allocation failed.
+ */
+struct hashset *hashset_new_u64(void);
+
+/**
+ * Create a new hash set of pointers, compared by address.
+ *
+ * @return  Pointer to the newly-created hash set, or `NULL` if memory
+ *          allocation failed.
+ */
+struct hashset *hashset_new_ptr(void);
+
+/**
+ * Set the destructor of the hash set's keys.
+ *
+ * Once set, the set owns its keys: they are destroyed when the set is deleted
+ * or cleared, when they are removed, and when inserting a key which is
+ * already present leaves the new key unused. Sets created by the set algebra
+ * below have no destructor, as their keys are shared with their operands.
+ *
+ * @param set       Pointer to the hash set.
+ * @param key_free  Destructor for keys, or `NULL` to not free keys.
+ */
+void hashset_set_free(struct hashset *set, void (*key_free)(void *key));
+
+/**
+ * Delete the hash set.
+ *
+ * Each key is passed to the set's destructor, if any.
+ *
+ * @param set  Pointer to the hash set to delete.
+ */
+void hashset_drop(struct hashset *set);
+
+/**
+ * Remove every key from the hash set, keeping its capacity.
+ *
+ * Each key is passed to the set's destructor, if any.
+ *
+ * @param set  Pointer to the hash set.
+ */
+void hashset_clear(struct hashset *set);
+
+/**
+ * Insert a key into the hash set.
+ *
+ * If the key is already in the set, the set is left unchanged, and the new
+ * key is passed to the set's destructor, if any, unless it is the same
+ * pointer as the stored key.
+ *
+ * @param set  Pointer to the hash set.
+ * @param key  Key to insert.
+ * @return     `true` if the operation was successful, `false` otherwise.
+ */
+bool hashset_insert(struct hashset *set, const void *key);
+
+/**
+ * Remove a key from the hash set.
+ *
+ * The stored key is passed to the set's destructor, if any.
+ *
+ * @param set  Pointer to the hash set.
+ * @param key  Key to remove.
+ * @return     `true` if the key was removed, `false` if it was not found.
+ */
+bool hashset_remove(struct hashset *set, const void *key);
+
+/**
+ * Check if a key is in the hash set.
+ *
+ * @param set  Pointer to the hash set.
+ * @param key  Key to search for.
+ * @return     `true` if the key exists in the set, `false` otherwise.
+ */
+bool hashset_contains(const struct hashset *set, const void *key);
+
+/**
+ * Get the capacity of the hash set.
+ *
+ * @param set  Pointer to the hash set.
+ * @return     Number of keys the set can hold before it needs to be resized.
+ */
+usize hashset_capacity(const struct hashset *set);
+
+/**
+ * Get the number of keys in the hash set.
+ *
+ * @param set  Pointer to the hash set.
+ * @return     Number of keys in the hash set, or 0 if the set is `NULL`.
+ */
+usize hashset_len(const struct hashset *set);
+
+/**
+ * Reserve space for a given number of keys in the hash set.
+ *
+ * @param set       Pointer to the hash set.
+ * @param capacity  Number of keys to reserve space for.
+ * @return          `true` if the operation was successful, `false` otherwise.
+ */
+bool hashset_reserve(struct hashset *set, usize capacity);
+
+/**
+ * Iterate over the keys in the hash set.
+ *
+ * @param set       Pointer to the hash set.
+ * @param callback  Callback function to call for each key.
+ * @param context   User-defined context to pass to the callback function.
+ */
+void hashset_iter(
+    const struct hashset *set,
+    void (*callback)(const void *key, void *context),
+    void *context
+);
+
+/*
+ * Set Algebra
+ *
+ * Both operands must use the same hash and comparison functions, which the
+ * resulting set inherits. Results are presized for their largest possible
+ * size, and each operation iterates the smaller operand where it can. Keys
+ * are never rehashed, as each key's hash is stored alongside it.
+ */
+
+/**
+ * Create the union of two hash sets.
+ *
+ * @param left   Pointer to the left hash set.
+ * @param right  Pointer to the right hash set.
+ * @return       Pointer to a new set of the keys in either set, or `NULL` if
+ *               memory allocation failed.
+ */
+struct hashset *hashset_union(
+    const struct hashset *left, const struct hashset *right
+);
+
+/**
+ * Create the intersection of two hash sets.
+ *
+ * @param left   Pointer to the left hash set.
+ * @param right  Pointer to the right hash set.
+ * @return       Pointer to a new set of the keys in both sets, or `NULL` if
+ *               memory allocation failed.
+ */
+struct hashset *hashset_intersection(
+    const struct hashset *left, const struct hashset *right
+);
+
+/**
+ * Create the difference of two hash sets.
+ *
+ * @param left   Pointer to the left hash set.
+ * @param right  Pointer to the right hash set.
+ * @return       Pointer to a new set of the keys in the left set but not the
+ *               right set, or `NULL` if memory allocation failed.
+ */
+struct hashset *hashset_difference(
+    const struct hashset *left, const struct hashset *right
+);
+
+/**
+ * Check if every key of one hash set is in another.
+ *
+ * @param left   Pointer to the candidate subset.
+ * @param right  Pointer to the candidate superset.
+ * @return       `true` if every key of the left set is in the right set,
+ *               `false` otherwise.
+ */
+bool hashset_is_subset(
+    const struct hashset *left, const struct hashset *right
+);
@@ -7,11 +7,18 @@
 
 #include <stdbool.h> // for bool
 
-#include "zakc/types.h" // for usize
+#include "zakc/types.h" // for i32, usize
 
 // Linked list structure
 struct list;
 
+// Number of bytes needed by `list_init_in()` for a linked list of `n` items,
+// which is a constant expression if `n` is
+#define LIST_SIZEOF(n) ((8 + 3 * (usize)(n)) * sizeof(void *))
+
+// Vector structure
+struct vector;
+
 /**
  * Create a new linked list.
  *
@@ -20,13 +27,55 @@ struct list;
  */
 struct list *list_new(void);
 
+/**
+ * Create a new fixed-capacity linked list in caller-provided memory.
+ *
+ * The list and a pool of nodes are stored entirely in the buffer, which must
+ * be aligned for a pointer. A buffer of `LIST_SIZEOF(n)` bytes holds `n`
+ * nodes. No memory is ever allocated: nodes are taken from and returned to
+ * the pool, and operations that need a node once the pool is empty fail
+ * instead. Deleting the list destroys its data but leaves the buffer to the
+ * caller.
+ *
+ * @param buf    Pointer to the buffer.
+ * @param bytes  Size of the buffer, in bytes.
+ * @return       Pointer to the linked list, which is at the start of the
+ *               buffer, or `NULL` if the buffer is `NULL`, misaligned or too
+ *               small to hold the list.
+ */
+struct list *list_init_in(void *buf, usize bytes);
+
+/**
+ * Set the destructor of the linked list's data.
+ *
+ * Once set, the list owns its items' data: it is destroyed when the list is
+ * deleted or cleared, and when it is replaced by `list_set()`. Data removed
+ * from the list is returned to the caller instead.
+ *
+ * @param list       Pointer to the linked list.
+ * @param data_free  Destructor for data, or `NULL` to not free data.
+ */
+void list_set_free(struct list *list, void (*data_free)(void *data));
+
 /**
  * Delete the linked list.
  *
+ * Each item's data is passed to the list's destructor, if any, in the same
+ * pass that frees the nodes.
+ *
  * @param list  Pointer to the linked list to delete.
  */
 void list_drop(struct list *list);
 
+/**
+ * Remove every item from the linked list.
+ *
+ * Each item's data is passed to the list's destructor, if any.
+ *
+ * @param list  Pointer to the linked list.
+ */
+void list_clear(struct list *list);
+
 /**
  * Append an item to the end of the linked list.
  *
@@ -83,6 +132,60 @@ bool list_insert(struct list *list, usize index, void *data);
  */
 void *list_remove(struct list *list, usize index);
 
+/**
+ * Keep only the items of the linked list which satisfy a predicate.
+ *
+ * Items which are not kept are unlinked in a single pass, and their data is
+ * passed to the list's destructor, if any.
+ *
+ * @param list     Pointer to the linked list.
+ * @param pred     Predicate which returns `true` for items to keep.
+ * @param context  User-defined context to pass to the predicate.
+ * @return         `true` if the operation was successful, `false` otherwise.
+ */
+bool list_retain(
+    struct list *list, bool (*pred)(void *data, void *context), void *context
+);
+
+/**
+ * Sort the linked list.
+ *
+ * The sort is a stable, bottom-up merge sort of the natural runs of the list,
+ * which relinks the existing nodes without allocating any memory. It takes
+ * O(n log n) time, or O(n) time if the list is already sorted in either
+ * direction.
+ *
+ * @param list  Pointer to the linked list.
+ * @param cmp   Comparison function for data, returning a negative, zero or
+ *              positive value if the left data is less than, equal to or
+ *              greater than the right data.
+ * @return      `true` if the operation was successful, `false` otherwise.
+ */
+bool list_sort(
+    struct list *list, i32 (*cmp)(const void *left, const void *right)
+);
+
+/**
+ * Merge a sorted linked list into another, leaving it empty.
+ *
+ * The nodes of the source are relinked into the destination in O(n) time,
+ * with items of the destination first among those which compare equal. The
+ * source's destructor is not transferred. Memory is only allocated if both
+ * lists hold nodes allocated as a block by `vector_to_list()`. If either list
+ * was created by `list_init_in()`, the source's data is instead copied into
+ * nodes of the destination, and the merge fails if it has too few nodes left.
+ *
+ * @param dst  Pointer to the sorted linked list to merge into.
+ * @param src  Pointer to the sorted linked list to merge from.
+ * @param cmp  Comparison function for data, as for `list_sort()`.
+ * @return     `true` if the operation was successful, `false` otherwise.
+ */
+bool list_merge(
+    struct list *dst,
+    struct list *src,
+    i32 (*cmp)(const void *left, const void *right)
+);
+
 /**
  * Reverse the linked list.
  *
@@ -128,3 +231,31 @@ bool list_set(struct list *list, usize index, void *data);
  *              `NULL`.
  */
 usize list_len(const struct list *list);
+
+/**
+ * Create a vector holding the items of the linked list.
+ *
+ * The data of each item is copied into a single array, which the vector
+ * adopts without copying it again. The list is left unchanged, and the
+ * vector has no destructor.
+ *
+ * @param list  Pointer to the linked list.
+ * @return      Pointer to the newly-created vector, or `NULL` if the list is
+ *              `NULL` or memory allocation failed.
+ */
+struct vector *list_to_vector(const struct list *list);
+
+/**
+ * Create a linked list holding the elements of a vector.
+ *
+ * Every node is allocated as part of a single block, in order, so the list
+ * costs one allocation and is traversed sequentially in memory. Nodes of the
+ * block which are removed from the list are only freed along with the whole
+ * block, once the list is cleared or deleted. The vector is left unchanged,
+ * and the list has no destructor.
+ *
+ * @param vec  Pointer to the vector.
+ * @return     Pointer to the newly-created linked list, or `NULL` if the
+ *             vector is `NULL` or memory allocation failed.
+ */
+struct list *vector_to_list(const struct vector *vec);
@@ -0,0 +1,99 @@
+// File:        phash.h
+// Author:      Zakhary Kaplan <https://zakhary.dev>
+// Created:     17 Oct 2026
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include <stdbool.h> // for bool
+
+#include "zakc/types.h" // for u8, u32, u64, usize
+
+// Static perfect hash table structure
+//
+// A perfect hash table maps a fixed set of C-string keys to distinct slots,
+// one per key, so that a lookup costs a single hash and a single comparison.
+// Tables are generated ahead of time as C source by `src/bin/tools/phash/gen.c`
+// and are read-only, so they need no construction at runtime.
+//
+// Keys are hashed with FNV-1a rather than `str_hash()`, whose hashes of short
+// strings often collide, and no seed can separate keys with equal hashes. The
+// hash selects a bucket, whose seed then displaces each of the bucket's keys
+// into its own slot.
+struct phash {
+    // Number of keys, which is also the number of slots
+    usize len;
+    // Number of buckets
+    usize nbuckets;
+    // Seed of each bucket
+    const u32 *seeds;
+    // Key in each slot
+    const char *const *keys;
+    // Position of the key in each slot within the list it was generated from
+    const usize *ranks;
+    // Data of the key in each slot, or `NULL` if the table has no data
+    void *const *values;
+};
+
+// Hash a key
+static inline u64 phash_hash(const char *key) {
+    u64 hash = 0xcbf29ce484222325ull;
+    for (const u8 *c = (const u8 *)key; *c; c++)
+        // hash xor c, times the FNV prime
+        hash = (hash ^ *c) * 0x100000001b3ull;
+    return hash;
+}
+
+// Mix the bits of a hash
+static inline u64 phash_mix(u64 hash) {
+    hash ^= hash >> 33;
+    hash *= 0xff51afd7ed558ccdull;
+    hash ^= hash >> 33;
+    hash *= 0xc4ceb9fe1a85ec53ull;
+    hash ^= hash >> 33;
+    return hash;
+}
+
+// Get the bucket of a key's hash
+static inline usize phash_bucket(u64 hash, usize nbuckets) {
+    return phash_mix(hash) % nbuckets;
+}
+
+// Get the slot of a key's hash, given the seed of its bucket
+static inline usize phash_slot(u64 hash, u32 seed, usize len) {
+    return phash_mix(hash ^ (seed * 0x9e3779b97f4a7c15ull)) % len;
+}
+
+/**
+ * Get the position of a key within the list the table was generated from.
+ *
+ * Positions are stable across regenerations as long as the list is, so they
+ * can be given names (such as by the generator's `-p` option) and used in a
+ * `switch` statement.
+ *
+ * @param table  Pointer to the table.
+ * @param key    Key to look up.
+ * @return       Position of the key, or the number of keys in the table if
+ *               the table or key is `NULL` or the key was not found.
+ */
+usize phash_index(const struct phash *table, const char *key);
+
+/**
+ * Check if a key is in the table.
+ *
+ * @param table  Pointer to the table.
+ * @param key    Key to search for.
+ * @return       `true` if the key exists in the table, `false` otherwise.
+ */
+bool phash_contains(const struct phash *table, const char *key);
+
+/**
+ * Get the data associated with a key in the table.
+ *
+ * @param table  Pointer to the table.
+ * @param key    Key to look up.
+ * @return       Pointer to the data associated with the key, or `NULL` if the
+ *               table or key is `NULL`, the table has no data, or the key was
+ *               not found.
+ */
+void *phash_get(const struct phash *table, const char *key);
@@ -0,0 +1,93 @@
+// File:        pool.h
+// Author:      Zakhary Kaplan <https://zakhary.dev>
+// Created:     17 Oct 2026
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include <stdbool.h> // for bool
+
+#include "zakc/types.h" // for usize
+
+// Thread pool structure
+//
+// Each worker thread owns a work-stealing deque. Tasks spawned from a worker
+// are pushed onto its own deque, while idle workers steal from the others.
+// Tasks spawned from outside the pool are placed in a shared queue.
+struct pool;
+
+// Task structure
+struct task;
+
+/**
+ * Create a new thread pool.
+ *
+ * @param nthreads  Number of worker threads, or 0 to use one per online CPU.
+ * @param pin       Whether to pin each worker thread to its own CPU, chosen
+ *                  among those the calling thread may run on.
+ * @return          Pointer to the newly-created thread pool, or `NULL` if
+ *                  memory allocation, thread creation, or pinning failed.
+ */
+struct pool *pool_new(usize nthreads, bool pin);
+
+/**
+ * Delete the thread pool.
+ *
+ * Every spawned task must have been joined beforehand.
+ *
+ * @param pool  Pointer to the thread pool to delete.
+ */
+void pool_drop(struct pool *pool);
+
+/**
+ * Get the number of worker threads in the thread pool.
+ *
+ * @param pool  Pointer to the thread pool.
+ * @return      The number of worker threads, or 0 if the pool is `NULL`.
+ */
+usize pool_nthreads(const struct pool *pool);
+
+/**
+ * Spawn (fork) a task on the thread pool.
+ *
+ * @param pool  Pointer to the thread pool.
+ * @param func  Function to run.
+ * @param arg   Argument to pass to the function.
+ * @return      Pointer to the spawned task, which must be joined with
+ *              `pool_join()`, or `NULL` if memory allocation failed.
+ */
+struct task *pool_spawn(struct pool *pool, void (*func)(void *arg), void *arg);
+
+/**
+ * Wait for (join) a spawned task to finish, then delete it.
+ *
+ * While waiting, the calling thread runs other tasks from the pool.
+ *
+ * @param pool  Pointer to the thread pool.
+ * @param task  Pointer to the task to join.
+ */
+void pool_join(struct pool *pool, struct task *task);
+
+/**
+ * Run a function over a range of indices in parallel.
+ *
+ * The range is recursively split in half until each chunk is no larger than
+ * the grain size, with chunks being stolen by idle workers. The function
+ * returns once every chunk has finished.
+ *
+ * @param pool     Pointer to the thread pool.
+ * @param start    First index of the range.
+ * @param end      One past the last index of the range.
+ * @param grain    Maximum number of indices per chunk, or 0 to choose one
+ *                 based on the size of the range and the number of workers.
+ * @param body     Function to call for each chunk of indices.
+ * @param context  User-defined context to pass to the function.
+ */
+void pool_parallel_for(
+    struct pool *pool,
+    usize start,
+    usize end,
+    usize grain,
+    void (*body)(usize start, usize end, void *context),
+    void *context
+);
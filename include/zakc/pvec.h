@@ -0,0 +1,168 @@
+// File:        pvec.h
+// Author:      Zakhary Kaplan <https://zakhary.dev>
+// Created:     17 Oct 2026
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include <stdbool.h> // for bool
+
+#include "zakc/types.h"  // for usize
+#include "zakc/vector.h" // for vector
+
+// Persistent vector structure
+//
+// Each `struct pvec` is a handle to one version of the vector. Versions share
+// their structure through a reference-counted 32-way trie, so snapshots are
+// O(1) and updates only copy the path to the changed element. Handles may be
+// passed to other threads, but a single handle must not be used concurrently.
+struct pvec;
+
+/**
+ * Create a new persistent vector.
+ *
+ * @return  Pointer to the newly-created persistent vector, or `NULL` if
+ *          memory allocation failed.
+ */
+struct pvec *pvec_new(void);
+
+/**
+ * Create a new persistent vector from the elements of a vector.
+ *
+ * @param vec  Pointer to the vector whose elements will be copied.
+ * @return     Pointer to the newly-created persistent vector, or `NULL` if
+ *             memory allocation failed.
+ */
+struct pvec *pvec_from_vector(const struct vector *vec);
+
+/**
+ * Delete a version of the persistent vector.
+ *
+ * Structure shared with other versions is kept alive until every version
+ * referencing it has been deleted.
+ *
+ * @param vec  Pointer to the version to delete.
+ */
+void pvec_drop(struct pvec *vec);
+
+/**
+ * Take a snapshot of the persistent vector.
+ *
+ * This is an O(1) operation which shares all structure with the original.
+ *
+ * @param vec  Pointer to the persistent vector.
+ * @return     Pointer to the snapshot, or `NULL` if memory allocation failed.
+ */
+struct pvec *pvec_snapshot(const struct pvec *vec);
+
+/**
+ * Create a new version with an element appended to the end.
+ *
+ * @param vec   Pointer to the persistent vector.
+ * @param data  Pointer to the element to append.
+ * @return      Pointer to the new version, or `NULL` if the operation failed.
+ */
+struct pvec *pvec_append(const struct pvec *vec, void *data);
+
+/**
+ * Create a new version with the element at a given index replaced.
+ *
+ * @param vec    Pointer to the persistent vector.
+ * @param index  Index of the element to set.
+ * @param data   Pointer to the element to set.
+ * @return       Pointer to the new version, or `NULL` if the operation failed.
+ */
+struct pvec *pvec_set(const struct pvec *vec, usize index, void *data);
+
+/**
+ * Create a new version with the last element removed.
+ *
+ * @param vec  Pointer to the persistent vector.
+ * @return     Pointer to the new version, or `NULL` if the vector is empty or
+ *             the operation failed.
+ */
+struct pvec *pvec_pop(const struct pvec *vec);
+
+/**
+ * Get the element at a given index in the persistent vector.
+ *
+ * @param vec    Pointer to the persistent vector.
+ * @param index  Index of the element to get.
+ * @return       Pointer to the element at the given index, or `NULL` if the
+ *               index is out of bounds.
+ */
+void *pvec_get(const struct pvec *vec, usize index);
+
+/**
+ * Get the number of elements in the persistent vector.
+ *
+ * @param vec  Pointer to the persistent vector.
+ * @return     The number of elements in the persistent vector.
+ */
+usize pvec_len(const struct pvec *vec);
+
+/**
+ * Iterate over the elements in the persistent vector.
+ *
+ * @param vec       Pointer to the persistent vector.
+ * @param callback  Callback function to call for each element.
+ * @param context   User-defined context to pass to the callback function.
+ */
+void pvec_iter(
+    const struct pvec *vec,
+    void (*callback)(void *data, void *context),
+    void *context
+);
+
+/*
+ * Transient Mode
+ */
+
+/**
+ * Create a transient (mutable) version of the persistent vector.
+ *
+ * Transient versions are updated in place, only copying structure that is
+ * still shared with other versions. This makes them suitable for building
+ * vectors in bulk.
+ *
+ * @param vec  Pointer to the persistent vector.
+ * @return     Pointer to the transient version, or `NULL` if memory
+ *             allocation failed.
+ */
+struct pvec *pvec_transient(const struct pvec *vec);
+
+/**
+ * Freeze a transient version, making it persistent.
+ *
+ * @param vec  Pointer to the transient version.
+ * @return     Pointer to the now-persistent version.
+ */
+struct pvec *pvec_persistent(struct pvec *vec);
+
+/**
+ * Append an element to the end of a transient version.
+ *
+ * @param vec   Pointer to the transient version.
+ * @param data  Pointer to the element to append.
+ * @return      `true` if the operation was successful, `false` otherwise.
+ */
+bool pvec_transient_append(struct pvec *vec, void *data);
+
+/**
+ * Set the element at a given index in a transient version.
+ *
+ * @param vec    Pointer to the transient version.
+ * @param index  Index of the element to set.
+ * @param data   Pointer to the element to set.
+ * @return       `true` if the operation was successful, `false` otherwise.
+ */
+bool pvec_transient_set(struct pvec *vec, usize index, void *data);
+
+/**
+ * Remove the last element from a transient version.
+ *
+ * @param vec  Pointer to the transient version.
+ * @return     Pointer to the removed element, or `NULL` if the operation was
+ *             invalid.
+ */
+void *pvec_transient_pop(struct pvec *vec);
@@ -0,0 +1,191 @@
+// File:        rope.h
+// Author:      Zakhary Kaplan <https://zakhary.dev>
+// Created:     17 Oct 2026
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include <stdbool.h> // for bool
+
+#include "zakc/types.h" // for usize
+
+// Rope structure
+//
+// A rope is a sequence stored in a counted B-tree. Items are kept in leaves
+// of up to 64 pointers, and each branch records how many items lie below each
+// of its children, so that items can be reached, inserted and removed by index
+// in O(log n) time. Unlike a vector, no operation moves more than a few nodes'
+// worth of items.
+struct rope;
+
+/**
+ * Create a new rope.
+ *
+ * @return  Pointer to the newly-created rope, or `NULL` if memory allocation
+ *          failed.
+ */
+struct rope *rope_new(void);
+
+/**
+ * Set the destructor of the rope's data.
+ *
+ * Once set, the rope owns its items' data: it is destroyed when the rope is
+ * deleted or cleared, and when it is replaced by `rope_set()`. Data removed
+ * from the rope is returned to the caller instead.
+ *
+ * @param rope       Pointer to the rope.
+ * @param data_free  Destructor for data, or `NULL` to not free data.
+ */
+void rope_set_free(struct rope *rope, void (*data_free)(void *data));
+
+/**
+ * Delete the rope.
+ *
+ * Each item's data is passed to the rope's destructor, if any.
+ *
+ * @param rope  Pointer to the rope to delete.
+ */
+void rope_drop(struct rope *rope);
+
+/**
+ * Remove every item from the rope.
+ *
+ * Each item's data is passed to the rope's destructor, if any.
+ *
+ * @param rope  Pointer to the rope.
+ */
+void rope_clear(struct rope *rope);
+
+/**
+ * Append an item to the end of the rope.
+ *
+ * @param rope  Pointer to the rope.
+ * @param data  Data of the item to append.
+ * @return      `true` if the operation was successful, `false` otherwise.
+ */
+bool rope_append(struct rope *rope, void *data);
+
+/**
+ * Prepend an item to the beginning of the rope.
+ *
+ * @param rope  Pointer to the rope.
+ * @param data  Data of the item to prepend.
+ * @return      `true` if the operation was successful, `false` otherwise.
+ */
+bool rope_prepend(struct rope *rope, void *data);
+
+/**
+ * Remove the last item from the rope.
+ *
+ * @param rope  Pointer to the rope.
+ * @return      Pointer to the removed element, or `NULL` if the operation was
+ *              invalid.
+ */
+void *rope_pop(struct rope *rope);
+
+/**
+ * Remove the first item from the rope.
+ *
+ * @param rope  Pointer to the rope.
+ * @return      Pointer to the removed element, or `NULL` if the operation was
+ *              invalid.
+ */
+void *rope_shift(struct rope *rope);
+
+/**
+ * Insert an item at the given index in the rope.
+ *
+ * This takes O(log n) time. Memory is only allocated when a full node cannot
+ * pass an item to a neighbour, and the rope is left unchanged if allocation
+ * fails.
+ *
+ * @param rope  Pointer to the rope.
+ * @param index Index at which to insert the item.
+ * @param data  Data of the item to insert.
+ * @return      `true` if the operation was successful, `false` otherwise.
+ */
+bool rope_insert(struct rope *rope, usize index, void *data);
+
+/**
+ * Remove the item at the given index from the rope.
+ *
+ * This takes O(log n) time, and never allocates memory.
+ *
+ * @param rope  Pointer to the rope.
+ * @param index Index of the item to remove.
+ * @return      Pointer to the removed element, or `NULL` if the operation was
+ *              invalid.
+ */
+void *rope_remove(struct rope *rope, usize index);
+
+/**
+ * Get the item at the given index in the rope.
+ *
+ * @param rope  Pointer to the rope.
+ * @param index Index of the item to get.
+ * @return      Pointer to the item at the given index, or `NULL` if the index
+ *              is out of bounds or the rope is `NULL`.
+ */
+void *rope_get(const struct rope *rope, usize index);
+
+/**
+ * Set the item at the given index in the rope.
+ *
+ * @param rope  Pointer to the rope.
+ * @param index Index of the item to set.
+ * @param data  Data of the item to set.
+ * @return      `true` if the operation was successful, `false` otherwise.
+ */
+bool rope_set(struct rope *rope, usize index, void *data);
+
+/**
+ * Get the length of the rope.
+ *
+ * @param rope  Pointer to the rope.
+ * @return      The number of items in the rope, or 0 if the rope is `NULL`.
+ */
+usize rope_len(const struct rope *rope);
+
+/**
+ * Iterate over the items in the rope, in order.
+ *
+ * Items are visited one leaf at a time, so iterating takes O(n) time rather
+ * than the O(n log n) of calling `rope_get()` for every index.
+ *
+ * @param rope      Pointer to the rope.
+ * @param callback  Callback function to call for each item.
+ * @param context   User-defined context to pass to the callback function.
+ */
+void rope_iter(
+    const struct rope *rope,
+    void (*callback)(void *data, void *context),
+    void *context
+);
+
+/**
+ * Split the rope in two at the given index.
+ *
+ * The items from the index onwards are moved into a new rope, which takes
+ * the rope's destructor. Only the nodes along the path to the index are
+ * touched, so this takes O(log n) time.
+ *
+ * @param rope   Pointer to the rope.
+ * @param index  Index of the first item to move.
+ * @return       Pointer to the newly-created rope, or `NULL` if the index is
+ *               out of bounds or memory allocation failed, in which case the
+ *               rope is left unchanged.
+ */
+struct rope *rope_split(struct rope *rope, usize index);
+
+/**
+ * Concatenate a rope onto the end of another, leaving it empty.
+ *
+ * The shorter tree is grafted onto the side of the taller one, so this takes
+ * O(log n) time. The source's destructor is not transferred.
+ *
+ * @param dst  Pointer to the rope to append to.
+ * @param src  Pointer to the rope whose items are appended.
+ * @return     `true` if the operation was successful, `false` if memory
+ *             allocation failed, in which case both ropes keep their items.
+ */
+bool rope_concat(struct rope *dst, struct rope *src);
@@ -0,0 +1,156 @@
+// File:        shardmap.h
+// Author:      Zakhary Kaplan <https://zakhary.dev>
+// Created:     17 Oct 2026
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include <stdbool.h> // for bool
+
+#include "zakc/types.h" // for u64, usize
+
+// Hash map structure
+struct hashmap;
+
+// Sharded hash map structure
+//
+// Items are partitioned by the high bits of their hash into shards, each
+// being a hash map placed on one NUMA node. Every shard has an owner thread
+// pinned to the CPUs of its node, whose allocations prefer that node's
+// memory, so work routed to the owner with `shardmap_submit()` only touches
+// local memory. Shards may also be accessed directly from any thread.
+struct shardmap;
+
+/**
+ * Create a new sharded hash map.
+ *
+ * Shards are assigned to NUMA nodes round-robin. On systems without NUMA
+ * support, every shard is placed on a single node.
+ *
+ * @param hash     Hash function for keys.
+ * @param cmp      Comparison function for keys.
+ * @param nshards  Number of shards, or 0 to use one per NUMA node.
+ * @return         Pointer to the newly-created sharded hash map, or `NULL` if
+ *                 memory allocation or thread creation failed.
+ */
+struct shardmap *shardmap_new(
+    u64 (*hash)(const void *key),
+    bool (*cmp)(const void *left, const void *right),
+    usize nshards
+);
+
+/**
+ * Delete the sharded hash map.
+ *
+ * Any submitted work is finished before the owner threads are stopped.
+ *
+ * @param map  Pointer to the sharded hash map to delete.
+ */
+void shardmap_drop(struct shardmap *map);
+
+/**
+ * Get the number of shards in the sharded hash map.
+ *
+ * @param map  Pointer to the sharded hash map.
+ * @return     Number of shards, or 0 if the map is `NULL`.
+ */
+usize shardmap_nshards(const struct shardmap *map);
+
+/**
+ * Get the shard owning a key.
+ *
+ * @param map  Pointer to the sharded hash map.
+ * @param key  Key to look up.
+ * @return     Index of the shard owning the key.
+ */
+usize shardmap_shard(const struct shardmap *map, const void *key);
+
+/**
+ * Get the NUMA node on which a shard is placed.
+ *
+ * @param map    Pointer to the sharded hash map.
+ * @param shard  Index of the shard.
+ * @return       Index of the NUMA node of the shard.
+ */
+usize shardmap_node(const struct shardmap *map, usize shard);
+
+/**
+ * Insert an item into the sharded hash map from the calling thread.
+ *
+ * If the key already exists in the map, the item's data will be replaced with
+ * the new data. The item is allocated by the calling thread, so it is only
+ * local to the shard if the calling thread runs on the shard's node.
+ *
+ * @param map   Pointer to the sharded hash map.
+ * @param key   Key of the item to insert.
+ * @param data  Data of the item to insert.
+ * @return      `true` if the operation was successful, `false` otherwise.
+ */
+bool shardmap_insert(struct shardmap *map, const void *key, void *data);
+
+/**
+ * Remove an item with the given key from the sharded hash map.
+ *
+ * @param map  Pointer to the sharded hash map.
+ * @param key  Key of the item to remove.
+ * @return     Pointer to the removed data, or `NULL` if the key was not
+ *             found.
+ */
+void *shardmap_remove(struct shardmap *map, const void *key);
+
+/**
+ * Check if a key is in the sharded hash map.
+ *
+ * @param map  Pointer to the sharded hash map.
+ * @param key  Key to search for.
+ * @return     `true` if the key exists in the map, `false` otherwise.
+ */
+bool shardmap_contains(const struct shardmap *map, const void *key);
+
+/**
+ * Get the data associated with a key in the sharded hash map.
+ *
+ * @param map  Pointer to the sharded hash map.
+ * @param key  Key to look up.
+ * @return     Pointer to the data associated with the key, or `NULL` if the
+ *             key was not found.
+ */
+void *shardmap_get(const struct shardmap *map, const void *key);
+
+/**
+ * Get the number of items in the sharded hash map.
+ *
+ * @param map  Pointer to the sharded hash map.
+ * @return     Number of items in the map, or 0 if the map is `NULL`.
+ */
+usize shardmap_len(const struct shardmap *map);
+
+/**
+ * Submit work on a key to the owner thread of its shard.
+ *
+ * The function is called on the owner thread with exclusive access to the
+ * shard's hash map, so it may insert, remove or look up items freely, and any
+ * items it inserts are allocated on the shard's node. Work submitted to the
+ * same shard runs in order. Results should be passed back through the
+ * context, once `shardmap_wait()` has returned.
+ *
+ * @param map      Pointer to the sharded hash map.
+ * @param key      Key whose shard should run the work.
+ * @param func     Function to call with the shard's hash map.
+ * @param context  User-defined context to pass to the function.
+ * @return         `true` if the work was submitted, `false` if memory
+ *                 allocation failed.
+ */
+bool shardmap_submit(
+    struct shardmap *map,
+    const void *key,
+    void (*func)(struct hashmap *shard, const void *key, void *context),
+    void *context
+);
+
+/**
+ * Wait for all submitted work to finish.
+ *
+ * @param map  Pointer to the sharded hash map.
+ */
+void shardmap_wait(struct shardmap *map);
@@ -0,0 +1,223 @@
+// File:        sketch.h
+// Author:      Zakhary Kaplan <https://zakhary.dev>
+// Created:     17 Oct 2026
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include <stdbool.h> // for bool
+
+#include "zakc/types.h" // for u8, u32, u64, usize
+
+// HyperLogLog structure
+//
+// A HyperLogLog estimates the number of distinct keys added to it, in a fixed
+// amount of memory and with a relative standard error of about
+// `1.04 / sqrt(2^precision)`. Keys are added by their hash, such as one
+// returned by `str_hash()` or `u64_hash()`. Each hash selects one of
+// `2^precision` registers, which keeps the longest run of leading zeros seen
+// among the rest of the hashes selecting it.
+//
+// Registers are kept sparsely, as a sorted list of those which are set, until
+// the list would take more memory than the registers themselves. The list is
+// then replaced by a dense array of one byte per register.
+struct hll;
+
+// Count-Min sketch structure
+//
+// A Count-Min sketch estimates how often each key was added to it, in a fixed
+// amount of memory, without ever underestimating. Keys are added by their
+// hash, which selects one counter in each row of the sketch. The estimate of
+// a key is the least of its counters, which exceeds its true count by at most
+// `e / width` of the total count with probability `1 - exp(-depth)`.
+struct cms;
+
+/**
+ * Create a new HyperLogLog.
+ *
+ * @param precision  Number of bits of each hash selecting its register,
+ *                   between 4 and 18.
+ * @return           Pointer to the newly-created HyperLogLog, or `NULL` if the
+ *                   precision is out of range or memory allocation failed.
+ */
+struct hll *hll_new(u8 precision);
+
+/**
+ * Delete the HyperLogLog.
+ *
+ * @param hll  Pointer to the HyperLogLog to delete.
+ */
+void hll_drop(struct hll *hll);
+
+/**
+ * Remove every key from the HyperLogLog, returning it to its sparse form.
+ *
+ * @param hll  Pointer to the HyperLogLog.
+ */
+void hll_clear(struct hll *hll);
+
+/**
+ * Add a key to the HyperLogLog.
+ *
+ * The hash is mixed before use, so weak hashes such as those of `str_hash()`
+ * are fine, but keys with equal hashes are counted once.
+ *
+ * @param hll   Pointer to the HyperLogLog.
+ * @param hash  Hash of the key.
+ * @return      `true` if the operation was successful, `false` if memory
+ *              allocation failed.
+ */
+bool hll_add(struct hll *hll, u64 hash);
+
+/**
+ * Estimate the number of distinct keys added to the HyperLogLog.
+ *
+ * @param hll  Pointer to the HyperLogLog.
+ * @return     Estimated number of distinct keys, or 0 if the HyperLogLog is
+ *             `NULL`.
+ */
+u64 hll_count(const struct hll *hll);
+
+/**
+ * Merge the keys of one HyperLogLog into another.
+ *
+ * Afterwards, the destination estimates the number of distinct keys added to
+ * either HyperLogLog. The dense registers of both are merged 16 at a time
+ * where SSE2 is available.
+ *
+ * @param dst  Pointer to the HyperLogLog to merge into.
+ * @param src  Pointer to the HyperLogLog to merge from.
+ * @return     `true` if the operation was successful, `false` if the
+ *             HyperLogLogs differ in precision or memory allocation failed.
+ */
+bool hll_merge(struct hll *dst, const struct hll *src);
+
+/**
+ * Serialize the HyperLogLog into a buffer.
+ *
+ * The serialized form is independent of the machine's byte order, and is
+ * only as large as the sparse list while the HyperLogLog is sparse. Nothing
+ * is written unless the buffer is large enough, so the function can be called
+ * with a `NULL` buffer to find the size needed.
+ *
+ * @param hll  Pointer to the HyperLogLog.
+ * @param buf  Buffer to write to, or `NULL`.
+ * @param len  Size of the buffer, in bytes.
+ * @return     Size of the serialized form, in bytes, or 0 if the HyperLogLog
+ *             is `NULL`.
+ */
+usize hll_serialize(const struct hll *hll, u8 *buf, usize len);
+
+/**
+ * Create a HyperLogLog from its serialized form.
+ *
+ * @param buf  Buffer to read from.
+ * @param len  Size of the buffer, in bytes.
+ * @return     Pointer to the newly-created HyperLogLog, or `NULL` if the
+ *             buffer does not hold a serialized HyperLogLog or memory
+ *             allocation failed.
+ */
+struct hll *hll_deserialize(const u8 *buf, usize len);
+
+/**
+ * Create a new Count-Min sketch.
+ *
+ * A sketch of `width` counters in each of `depth` rows overestimates by at
+ * most `e / width` of the total count with probability `1 - exp(-depth)`.
+ *
+ * With conservative update, adding a key only raises those of its counters
+ * which are below its new estimate, which makes overestimates much smaller.
+ * Counts added to such a sketch can never be removed.
+ *
+ * @param width         Number of counters in each row, rounded up to a power
+ *                      of 2.
+ * @param depth         Number of rows.
+ * @param conservative  Whether to update counters conservatively.
+ * @return              Pointer to the newly-created sketch, or `NULL` if the
+ *                      width or depth is 0 or memory allocation failed.
+ */
+struct cms *cms_new(usize width, usize depth, bool conservative);
+
+/**
+ * Delete the Count-Min sketch.
+ *
+ * @param cms  Pointer to the sketch to delete.
+ */
+void cms_drop(struct cms *cms);
+
+/**
+ * Reset every counter of the Count-Min sketch to zero.
+ *
+ * @param cms  Pointer to the sketch.
+ */
+void cms_clear(struct cms *cms);
+
+/**
+ * Add a number of occurrences of a key to the Count-Min sketch.
+ *
+ * The hash is mixed before use, as for `hll_add()`. Counters saturate rather
+ * than overflow.
+ *
+ * @param cms    Pointer to the sketch.
+ * @param hash   Hash of the key.
+ * @param count  Number of occurrences to add.
+ */
+void cms_add(struct cms *cms, u64 hash, u32 count);
+
+/**
+ * Estimate the number of occurrences of a key in the Count-Min sketch.
+ *
+ * @param cms   Pointer to the sketch.
+ * @param hash  Hash of the key.
+ * @return      Estimated number of occurrences, which is never less than the
+ *              true number, or 0 if the sketch is `NULL`.
+ */
+u32 cms_estimate(const struct cms *cms, u64 hash);
+
+/**
+ * Get the total number of occurrences added to the Count-Min sketch.
+ *
+ * @param cms  Pointer to the sketch.
+ * @return     Total number of occurrences, or 0 if the sketch is `NULL`.
+ */
+u64 cms_total(const struct cms *cms);
+
+/**
+ * Merge the counts of one Count-Min sketch into another.
+ *
+ * Afterwards, the destination estimates the number of occurrences added to
+ * either sketch. Merging sketches which update conservatively still never
+ * underestimates, though it may overestimate more than adding every key to
+ * one sketch would have.
+ *
+ * @param dst  Pointer to the sketch to merge into.
+ * @param src  Pointer to the sketch to merge from.
+ * @return     `true` if the operation was successful, `false` if the
+ *             sketches differ in width or depth.
+ */
+bool cms_merge(struct cms *dst, const struct cms *src);
+
+/**
+ * Serialize the Count-Min sketch into a buffer.
+ *
+ * The serialized form is independent of the machine's byte order. Nothing is
+ * written unless the buffer is large enough, so the function can be called
+ * with a `NULL` buffer to find the size needed.
+ *
+ * @param cms  Pointer to the sketch.
+ * @param buf  Buffer to write to, or `NULL`.
+ * @param len  Size of the buffer, in bytes.
+ * @return     Size of the serialized form, in bytes, or 0 if the sketch is
+ *             `NULL`.
+ */
+usize cms_serialize(const struct cms *cms, u8 *buf, usize len);
+
+/**
+ * Create a Count-Min sketch from its serialized form.
+ *
+ * @param buf  Buffer to read from.
+ * @param len  Size of the buffer, in bytes.
+ * @return     Pointer to the newly-created sketch, or `NULL` if the buffer
+ *             does not hold a serialized sketch or memory allocation failed.
+ */
+struct cms *cms_deserialize(const u8 *buf, usize len);
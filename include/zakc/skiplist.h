@@ -0,0 +1,136 @@
+// File:        skiplist.h
+// Author:      Zakhary Kaplan <https://zakhary.dev>
+// Created:     17 Oct 2026
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include <stdbool.h> // for bool
+
+#include "zakc/types.h" // for i32, usize
+
+// Skip list structure
+//
+// Items are kept sorted by key in a lock-free skip list, so any number of
+// threads may insert, remove and look up items concurrently. Removed items are
+// reclaimed using epoch-based reclamation, once no thread can still be
+// reading them.
+struct skiplist;
+
+/**
+ * Create a new skip list.
+ *
+ * @param cmp  Comparison function for keys, returning a negative, zero or
+ *             positive value if the left key is less than, equal to or greater
+ *             than the right key.
+ * @return     Pointer to the newly-created skip list, or `NULL` if memory
+ *             allocation failed.
+ */
+struct skiplist *skiplist_new(i32 (*cmp)(const void *left, const void *right));
+
+/**
+ * Delete the skip list.
+ *
+ * This must not be called concurrently with any other operation.
+ *
+ * @param list  Pointer to the skip list to delete.
+ */
+void skiplist_drop(struct skiplist *list);
+
+/**
+ * Insert an item into the skip list.
+ *
+ * If the key already exists in the skip list, the item's data will be
+ * replaced with the new data.
+ *
+ * @param list  Pointer to the skip list.
+ * @param key   Key of the item to insert.
+ * @param data  Data of the item to insert.
+ * @return      `true` if the operation was successful, `false` otherwise.
+ */
+bool skiplist_insert(struct skiplist *list, const void *key, void *data);
+
+/**
+ * Remove an item with the given key from the skip list.
+ *
+ * @param list  Pointer to the skip list.
+ * @param key   Key of the item to remove.
+ * @return      Pointer to the removed data, or `NULL` if the key was not
+ *              found.
+ */
+void *skiplist_remove(struct skiplist *list, const void *key);
+
+/**
+ * Check if a key is in the skip list.
+ *
+ * @param list  Pointer to the skip list.
+ * @param key   Key to search for.
+ * @return      `true` if the key exists in the skip list, `false` otherwise.
+ */
+bool skiplist_contains(const struct skiplist *list, const void *key);
+
+/**
+ * Get the data associated with a key in the skip list.
+ *
+ * @param list  Pointer to the skip list.
+ * @param key   Key to look up.
+ * @return      Pointer to the data associated with the key, or `NULL` if the
+ *              key was not found.
+ */
+void *skiplist_get(const struct skiplist *list, const void *key);
+
+/**
+ * Find the first item whose key is not less than a given key.
+ *
+ * @param list   Pointer to the skip list.
+ * @param key    Key to search for.
+ * @param found  Optional pointer to store the key of the found item.
+ * @return       Pointer to the data of the found item, or `NULL` if every key
+ *               is less than the given key.
+ */
+void *skiplist_lower_bound(
+    const struct skiplist *list, const void *key, const void **found
+);
+
+/**
+ * Get the number of items in the skip list.
+ *
+ * @param list  Pointer to the skip list.
+ * @return      Number of items in the skip list, or 0 if the list is `NULL`.
+ */
+usize skiplist_len(const struct skiplist *list);
+
+/**
+ * Iterate over the items in the skip list in order of their keys.
+ *
+ * Items inserted or removed concurrently may or may not be visited.
+ *
+ * @param list      Pointer to the skip list.
+ * @param callback  Callback function to call for each item.
+ * @param context   User-defined context to pass to the callback function.
+ */
+void skiplist_iter(
+    const struct skiplist *list,
+    void (*callback)(const void *key, void *data, void *context),
+    void *context
+);
+
+/**
+ * Iterate over the items in a range of keys in order.
+ *
+ * Items inserted or removed concurrently may or may not be visited.
+ *
+ * @param list      Pointer to the skip list.
+ * @param lo        First key of the range, or `NULL` for no lower bound.
+ * @param hi        Key one past the end of the range, or `NULL` for no upper
+ *                  bound.
+ * @param callback  Callback function to call for each item.
+ * @param context   User-defined context to pass to the callback function.
+ */
+void skiplist_range(
+    const struct skiplist *list,
+    const void *lo,
+    const void *hi,
+    void (*callback)(const void *key, void *data, void *context),
+    void *context
+);
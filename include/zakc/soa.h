@@ -0,0 +1,175 @@
+// File:        soa.h
+// Author:      Zakhary Kaplan <https://zakhary.dev>
+// Created:     17 Oct 2026
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include <stdbool.h> // for bool
+#include <stdlib.h>  // for aligned_alloc, free
+#include <string.h>  // for mem{cpy,move}
+
+#include "zakc/types.h" // for usize
+
+// Alignment of each column, suitable for vector loads
+#define SOA_ALIGN 64
+
+/*
+ * Field Mapping
+ */
+// clang-format off
+#define __soa_cat(a, b)  __soa_cat_(a, b)
+#define __soa_cat_(a, b) a##b
+#define __soa_nargs(...) \
+    __soa_nargs_(__VA_ARGS__, 16, 15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1)
+#define __soa_nargs_(_1, _2, _3, _4, _5, _6, _7, _8, _9, _10, _11, _12, _13, _14, _15, _16, n, ...) n
+#define __soa_comma() ,
+#define __soa_empty()
+
+// Apply `m` to each `(type, field)` pair, separated by `sep()`
+#define __soa_map(m, sep, ...) \
+    __soa_cat(__soa_map_, __soa_nargs(__VA_ARGS__))(m, sep, __VA_ARGS__)
+#define __soa_map_1(m, sep, x)       m x
+#define __soa_map_2(m, sep, x, ...)  m x sep() __soa_map_1(m, sep, __VA_ARGS__)
+#define __soa_map_3(m, sep, x, ...)  m x sep() __soa_map_2(m, sep, __VA_ARGS__)
+#define __soa_map_4(m, sep, x, ...)  m x sep() __soa_map_3(m, sep, __VA_ARGS__)
+#define __soa_map_5(m, sep, x, ...)  m x sep() __soa_map_4(m, sep, __VA_ARGS__)
+#define __soa_map_6(m, sep, x, ...)  m x sep() __soa_map_5(m, sep, __VA_ARGS__)
+#define __soa_map_7(m, sep, x, ...)  m x sep() __soa_map_6(m, sep, __VA_ARGS__)
+#define __soa_map_8(m, sep, x, ...)  m x sep() __soa_map_7(m, sep, __VA_ARGS__)
+#define __soa_map_9(m, sep, x, ...)  m x sep() __soa_map_8(m, sep, __VA_ARGS__)
+#define __soa_map_10(m, sep, x, ...) m x sep() __soa_map_9(m, sep, __VA_ARGS__)
+#define __soa_map_11(m, sep, x, ...) m x sep() __soa_map_10(m, sep, __VA_ARGS__)
+#define __soa_map_12(m, sep, x, ...) m x sep() __soa_map_11(m, sep, __VA_ARGS__)
+#define __soa_map_13(m, sep, x, ...) m x sep() __soa_map_12(m, sep, __VA_ARGS__)
+#define __soa_map_14(m, sep, x, ...) m x sep() __soa_map_13(m, sep, __VA_ARGS__)
+#define __soa_map_15(m, sep, x, ...) m x sep() __soa_map_14(m, sep, __VA_ARGS__)
+#define __soa_map_16(m, sep, x, ...) m x sep() __soa_map_15(m, sep, __VA_ARGS__)
+
+// Per-field expansions
+#define __soa_member(type, field)  type *field;
+#define __soa_param(type, field)   type field
+#define __soa_store(type, field)   soa->field[soa->len] = field;
+#define __soa_grow(type, field) \
+    if (!__soa_column_grow((void **)&soa->field, soa->len, capacity, sizeof(type))) \
+        return false;
+#define __soa_shift(type, field) \
+    memmove(&soa->field[index], &soa->field[index + 1], (soa->len - index - 1) * sizeof(type));
+#define __soa_free(type, field)    free(soa->field);
+// clang-format on
+
+/**
+ * Move a column into a new aligned allocation of the given capacity.
+ *
+ * @param column    Pointer to the column to grow.
+ * @param len       Number of elements stored in the column.
+ * @param capacity  New capacity of the column.
+ * @param size      Size of each element in the column.
+ * @return          `true` if the operation was successful, `false` if the
+ *                  column could never fit in memory or memory allocation
+ *                  failed.
+ */
+static inline bool __soa_column_grow(
+    void **column, usize len, usize capacity, usize size
+) {
+    if (capacity > ((usize)-1 - (SOA_ALIGN - 1)) / size)
+        // Return `false` if the column could never fit in memory
+        return false;
+    // Round the allocation up to a multiple of the alignment
+    usize bytes = (capacity * size + SOA_ALIGN - 1) & ~(usize)(SOA_ALIGN - 1);
+    void *data = aligned_alloc(SOA_ALIGN, bytes ? bytes : SOA_ALIGN);
+    if (!data)
+        // Return `false` if memory allocation failed
+        return false;
+    // Move the existing elements into the new column
+    if (*column)
+        memcpy(data, *column, len * size);
+    free(*column);
+    *column = data;
+    return true;
+}
+
+/**
+ * Define a struct-of-arrays container.
+ *
+ * Each field is given as a `(type, field)` pair, and is stored in its own
+ * contiguous column aligned to `SOA_ALIGN` bytes. Columns are accessed
+ * directly as members of the container (e.g. `soa->field[i]`), so kernels can
+ * scan a single field without touching the others.
+ *
+ * The following functions are defined for a container called `name`:
+ *
+ *   struct name *name_new(void);
+ *   void name_drop(struct name *soa);
+ *   bool name_append(struct name *soa, type field, ...);
+ *   bool name_remove(struct name *soa, usize index);
+ *   bool name_reserve(struct name *soa, usize capacity);
+ *   usize name_capacity(const struct name *soa);
+ *   usize name_len(const struct name *soa);
+ *
+ * Fields must not be called `len` or `capacity`.
+ *
+ * @param name  Name of the container.
+ * @param ...   Fields of the container, as `(type, field)` pairs.
+ */
+#define ZAKC_SOA_DEFINE(name, ...)                                             \
+    struct name {                                                              \
+        /* Columns of the container */                                         \
+        __soa_map(__soa_member, __soa_empty, __VA_ARGS__)                      \
+        /* Capacity of each column */                                          \
+        usize capacity;                                                        \
+        /* Number of records in the container */                              \
+        usize len;                                                             \
+    };                                                                         \
+                                                                               \
+    static inline struct name *name##_new(void) {                              \
+        return calloc(1, sizeof(struct name));                                 \
+    }                                                                          \
+                                                                               \
+    static inline void name##_drop(struct name *soa) {                         \
+        if (!soa)                                                              \
+            return;                                                            \
+        __soa_map(__soa_free, __soa_empty, __VA_ARGS__)                        \
+        free(soa);                                                             \
+    }                                                                          \
+                                                                               \
+    static inline bool name##_reserve(struct name *soa, usize capacity) {      \
+        if (!soa || capacity < soa->len)                                       \
+            return false;                                                      \
+        if (capacity <= soa->capacity)                                         \
+            return true;                                                       \
+        __soa_map(__soa_grow, __soa_empty, __VA_ARGS__)                        \
+        soa->capacity = capacity;                                              \
+        return true;                                                           \
+    }                                                                          \
+                                                                               \
+    static inline bool name##_append(                                          \
+        struct name *soa, __soa_map(__soa_param, __soa_comma, __VA_ARGS__)     \
+    ) {                                                                        \
+        if (!soa)                                                              \
+            return false;                                                      \
+        if (soa->len + 1 > soa->capacity) {                                    \
+            usize capacity = soa->capacity == 0 ? 1 : soa->capacity * 2;       \
+            if (!name##_reserve(soa, capacity))                                \
+                return false;                                                  \
+        }                                                                      \
+        __soa_map(__soa_store, __soa_empty, __VA_ARGS__)                       \
+        soa->len++;                                                            \
+        return true;                                                           \
+    }                                                                          \
+                                                                               \
+    static inline bool name##_remove(struct name *soa, usize index) {          \
+        if (!soa || index >= soa->len)                                         \
+            return false;                                                      \
+        __soa_map(__soa_shift, __soa_empty, __VA_ARGS__)                       \
+        soa->len--;                                                            \
+        return true;                                                           \
+    }                                                                          \
+                                                                               \
+    static inline usize name##_capacity(const struct name *soa) {              \
+        return soa ? soa->capacity : 0;                                        \
+    }                                                                          \
+                                                                               \
+    static inline usize name##_len(const struct name *soa) {                   \
+        return soa ? soa->len : 0;                                             \
+    }
@@ -7,11 +7,18 @@
 
 #include <stdbool.h> // for bool
 
-#include "zakc/types.h" // for usize
+#include "zakc/types.h" // for i32, usize
 
 // Vector structure
 struct vector;
 
+// Number of bytes needed by `vector_init_in()` for a vector of `cap` elements,
+// which is a constant expression if `cap` is
+#define VECTOR_SIZEOF(cap) ((6 + (usize)(cap)) * sizeof(void *))
+
+// Thread pool structure
+struct pool;
+
 /**
  * Create a new vector.
  *
@@ -20,13 +27,102 @@ struct vector;
  */
 struct vector *vector_new(void);
 
+/**
+ * Create a new vector with inline storage.
+ *
+ * The first `n` elements are stored inside the vector itself, so no further
+ * memory is allocated until the vector grows past `n` elements. The capacity
+ * of the vector never drops below `n`.
+ *
+ * @param n  Number of elements to store inline.
+ * @return   Pointer to the newly-created vector, or `NULL` if memory
+ *           allocation failed.
+ */
+struct vector *vector_with_inline(usize n);
+
+/**
+ * Create a new fixed-capacity vector in caller-provided memory.
+ *
+ * The vector and its elements are stored entirely in the buffer, which must
+ * be aligned for a pointer and hold at least `VECTOR_SIZEOF(cap)` bytes. No
+ * memory is ever allocated: operations that would grow the vector past `cap`
+ * elements fail instead. Deleting the vector destroys its elements but leaves
+ * the buffer to the caller.
+ *
+ * @param buf  Pointer to the buffer.
+ * @param cap  Number of elements the vector can hold.
+ * @return     Pointer to the vector, which is at the start of the buffer, or
+ *             `NULL` if the buffer is `NULL` or misaligned.
+ */
+struct vector *vector_init_in(void *buf, usize cap);
+
+/**
+ * Create a new vector which takes ownership of an existing array.
+ *
+ * No elements are copied: the array becomes the vector's storage, and is
+ * freed or reallocated by the vector from then on.
+ *
+ * @param data      Pointer to an array allocated with `malloc()`, or `NULL`
+ *                  if the capacity is 0.
+ * @param len       Number of elements in the array.
+ * @param capacity  Number of elements the array can hold.
+ * @return          Pointer to the newly-created vector, or `NULL` if the
+ *                  arguments are invalid or memory allocation failed, in
+ *                  which case the array is still owned by the caller.
+ */
+struct vector *vector_from_raw(void **data, usize len, usize capacity);
+
+/**
+ * Delete the vector, releasing ownership of its array to the caller.
+ *
+ * No elements are copied or destroyed, unless they are held in the vector's
+ * inline storage, in which case they are copied into a new array. If that
+ * allocation fails, `NULL` is returned with a non-zero length, and the
+ * vector is left intact.
+ *
+ * @param vec       Pointer to the vector to delete.
+ * @param len       Where to store the number of elements, or `NULL`.
+ * @param capacity  Where to store the number of elements the array can hold,
+ *                  or `NULL`.
+ * @return          Pointer to the array, to be freed with `free()`, or `NULL`
+ *                  if the vector is `NULL`, has no array, or memory
+ *                  allocation failed.
+ */
+void **vector_into_raw(struct vector *vec, usize *len, usize *capacity);
+
+/**
+ * Set the destructor of the vector's elements.
+ *
+ * Once set, the vector owns its elements: they are destroyed when the vector
+ * is deleted, cleared, or truncated by `vector_resize()`, and when replaced by
+ * `vector_set()`. Elements removed from the vector are returned to the caller
+ * instead. The algorithms below overwrite their destination vector without
+ * destroying its elements, so it must not own them, except when filtering a
+ * vector in place with `vector_filter()`.
+ *
+ * @param vec        Pointer to the vector.
+ * @param data_free  Destructor for elements, or `NULL` to not free elements.
+ */
+void vector_set_free(struct vector *vec, void (*data_free)(void *data));
+
 /**
  * Delete the vector.
  *
+ * Each element is passed to the vector's destructor, if any.
+ *
  * @param vec Pointer to the vector to delete.
  */
 void vector_drop(struct vector *vec);
 
+/**
+ * Remove every element from the vector, keeping its capacity.
+ *
+ * Each element is passed to the vector's destructor, if any.
+ *
+ * @param vec Pointer to the vector.
+ */
+void vector_clear(struct vector *vec);
+
 /**
  * Append an element to the end of the vector.
  *
@@ -54,7 +150,8 @@ bool vector_extend(struct vector *vec, const struct vector *other);
 /**
  * Remove the last element from the vector.
  *
- * The size of the vector will be reduced by one.
+ * The size of the vector will be reduced by one, and its capacity halved
+ * once it is less than a quarter full.
  *
  * If the vector is empty, the operation will be considered invalid.
  *
@@ -98,6 +195,37 @@ bool vector_insert(struct vector *vec, usize index, void *data);
  */
 void *vector_remove(struct vector *vec, usize index);
 
+/**
+ * Remove an element from the vector by moving the last element into its
+ * place.
+ *
+ * This takes constant time, but does not preserve the order of the elements.
+ *
+ * If the index is out of bounds, the operation will be considered invalid.
+ *
+ * @param vec    Pointer to the vector.
+ * @param index  Index of the element to remove.
+ * @return       Pointer to the removed element, or `NULL` if the operation
+ *               was invalid.
+ */
+void *vector_swap_remove(struct vector *vec, usize index);
+
+/**
+ * Keep only the elements of the vector which satisfy a predicate.
+ *
+ * The kept elements are compacted in a single pass, remaining in their
+ * original order, and the capacity of the vector is unchanged. Elements
+ * which are not kept are passed to the vector's destructor, if any.
+ *
+ * @param vec      Pointer to the vector.
+ * @param pred     Predicate which returns `true` for elements to keep.
+ * @param context  User-defined context to pass to the predicate.
+ * @return         `true` if the operation was successful, `false` otherwise.
+ */
+bool vector_retain(
+    struct vector *vec, bool (*pred)(void *data, void *context), void *context
+);
+
 /**
  * Check if the vector contains a given element.
  *
@@ -193,7 +321,8 @@ bool vector_shrink_to_fit(struct vector *vec);
  * Resize the vector to a given length.
  *
  * If the length is less than the current length, the vector will be truncated
- * to the new length. If the length is greater than the current length, the
+ * to the new length, and the dropped elements are passed to the vector's
+ * destructor, if any. If the length is greater than the current length, the
  * vector's capacity will be increased to the new length, and uninitialized
  * elements will be zeroed out.
  *
@@ -202,3 +331,565 @@ bool vector_shrink_to_fit(struct vector *vec);
  * @return      `true` if the operation was successful, `false` otherwise.
  */
 bool vector_resize(struct vector *vec, usize len);
+
+/*
+ * Slices
+ */
+
+// Slice structure
+//
+// A slice is a non-owning view of a contiguous range of elements, such as
+// part of a vector's storage. Slices are passed by value and never copy the
+// elements they view. A slice of a vector is invalidated by any operation
+// which may move the vector's storage, such as appending or reserving.
+struct slice {
+    // Pointer to the first element
+    void **data;
+    // Number of elements
+    usize len;
+};
+
+/**
+ * Get a slice of a range of elements of the vector.
+ *
+ * @param vec    Pointer to the vector.
+ * @param start  Index of the first element of the slice.
+ * @param end    Index one past the last element of the slice.
+ * @return       Slice of the elements from `start` up to `end`, or an empty
+ *               slice if the vector is `NULL` or the range is invalid.
+ */
+struct slice vector_slice(const struct vector *vec, usize start, usize end);
+
+/**
+ * Get a slice of every element of the vector.
+ *
+ * @param vec  Pointer to the vector.
+ * @return     Slice of every element, or an empty slice if the vector is
+ *             `NULL`.
+ */
+struct slice vector_as_slice(const struct vector *vec);
+
+/**
+ * Get a slice of a range of elements of another slice.
+ *
+ * @param slice  Slice to take the range from.
+ * @param start  Index of the first element of the slice.
+ * @param end    Index one past the last element of the slice.
+ * @return       Slice of the elements from `start` up to `end`, or an empty
+ *               slice if the range is invalid.
+ */
+struct slice slice_sub(struct slice slice, usize start, usize end);
+
+/**
+ * Append the elements of a slice to the end of the vector.
+ *
+ * The slice may view the vector's own elements.
+ *
+ * @param vec    Pointer to the vector.
+ * @param slice  Slice of the elements to append.
+ * @return       `true` if the operation was successful, `false` otherwise.
+ */
+bool vector_extend_slice(struct vector *vec, struct slice slice);
+
+/**
+ * Sort the elements of a slice in place.
+ *
+ * @param slice  Slice of the elements to sort.
+ * @param cmp    Comparison function for elements, returning a negative, zero
+ *               or positive value if the left element is less than, equal to
+ *               or greater than the right element.
+ */
+void slice_sort(
+    struct slice slice, i32 (*cmp)(const void *left, const void *right)
+);
+
+/*
+ * Algorithms
+ *
+ * The sequential algorithms are defined inline, so that when they are called
+ * with a known function the compiler can inline it into the loop and
+ * vectorize elements which hold plain values (e.g. integers cast to
+ * pointers). The parallel algorithms split their input into chunks and run
+ * the same loops on each chunk using a thread pool. They are compiled apart
+ * from the rest of the vector, so that only programs which use them depend on
+ * the thread pool.
+ *
+ * Each algorithm works on slices, with a vector form which resizes its
+ * destination vector to fit. A destination slice may be the same as its
+ * source slice, but must not otherwise overlap it. A destination vector must
+ * not own its elements, as they are overwritten without being destroyed.
+ */
+
+/**
+ * Find the first element of a slice which satisfies a predicate.
+ *
+ * @param slice    Slice of the elements to search.
+ * @param pred     Predicate which returns `true` for the element to find.
+ * @param context  User-defined context to pass to the predicate.
+ * @return         Index of the first matching element, or the length of the
+ *                 slice if no element matches.
+ */
+static inline usize slice_find(
+    struct slice slice, bool (*pred)(void *data, void *context), void *context
+) {
+    for (usize i = 0; i < slice.len; i++)
+        if (pred(slice.data[i], context))
+            return i;
+    return slice.len;
+}
+
+/**
+ * Search a sorted slice for a key using binary search.
+ *
+ * @param slice  Slice of the elements to search, sorted by `cmp`.
+ * @param key    Key to search for.
+ * @param cmp    Comparison function for elements, as passed to
+ *               `slice_sort()`, which is given elements on the left and the
+ *               key on the right.
+ * @return       Index of the first element which is not less than the key, or
+ *               the length of the slice if every element is less.
+ */
+static inline usize slice_search(
+    struct slice slice,
+    const void *key,
+    i32 (*cmp)(const void *left, const void *right)
+) {
+    usize lo = 0;
+    usize hi = slice.len;
+    while (lo < hi) {
+        usize mid = lo + (hi - lo) / 2;
+        if (cmp(slice.data[mid], key) < 0)
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+    return lo;
+}
+
+/**
+ * Map each element of a slice through a function.
+ *
+ * @param dst      Slice to store the results in, at least as long as `src`.
+ * @param src      Slice of the elements to map.
+ * @param func     Function to apply to each element.
+ * @param context  User-defined context to pass to the function.
+ * @return         `true` if the operation was successful, `false` if the
+ *                 destination is too short.
+ */
+static inline bool slice_map(
+    struct slice dst,
+    struct slice src,
+    void *(*func)(void *data, void *context),
+    void *context
+) {
+    if (dst.len < src.len)
+        // Return `false` if the destination is too short
+        return false;
+    for (usize i = 0; i < src.len; i++)
+        dst.data[i] = func(src.data[i], context);
+    return true;
+}
+
+/**
+ * Map each element of a vector through a function.
+ *
+ * The destination vector is resized to the length of the source vector, and
+ * may be the same as the source vector to map in place. It must not own its
+ * elements, as they are overwritten without being destroyed.
+ *
+ * @param dst      Pointer to the vector to store the results in.
+ * @param src      Pointer to the vector to map.
+ * @param func     Function to apply to each element.
+ * @param context  User-defined context to pass to the function.
+ * @return         `true` if the operation was successful, `false` otherwise.
+ */
+static inline bool vector_map(
+    struct vector *dst,
+    const struct vector *src,
+    void *(*func)(void *data, void *context),
+    void *context
+) {
+    if (!dst || !src || !func)
+        // Return `false` if either vector or the function is `NULL`
+        return false;
+    if (dst != src && !vector_resize(dst, vector_len(src)))
+        // Return `false` if unable to resize the destination vector
+        return false;
+    return slice_map(
+        vector_as_slice(dst), vector_as_slice(src), func, context
+    );
+}
+
+/**
+ * Keep only the elements of a slice which satisfy a predicate.
+ *
+ * The kept elements are stored at the start of the destination in their
+ * original order.
+ *
+ * @param dst      Slice to store the results in, at least as long as `src`.
+ * @param src      Slice of the elements to filter.
+ * @param pred     Predicate which returns `true` for elements to keep.
+ * @param context  User-defined context to pass to the predicate.
+ * @return         Number of kept elements, or 0 if the destination is too
+ *                 short.
+ */
+static inline usize slice_filter(
+    struct slice dst,
+    struct slice src,
+    bool (*pred)(void *data, void *context),
+    void *context
+) {
+    if (dst.len < src.len)
+        // Return 0 if the destination is too short
+        return 0;
+    // Compact the kept elements without branching on the predicate
+    usize n = 0;
+    for (usize i = 0; i < src.len; i++) {
+        void *data = src.data[i];
+        dst.data[n] = data;
+        n += pred(data, context);
+    }
+    return n;
+}
+
+/**
+ * Keep only the elements of a vector which satisfy a predicate.
+ *
+ * The kept elements remain in their original order. The destination vector
+ * is resized to the number of kept elements, and may be the same as the
+ * source vector to filter in place, in which case the dropped elements are
+ * passed to its destructor, if any, as by `vector_retain()`. Otherwise, the
+ * destination must not own its elements, as they are overwritten without
+ * being destroyed.
+ *
+ * @param dst      Pointer to the vector to store the results in.
+ * @param src      Pointer to the vector to filter.
+ * @param pred     Predicate which returns `true` for elements to keep.
+ * @param context  User-defined context to pass to the predicate.
+ * @return         `true` if the operation was successful, `false` otherwise.
+ */
+static inline bool vector_filter(
+    struct vector *dst,
+    const struct vector *src,
+    bool (*pred)(void *data, void *context),
+    void *context
+) {
+    if (!dst || !src || !pred)
+        // Return `false` if either vector or the predicate is `NULL`
+        return false;
+    if (dst == src)
+        // Filter in place, destroying the dropped elements
+        return vector_retain(dst, pred, context);
+    if (!vector_resize(dst, vector_len(src)))
+        // Return `false` if unable to resize the destination vector
+        return false;
+    usize n = slice_filter(
+        vector_as_slice(dst), vector_as_slice(src), pred, context
+    );
+    return vector_resize(dst, n);
+}
+
+/**
+ * Reduce the elements of a slice to a single value.
+ *
+ * The operator is applied from left to right, starting with the initial
+ * value. It must be associative for the result of `slice_par_reduce()` to
+ * match.
+ *
+ * @param slice    Slice of the elements to reduce.
+ * @param init     Initial value of the reduction.
+ * @param op       Binary operator to combine two values.
+ * @param context  User-defined context to pass to the operator.
+ * @return         The reduced value, or the initial value if the slice is
+ *                 empty.
+ */
+static inline void *slice_reduce(
+    struct slice slice,
+    void *init,
+    void *(*op)(void *lhs, void *rhs, void *context),
+    void *context
+) {
+    void *acc = init;
+    for (usize i = 0; i < slice.len; i++)
+        acc = op(acc, slice.data[i], context);
+    return acc;
+}
+
+/**
+ * Reduce the elements of a vector to a single value.
+ *
+ * See `slice_reduce()`.
+ *
+ * @param vec      Pointer to the vector to reduce.
+ * @param init     Initial value of the reduction.
+ * @param op       Binary operator to combine two values.
+ * @param context  User-defined context to pass to the operator.
+ * @return         The reduced value, or the initial value if the vector is
+ *                 empty or `NULL`.
+ */
+static inline void *vector_reduce(
+    const struct vector *vec,
+    void *init,
+    void *(*op)(void *lhs, void *rhs, void *context),
+    void *context
+) {
+    if (!vec || !op)
+        // Return the initial value if the vector or operator is `NULL`
+        return init;
+    return slice_reduce(vector_as_slice(vec), init, op, context);
+}
+
+/**
+ * Compute the prefix scan of a slice.
+ *
+ * An inclusive scan stores the reduction of every element up to and including
+ * each element, while an exclusive scan stores the reduction of every element
+ * before it (starting with the initial value).
+ *
+ * @param dst        Slice to store the results in, at least as long as `src`.
+ * @param src        Slice of the elements to scan.
+ * @param init       Initial value of the scan.
+ * @param op         Binary operator to combine two values.
+ * @param inclusive  Whether to compute an inclusive or exclusive scan.
+ * @param context    User-defined context to pass to the operator.
+ * @return           `true` if the operation was successful, `false` if the
+ *                   destination is too short.
+ */
+static inline bool slice_scan(
+    struct slice dst,
+    struct slice src,
+    void *init,
+    void *(*op)(void *lhs, void *rhs, void *context),
+    bool inclusive,
+    void *context
+) {
+    if (dst.len < src.len)
+        // Return `false` if the destination is too short
+        return false;
+    void *acc = init;
+    if (inclusive) {
+        for (usize i = 0; i < src.len; i++)
+            dst.data[i] = acc = op(acc, src.data[i], context);
+    } else {
+        for (usize i = 0; i < src.len; i++) {
+            void *data = src.data[i];
+            dst.data[i] = acc;
+            acc = op(acc, data, context);
+        }
+    }
+    return true;
+}
+
+/**
+ * Compute the prefix scan of a vector.
+ *
+ * See `slice_scan()`. The destination vector is resized to the length of the
+ * source vector, and may be the same as the source vector to scan in place.
+ * It must not own its elements, as they are overwritten without being
+ * destroyed.
+ *
+ * @param dst        Pointer to the vector to store the results in.
+ * @param src        Pointer to the vector to scan.
+ * @param init       Initial value of the scan.
+ * @param op         Binary operator to combine two values.
+ * @param inclusive  Whether to compute an inclusive or exclusive scan.
+ * @param context    User-defined context to pass to the operator.
+ * @return           `true` if the operation was successful, `false` otherwise.
+ */
+static inline bool vector_scan(
+    struct vector *dst,
+    const struct vector *src,
+    void *init,
+    void *(*op)(void *lhs, void *rhs, void *context),
+    bool inclusive,
+    void *context
+) {
+    if (!dst || !src || !op)
+        // Return `false` if either vector or the operator is `NULL`
+        return false;
+    if (dst != src && !vector_resize(dst, vector_len(src)))
+        // Return `false` if unable to resize the destination vector
+        return false;
+    return slice_scan(
+        vector_as_slice(dst), vector_as_slice(src), init, op, inclusive, context
+    );
+}
+
+/**
+ * Map each element of a slice through a function in parallel.
+ *
+ * See `slice_map()`. The function may be called from any worker thread.
+ *
+ * @param pool     Pointer to the thread pool, or `NULL` to run sequentially.
+ * @param dst      Slice to store the results in, at least as long as `src`.
+ * @param src      Slice of the elements to map.
+ * @param func     Function to apply to each element.
+ * @param context  User-defined context to pass to the function.
+ * @return         `true` if the operation was successful, `false` otherwise.
+ */
+bool slice_par_map(
+    struct pool *pool,
+    struct slice dst,
+    struct slice src,
+    void *(*func)(void *data, void *context),
+    void *context
+);
+
+/**
+ * Map each element of a vector through a function in parallel.
+ *
+ * See `vector_map()`. The function may be called from any worker thread, and
+ * the destination must not own its elements.
+ *
+ * @param pool     Pointer to the thread pool, or `NULL` to run sequentially.
+ * @param dst      Pointer to the vector to store the results in.
+ * @param src      Pointer to the vector to map.
+ * @param func     Function to apply to each element.
+ * @param context  User-defined context to pass to the function.
+ * @return         `true` if the operation was successful, `false` otherwise.
+ */
+bool vector_par_map(
+    struct pool *pool,
+    struct vector *dst,
+    const struct vector *src,
+    void *(*func)(void *data, void *context),
+    void *context
+);
+
+/**
+ * Keep only the elements of a slice which satisfy a predicate in parallel.
+ *
+ * See `slice_filter()`. The kept elements remain in their original order.
+ *
+ * @param pool     Pointer to the thread pool, or `NULL` to run sequentially.
+ * @param dst      Slice to store the results in, at least as long as `src`.
+ * @param src      Slice of the elements to filter.
+ * @param pred     Predicate which returns `true` for elements to keep.
+ * @param context  User-defined context to pass to the predicate.
+ * @param len      Where to store the number of kept elements.
+ * @return         `true` if the operation was successful, `false` otherwise.
+ */
+bool slice_par_filter(
+    struct pool *pool,
+    struct slice dst,
+    struct slice src,
+    bool (*pred)(void *data, void *context),
+    void *context,
+    usize *len
+);
+
+/**
+ * Keep only the elements of a vector which satisfy a predicate in parallel.
+ *
+ * See `vector_filter()`. The kept elements remain in their original order.
+ * Unlike `vector_filter()`, the destination must not own its elements, even
+ * when filtering in place.
+ *
+ * @param pool     Pointer to the thread pool, or `NULL` to run sequentially.
+ * @param dst      Pointer to the vector to store the results in.
+ * @param src      Pointer to the vector to filter.
+ * @param pred     Predicate which returns `true` for elements to keep.
+ * @param context  User-defined context to pass to the predicate.
+ * @return         `true` if the operation was successful, `false` otherwise.
+ */
+bool vector_par_filter(
+    struct pool *pool,
+    struct vector *dst,
+    const struct vector *src,
+    bool (*pred)(void *data, void *context),
+    void *context
+);
+
+/**
+ * Reduce the elements of a slice to a single value in parallel.
+ *
+ * See `slice_reduce()`. The operator must be associative, but need not be
+ * commutative.
+ *
+ * @param pool     Pointer to the thread pool, or `NULL` to run sequentially.
+ * @param slice    Slice of the elements to reduce.
+ * @param init     Initial value of the reduction.
+ * @param op       Binary operator to combine two values.
+ * @param context  User-defined context to pass to the operator.
+ * @return         The reduced value, or the initial value if the slice is
+ *                 empty.
+ */
+void *slice_par_reduce(
+    struct pool *pool,
+    struct slice slice,
+    void *init,
+    void *(*op)(void *lhs, void *rhs, void *context),
+    void *context
+);
+
+/**
+ * Reduce the elements of a vector to a single value in parallel.
+ *
+ * See `vector_reduce()`. The operator must be associative, but need not be
+ * commutative.
+ *
+ * @param pool     Pointer to the thread pool, or `NULL` to run sequentially.
+ * @param vec      Pointer to the vector to reduce.
+ * @param init     Initial value of the reduction.
+ * @param op       Binary operator to combine two values.
+ * @param context  User-defined context to pass to the operator.
+ * @return         The reduced value, or the initial value if the vector is
+ *                 empty or `NULL`.
+ */
+void *vector_par_reduce(
+    struct pool *pool,
+    const struct vector *vec,
+    void *init,
+    void *(*op)(void *lhs, void *rhs, void *context),
+    void *context
+);
+
+/**
+ * Compute the prefix scan of a slice in parallel.
+ *
+ * See `slice_scan()`. The operator must be associative, but need not be
+ * commutative.
+ *
+ * @param pool       Pointer to the thread pool, or `NULL` to run sequentially.
+ * @param dst        Slice to store the results in, at least as long as `src`.
+ * @param src        Slice of the elements to scan.
+ * @param init       Initial value of the scan.
+ * @param op         Binary operator to combine two values.
+ * @param inclusive  Whether to compute an inclusive or exclusive scan.
+ * @param context    User-defined context to pass to the operator.
+ * @return           `true` if the operation was successful, `false` otherwise.
+ */
+bool slice_par_scan(
+    struct pool *pool,
+    struct slice dst,
+    struct slice src,
+    void *init,
+    void *(*op)(void *lhs, void *rhs, void *context),
+    bool inclusive,
+    void *context
+);
+
+/**
+ * Compute the prefix scan of a vector in parallel.
+ *
+ * See `vector_scan()`. The operator must be associative, but need not be
+ * commutative, and the destination must not own its elements.
+ *
+ * @param pool       Pointer to the thread pool, or `NULL` to run sequentially.
+ * @param dst        Pointer to the vector to store the results in.
+ * @param src        Pointer to the vector to scan.
+ * @param init       Initial value of the scan.
+ * @param op         Binary operator to combine two values.
+ * @param inclusive  Whether to compute an inclusive or exclusive scan.
+ * @param context    User-defined context to pass to the operator.
+ * @return           `true` if the operation was successful, `false` otherwise.
+ */
+bool vector_par_scan(
+    struct pool *pool,
+    struct vector *dst,
+    const struct vector *src,
+    void *init,
+    void *(*op)(void *lhs, void *rhs, void *context),
+    bool inclusive,
+    void *context
+);
@@ -0,0 +1,94 @@
+// File:        cursor.c
+// Author:      Zakhary Kaplan <https://zakhary.dev>
+// Created:     17 Oct 2026
+// SPDX-License-Identifier: MIT
+
+#include <stdint.h> // for uintptr_t
+#include <stdlib.h> // for EXIT_{FAILURE,SUCCESS}, strtoul
+#include <time.h>   // for clock_gettime
+
+#include "zakc/gvec.h"   // for gvec
+#include "zakc/log.h"    // for error
+#include "zakc/print.h"  // for println
+#include "zakc/types.h"  // for f64, u64, usize
+#include "zakc/vector.h" // for vector
+
+// Default number of elements in each sequence
+#define LEN (1 << 20)
+// Number of edits made to each sequence
+#define EDITS (1 << 14)
+// Furthest the cursor moves between edits
+#define STRIDE 8
+
+// Get the current time in seconds
+static f64 now(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+// Get the next pseudo-random number
+static u64 next(u64 *seed) {
+    *seed ^= *seed << 13;
+    *seed ^= *seed >> 7;
+    *seed ^= *seed << 17;
+    return *seed;
+}
+
+int main(int argc, char *argv[]) {
+    // Parse the number of elements
+    usize len = argc > 1 ? strtoul(argv[1], NULL, 10) : 0;
+    if (!len)
+        len = LEN;
+
+    // Fill both sequences with the same elements
+    struct gvec *gvec = gvec_new();
+    struct vector *vec = vector_new();
+    if (!gvec || !vec) {
+        error("failed to create sequences");
+        return EXIT_FAILURE;
+    }
+    for (usize i = 0; i < len; i++) {
+        void *data = (void *)(uintptr_t)i;
+        if (!gvec_append(gvec, data) || !vector_append(vec, data)) {
+            error("failed to fill sequences");
+            return EXIT_FAILURE;
+        }
+    }
+
+    // Type and delete around a cursor which wanders from the middle, as an
+    // editor would
+    println("sequence    edits (ms)");
+    for (usize run = 0; run < 2; run++) {
+        u64 seed = 0x9e3779b97f4a7c15;
+        usize cursor = len / 2;
+        f64 start = now();
+        for (usize i = 0; i < EDITS; i++) {
+            cursor += next(&seed) % (2 * STRIDE + 1);
+            cursor -= cursor < STRIDE ? cursor : STRIDE;
+            if (cursor >= len)
+                cursor = len - 1;
+            void *data = (void *)(uintptr_t)cursor;
+            bool ok = true;
+            if (next(&seed) % 2)
+                ok = run ? vector_insert(vec, cursor, data)
+                         : gvec_insert(gvec, cursor, data);
+            else if (run)
+                vector_remove(vec, cursor);
+            else
+                gvec_remove(gvec, cursor);
+            if (!ok) {
+                error("failed to insert element");
+                return EXIT_FAILURE;
+            }
+            len = run ? vector_len(vec) : gvec_len(gvec);
+        }
+        f64 elapsed = now() - start;
+        println("%-8s    %10.2f", run ? "vector" : "gvec", elapsed * 1e3);
+        len = vector_len(vec);
+    }
+
+    gvec_drop(gvec);
+    vector_drop(vec);
+    return EXIT_SUCCESS;
+}
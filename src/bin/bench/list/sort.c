@@ -0,0 +1,127 @@
+// File:        sort.c
+// Author:      Zakhary Kaplan <https://zakhary.dev>
+// Created:     17 Oct 2026
+// SPDX-License-Identifier: MIT
+
+#include <math.h>   // for INFINITY, NAN, isnan
+#include <stdint.h> // for uintptr_t
+#include <stdlib.h> // for EXIT_{FAILURE,SUCCESS}, strtoul
+#include <time.h>   // for clock_gettime
+
+#include "zakc/list.h"   // for list
+#include "zakc/log.h"    // for error
+#include "zakc/print.h"  // for println
+#include "zakc/types.h"  // for f64, i32, u64, usize
+#include "zakc/vector.h" // for slice_sort, vector
+
+// Default number of items in each list
+#define LEN (1 << 20)
+// Number of repetitions per input
+#define REPS 5
+
+// Order of the items of an input
+enum input {
+    Sorted,
+    Reversed,
+    Random,
+};
+
+// Name of each input
+static const char *const NAMES[] = {
+    [Sorted] = "sorted",
+    [Reversed] = "reversed",
+    [Random] = "random",
+};
+
+// Get the current time in seconds
+static f64 now(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+// Compare two integers cast to pointers
+static i32 cmp(const void *left, const void *right) {
+    uintptr_t l = (uintptr_t)left;
+    uintptr_t r = (uintptr_t)right;
+    return (l > r) - (l < r);
+}
+
+// Build a list of integers in the order of an input
+static struct list *build(enum input input, usize len) {
+    struct list *list = list_new();
+    u64 seed = 0x9e3779b97f4a7c15;
+    for (usize i = 0; list && i < len; i++) {
+        seed ^= seed << 13;
+        seed ^= seed >> 7;
+        seed ^= seed << 17;
+        usize item = input == Sorted ? i : input == Reversed ? len - i : seed;
+        if (!list_append(list, (void *)(uintptr_t)item)) {
+            list_drop(list);
+            return NULL;
+        }
+    }
+    return list;
+}
+
+// Sort a list in place
+static bool sort_list(struct list **list) {
+    return list_sort(*list, cmp);
+}
+
+// Sort a list by copying it into a vector and rebuilding it
+static bool sort_copy(struct list **list) {
+    struct vector *vec = list_to_vector(*list);
+    if (!vec)
+        return false;
+    slice_sort(vector_as_slice(vec), cmp);
+    struct list *sorted = vector_to_list(vec);
+    vector_drop(vec);
+    if (!sorted)
+        return false;
+    list_drop(*list);
+    *list = sorted;
+    return true;
+}
+
+// Time the best of several sorts of an input
+static f64 run(enum input input, usize len, bool (*sort)(struct list **)) {
+    f64 best = INFINITY;
+    for (usize rep = 0; rep < REPS; rep++) {
+        struct list *list = build(input, len);
+        if (!list)
+            return NAN;
+        f64 start = now();
+        bool ok = sort(&list);
+        f64 elapsed = now() - start;
+        list_drop(list);
+        if (!ok)
+            return NAN;
+        if (elapsed < best)
+            best = elapsed;
+    }
+    return best;
+}
+
+int main(int argc, char *argv[]) {
+    // Parse the number of items
+    usize len = argc > 1 ? strtoul(argv[1], NULL, 10) : 0;
+    if (!len)
+        len = LEN;
+
+    // Measure each input with both sorts
+    println("input       list_sort (ms)    copy + qsort (ms)");
+    for (enum input input = Sorted; input <= Random; input++) {
+        f64 inplace = run(input, len, sort_list);
+        f64 copy = run(input, len, sort_copy);
+        if (isnan(inplace) || isnan(copy)) {
+            error("failed to sort %s input", NAMES[input]);
+            return EXIT_FAILURE;
+        }
+        println(
+            "%-8s    %14.2f    %17.2f", NAMES[input], inplace * 1e3, copy * 1e3
+        );
+    }
+
+    return EXIT_SUCCESS;
+}
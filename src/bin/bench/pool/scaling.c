@@ -0,0 +1,86 @@
+// File:        scaling.c
+// Author:      Zakhary Kaplan <https://zakhary.dev>
+// Created:     17 Oct 2026
+// SPDX-License-Identifier: MIT
+
+#include <math.h>      // for sqrt
+#include <stdatomic.h> // for atomic_*
+#include <stdlib.h>    // for EXIT_{FAILURE,SUCCESS}, strtoul
+#include <time.h>      // for clock_gettime
+#include <unistd.h>    // for sysconf
+
+#include "zakc/log.h"   // for error
+#include "zakc/pool.h"  // for pool
+#include "zakc/print.h" // for println
+#include "zakc/types.h" // for f64, usize
+
+// Number of indices in the benchmarked loop
+#define LEN (1 << 24)
+// Number of repetitions per thread count
+#define REPS 5
+
+// Accumulated result, to keep the work from being optimized away
+static _Atomic(f64) total;
+
+// Get the current time in seconds
+static f64 now(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+// Compute-bound loop body
+static void body(usize start, usize end, void *context) {
+    f64 sum = 0;
+    for (usize i = start; i < end; i++)
+        sum += sqrt((f64)i) * 1e-9;
+    f64 old = atomic_load(&total);
+    while (!atomic_compare_exchange_weak(&total, &old, old + sum))
+        ;
+}
+
+// Time the best of several runs of the loop on a pool
+static f64 run(struct pool *pool) {
+    f64 best = INFINITY;
+    for (usize rep = 0; rep < REPS; rep++) {
+        f64 start = now();
+        pool_parallel_for(pool, 0, LEN, 0, body, NULL);
+        f64 elapsed = now() - start;
+        if (elapsed < best)
+            best = elapsed;
+    }
+    return best;
+}
+
+int main(int argc, char *argv[]) {
+    // Parse the maximum number of threads
+    usize max = argc > 1 ? strtoul(argv[1], NULL, 10) : 0;
+    if (!max)
+        max = (usize)sysconf(_SC_NPROCESSORS_ONLN);
+    bool pin = argc > 2 && argv[2][0] == 'p';
+
+    // Measure the sequential baseline
+    f64 base = run(NULL);
+    println("threads    time (ms)    speedup    efficiency");
+    println("%7s    %9.2f    %7.2f    %10.2f", "seq", base * 1e3, 1.0, 1.0);
+
+    // Measure each thread count
+    for (usize n = 1; n <= max; n++) {
+        struct pool *pool = pool_new(n, pin);
+        if (!pool) {
+            error("failed to create thread pool");
+            return EXIT_FAILURE;
+        }
+        f64 time = run(pool);
+        println(
+            "%7zu    %9.2f    %7.2f    %10.2f",
+            n,
+            time * 1e3,
+            base / time,
+            base / time / n
+        );
+        pool_drop(pool);
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,100 @@
+// File:        edit.c
+// Author:      Zakhary Kaplan <https://zakhary.dev>
+// Created:     17 Oct 2026
+// SPDX-License-Identifier: MIT
+
+#include <stdint.h> // for uintptr_t
+#include <stdlib.h> // for EXIT_{FAILURE,SUCCESS}, strtoul
+#include <time.h>   // for clock_gettime
+
+#include "zakc/log.h"    // for error
+#include "zakc/print.h"  // for println
+#include "zakc/rope.h"   // for rope
+#include "zakc/types.h"  // for f64, u64, usize
+#include "zakc/vector.h" // for vector
+
+// Default number of items in each sequence
+#define LEN (1 << 20)
+// Number of edits made to each sequence
+#define EDITS (1 << 14)
+
+// Get the current time in seconds
+static f64 now(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+// Get the next pseudo-random number
+static u64 next(u64 *seed) {
+    *seed ^= *seed << 13;
+    *seed ^= *seed >> 7;
+    *seed ^= *seed << 17;
+    return *seed;
+}
+
+int main(int argc, char *argv[]) {
+    // Parse the number of items
+    usize len = argc > 1 ? strtoul(argv[1], NULL, 10) : 0;
+    if (!len)
+        len = LEN;
+
+    // Fill both sequences with the same items
+    struct rope *rope = rope_new();
+    struct vector *vec = vector_new();
+    if (!rope || !vec) {
+        error("failed to create sequences");
+        return EXIT_FAILURE;
+    }
+    for (usize i = 0; i < len; i++) {
+        void *item = (void *)(uintptr_t)i;
+        if (!rope_append(rope, item) || !vector_append(vec, item)) {
+            error("failed to fill sequences");
+            return EXIT_FAILURE;
+        }
+    }
+
+    // Insert and remove an item at random positions, as an editor would
+    println("sequence    edits (ms)    reads (ms)");
+    for (usize run = 0; run < 2; run++) {
+        u64 seed = 0x9e3779b97f4a7c15;
+        f64 start = now();
+        for (usize i = 0; i < EDITS; i++) {
+            usize at = next(&seed) % len;
+            usize from = next(&seed) % len;
+            bool ok = run ? vector_insert(vec, at, (void *)(uintptr_t)at)
+                          : rope_insert(rope, at, (void *)(uintptr_t)at);
+            if (!ok) {
+                error("failed to insert item");
+                return EXIT_FAILURE;
+            }
+            if (run)
+                vector_remove(vec, from);
+            else
+                rope_remove(rope, from);
+        }
+        f64 edits = now() - start;
+
+        // Read back items at random positions
+        usize sum = 0;
+        start = now();
+        for (usize i = 0; i < EDITS; i++) {
+            usize at = next(&seed) % len;
+            sum += (uintptr_t)(run ? vector_get(vec, at) : rope_get(rope, at));
+        }
+        f64 reads = now() - start;
+        // Keep the reads from being optimized away
+        __asm__ volatile("" : : "r"(sum));
+
+        println(
+            "%-8s    %10.2f    %10.2f",
+            run ? "vector" : "rope",
+            edits * 1e3,
+            reads * 1e3
+        );
+    }
+
+    rope_drop(rope);
+    vector_drop(vec);
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,236 @@
+// File:        numa.c
+// Author:      Zakhary Kaplan <https://zakhary.dev>
+// Created:     17 Oct 2026
+// SPDX-License-Identifier: MIT
+
+#include <linux/mempolicy.h> // for MPOL_BIND
+#include <stdint.h>          // for uintptr_t
+#include <stdio.h>           // for FILE, f{close,open,scanf}, snprintf
+#include <stdlib.h>          // for EXIT_{FAILURE,SUCCESS}, strtoul
+#include <sys/mman.h>        // for mmap, munmap
+#include <sys/syscall.h>     // for SYS_{mbind,sched_setaffinity}
+#include <time.h>            // for clock_gettime
+#include <unistd.h>          // for syscall
+
+#include "zakc/hashmap.h"  // for hashmap, u64_{cmp,hash}
+#include "zakc/log.h"      // for error
+#include "zakc/print.h"    // for println
+#include "zakc/shardmap.h" // for shardmap
+#include "zakc/types.h"    // for f64, u64, usize
+
+// Maximum number of NUMA nodes measured
+#define MAX_NODES 64
+// Maximum number of CPUs to pin to
+#define MAX_CPUS 1024
+// Size of the buffer chased through when measuring latency
+#define CHASE_SIZE (256 << 20)
+// Number of loads per latency measurement
+#define CHASE_LOADS (1 << 24)
+// Default number of items in the sharded hash map
+#define ITEMS (1 << 22)
+
+// Cache line of the chased buffer
+struct line {
+    struct line *next;
+    u64 pad[7];
+};
+
+// Get the current time in seconds
+static f64 now(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+// Parse a list of ranges (e.g. "0-3,8") from a file into an array of flags
+static usize parse_list(const char *path, bool *flags, usize nflags) {
+    FILE *file = fopen(path, "r");
+    if (!file)
+        return 0;
+    usize count = 0;
+    unsigned lo, hi;
+    for (int n; (n = fscanf(file, "%u-%u", &lo, &hi)) > 0;) {
+        if (n == 1)
+            hi = lo;
+        for (usize i = lo; i <= hi && i < nflags; i++) {
+            count += !flags[i];
+            flags[i] = true;
+        }
+        if (fgetc(file) != ',')
+            break;
+    }
+    fclose(file);
+    return count;
+}
+
+// Pin the calling thread to the CPUs of a node
+static void pin(usize node) {
+    char path[64];
+    const char *fmt = "/sys/devices/system/node/node%zu/cpulist";
+    snprintf(path, sizeof(path), fmt, node);
+    bool cpus[MAX_CPUS] = {false};
+    if (!parse_list(path, cpus, MAX_CPUS))
+        return;
+    unsigned long mask[MAX_CPUS / 64] = {0};
+    for (usize cpu = 0; cpu < MAX_CPUS; cpu++)
+        mask[cpu / 64] |= (unsigned long)cpus[cpu] << (cpu % 64);
+    syscall(SYS_sched_setaffinity, 0, sizeof(mask), mask);
+}
+
+// Allocate a buffer whose pages are bound to a node
+static void *alloc_on(usize node, usize size) {
+    int prot = PROT_READ | PROT_WRITE;
+    void *buf = mmap(NULL, size, prot, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (buf == MAP_FAILED)
+        return NULL;
+    unsigned long mask = 1ul << node;
+    syscall(SYS_mbind, buf, size, MPOL_BIND, &mask, MAX_NODES + 1, 0);
+    return buf;
+}
+
+// Measure the latency of dependent loads from one node to another's memory
+static f64 chase(usize cpu, usize mem) {
+    usize nlines = CHASE_SIZE / sizeof(struct line);
+    struct line *lines = alloc_on(mem, CHASE_SIZE);
+    if (!lines)
+        return 0;
+    // Link the lines into a single random cycle (Sattolo's algorithm)
+    usize *order = malloc(nlines * sizeof(usize));
+    if (!order) {
+        munmap(lines, CHASE_SIZE);
+        return 0;
+    }
+    for (usize i = 0; i < nlines; i++)
+        order[i] = i;
+    u64 seed = 0x9e3779b97f4a7c15;
+    for (usize i = nlines - 1; i > 0; i--) {
+        seed ^= seed << 13;
+        seed ^= seed >> 7;
+        seed ^= seed << 17;
+        usize j = seed % i;
+        usize tmp = order[i];
+        order[i] = order[j];
+        order[j] = tmp;
+    }
+    for (usize i = 0; i < nlines; i++)
+        lines[order[i]].next = &lines[order[(i + 1) % nlines]];
+    free(order);
+
+    // Chase the pointers from the other node
+    pin(cpu);
+    struct line *p = &lines[0];
+    f64 start = now();
+    for (usize i = 0; i < CHASE_LOADS; i++)
+        p = p->next;
+    f64 elapsed = now() - start;
+    // Keep the chase from being optimized away
+    __asm__ volatile("" : : "r"(p));
+    munmap(lines, CHASE_SIZE);
+    return elapsed / CHASE_LOADS * 1e9;
+}
+
+// Look up a key on the owner of its shard, counting it if found
+static void lookup(struct hashmap *shard, const void *key, void *context) {
+    *(usize *)context += hashmap_get(shard, key) != NULL;
+}
+
+// Insert a key on the owner of its shard
+static void insert(struct hashmap *shard, const void *key, void *context) {
+    hashmap_insert(shard, key, (void *)key);
+}
+
+int main(int argc, char *argv[]) {
+    // Parse the number of items
+    usize nitems = argc > 1 ? strtoul(argv[1], NULL, 10) : 0;
+    if (!nitems)
+        nitems = ITEMS;
+
+    // Find the online NUMA nodes
+    bool online[MAX_NODES] = {false};
+    usize nnodes =
+        parse_list("/sys/devices/system/node/online", online, MAX_NODES);
+    if (!nnodes) {
+        error("failed to find NUMA nodes");
+        return EXIT_FAILURE;
+    }
+
+    // Measure the latency between every pair of nodes
+    println("latency (ns) from CPUs of each row to memory of each column");
+    for (usize cpu = 0; cpu < MAX_NODES; cpu++) {
+        if (!online[cpu])
+            continue;
+        print("node %2zu", cpu);
+        for (usize mem = 0; mem < MAX_NODES; mem++)
+            if (online[mem])
+                print("    %7.1f", chase(cpu, mem));
+        println();
+    }
+
+    // Fill a sharded hash map through the owner of each shard
+    struct shardmap *map = shardmap_new(u64_hash, u64_cmp, 0);
+    if (!map) {
+        error("failed to create sharded hash map");
+        return EXIT_FAILURE;
+    }
+    for (usize i = 1; i <= nitems; i++)
+        shardmap_submit(map, (void *)(uintptr_t)i, insert, NULL);
+    shardmap_wait(map);
+
+    // Sort the keys by shard, so that each shard can be timed separately
+    usize nshards = shardmap_nshards(map);
+    usize *starts = calloc(nshards + 1, sizeof(usize));
+    usize *keys = malloc(nitems * sizeof(usize));
+    usize *found = calloc(nshards, sizeof(usize));
+    if (!starts || !keys || !found) {
+        error("failed to allocate keys");
+        return EXIT_FAILURE;
+    }
+    for (usize i = 1; i <= nitems; i++)
+        starts[shardmap_shard(map, (void *)(uintptr_t)i) + 1]++;
+    for (usize s = 0; s < nshards; s++)
+        starts[s + 1] += starts[s];
+    for (usize i = 1; i <= nitems; i++)
+        keys[starts[shardmap_shard(map, (void *)(uintptr_t)i)]++] = i;
+    for (usize s = nshards; s > 0; s--)
+        starts[s] = starts[s - 1];
+    starts[0] = 0;
+
+    // Look up the keys of each shard directly from the first node
+    usize home = shardmap_node(map, 0);
+    pin(home);
+    println("shard    node    direct from node %zu (ns)    routed (ns)", home);
+    for (usize s = 0; s < nshards; s++) {
+        usize count = starts[s + 1] - starts[s];
+        f64 start = now();
+        for (usize i = starts[s]; i < starts[s + 1]; i++)
+            found[s] += shardmap_contains(map, (void *)(uintptr_t)keys[i]);
+        f64 direct = now() - start;
+
+        // Look up the same keys on the owner of the shard
+        start = now();
+        for (usize i = starts[s]; i < starts[s + 1]; i++) {
+            void *key = (void *)(uintptr_t)keys[i];
+            shardmap_submit(map, key, lookup, &found[s]);
+        }
+        shardmap_wait(map);
+        f64 routed = now() - start;
+
+        println(
+            "%5zu    %4zu    %24.1f    %11.1f",
+            s,
+            shardmap_node(map, s),
+            direct / count * 1e9,
+            routed / count * 1e9
+        );
+        if (found[s] != 2 * count) {
+            error("shard %zu is missing keys", s);
+            return EXIT_FAILURE;
+        }
+    }
+
+    free(found);
+    free(keys);
+    free(starts);
+    shardmap_drop(map);
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,123 @@
+// File:        stream.c
+// Author:      Zakhary Kaplan <https://zakhary.dev>
+// Created:     17 Oct 2026
+// SPDX-License-Identifier: MIT
+
+#include <stdint.h> // for uintptr_t
+#include <stdlib.h> // for EXIT_{FAILURE,SUCCESS}, strtoul
+#include <time.h>   // for clock_gettime
+
+#include "zakc/hashmap.h" // for hashmap, u64_hash
+#include "zakc/log.h"     // for error
+#include "zakc/print.h"   // for println
+#include "zakc/sketch.h"  // for cms, hll
+#include "zakc/types.h"   // for f64, u32, u64, usize
+
+// Default number of keys in the stream
+#define LEN (1 << 22)
+// Number of distinct keys the stream is drawn from
+#define KEYS (1 << 20)
+// Precision of the HyperLogLog
+#define PRECISION 14
+// Width and depth of the Count-Min sketch
+#define WIDTH 4096
+#define DEPTH 4
+// Number of the most frequent keys to report
+#define TOP 5
+
+// Get the current time in seconds
+static f64 now(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+// Get the next pseudo-random number
+static u64 next(u64 *seed) {
+    *seed ^= *seed << 13;
+    *seed ^= *seed >> 7;
+    *seed ^= *seed << 17;
+    return *seed;
+}
+
+// Get the next key of a skewed stream, in which small keys are most frequent
+static u64 key(u64 *seed) {
+    u64 x = next(seed) % KEYS;
+    return x * x / KEYS * x / KEYS + 1;
+}
+
+int main(int argc, char *argv[]) {
+    // Parse the number of keys
+    usize len = argc > 1 ? strtoul(argv[1], NULL, 10) : 0;
+    if (!len)
+        len = LEN;
+
+    struct hashmap *map = hashmap_new_u64();
+    struct hll *hll = hll_new(PRECISION);
+    struct cms *cms = cms_new(WIDTH, DEPTH, true);
+    if (!map || !hll || !cms) {
+        error("failed to create counters");
+        return EXIT_FAILURE;
+    }
+
+    // Count every key exactly
+    u64 seed = 0x9e3779b97f4a7c15;
+    f64 start = now();
+    for (usize i = 0; i < len; i++) {
+        void *k = (void *)(uintptr_t)key(&seed);
+        uintptr_t count = (uintptr_t)hashmap_get(map, k);
+        if (!hashmap_insert(map, k, (void *)(count + 1))) {
+            error("failed to insert key");
+            return EXIT_FAILURE;
+        }
+    }
+    f64 exact = now() - start;
+
+    // Count the same keys approximately
+    seed = 0x9e3779b97f4a7c15;
+    start = now();
+    for (usize i = 0; i < len; i++) {
+        u64 hash = u64_hash((void *)(uintptr_t)key(&seed));
+        if (!hll_add(hll, hash)) {
+            error("failed to add key");
+            return EXIT_FAILURE;
+        }
+        cms_add(cms, hash, 1);
+    }
+    f64 approx = now() - start;
+
+    // Estimate the memory of the map from its layout of one list head per
+    // slot and four words per item
+    usize bytes = hashmap_capacity(map) * sizeof(void *)
+                + hashmap_len(map) * 4 * sizeof(void *);
+    usize state = hll_serialize(hll, NULL, 0) + cms_serialize(cms, NULL, 0);
+    println("counter    time (ms)    distinct    state (KiB)");
+    println(
+        "%-7s    %9.2f    %8zu    %11zu",
+        "hashmap",
+        exact * 1e3,
+        hashmap_len(map),
+        bytes / 1024
+    );
+    println(
+        "%-7s    %9.2f    %8llu    %11zu",
+        "sketch",
+        approx * 1e3,
+        (unsigned long long)hll_count(hll),
+        state / 1024
+    );
+
+    // Compare the counts of the most frequent keys, which are the smallest
+    println();
+    println("key    count    estimate");
+    for (uintptr_t k = 1; k <= TOP; k++) {
+        uintptr_t count = (uintptr_t)hashmap_get(map, (void *)k);
+        u32 estimate = cms_estimate(cms, u64_hash((void *)k));
+        println("%3zu    %5zu    %8u", (usize)k, (usize)count, estimate);
+    }
+
+    hashmap_drop(map);
+    hll_drop(hll);
+    cms_drop(cms);
+    return EXIT_SUCCESS;
+}
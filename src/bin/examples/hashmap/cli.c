@@ -9,8 +9,11 @@
 
 #include "zakc/hashmap.h"
 #include "zakc/log.h"
+#include "zakc/phash.h"
 #include "zakc/types.h"
 
+#include "commands.h"
+
 #define NAME    "cli"
 #define VERSION "0.1.0"
 
@@ -20,6 +23,7 @@ void cmd_help(void);
 void cmd_print(void);
 void cmd_new(void);
 void cmd_drop(void);
+void cmd_clear(void);
 void cmd_insert(void);
 void cmd_remove(void);
 void cmd_contains(void);
@@ -117,33 +121,49 @@ void loop(void) {
         fgets(cmd, sizeof(cmd), stdin);
         cmd[strcspn(cmd, "\n")] = '\0'; // remove newline from the input
 
-        // Process the command
-        if (strcmp(cmd, "help") == 0) {
+        // Process the command, looking it up in a perfect hash table
+        // generated from `commands.txt`
+        switch (phash_index(&commands, cmd)) {
+        case CmdHelp:
             cmd_help();
-        } else if (strcmp(cmd, "print") == 0) {
+            break;
+        case CmdPrint:
             cmd_print();
-        } else if (strcmp(cmd, "new") == 0) {
+            break;
+        case CmdNew:
             cmd_new();
-        } else if (strcmp(cmd, "insert") == 0) {
+            break;
+        case CmdInsert:
             cmd_insert();
-        } else if (strcmp(cmd, "remove") == 0) {
+            break;
+        case CmdRemove:
             cmd_remove();
-        } else if (strcmp(cmd, "get") == 0) {
+            break;
+        case CmdGet:
             cmd_get();
-        } else if (strcmp(cmd, "contains") == 0) {
+            break;
+        case CmdContains:
             cmd_contains();
-        } else if (strcmp(cmd, "drop") == 0) {
+            break;
+        case CmdDrop:
             cmd_drop();
-        } else if (strcmp(cmd, "len") == 0) {
+            break;
+        case CmdClear:
+            cmd_clear();
+            break;
+        case CmdLen:
             cmd_len();
-        } else if (strcmp(cmd, "capacity") == 0) {
+            break;
+        case CmdCapacity:
             cmd_cap();
-        } else if (strcmp(cmd, "reserve") == 0) {
+            break;
+        case CmdReserve:
             cmd_reserve();
-        } else if (strcmp(cmd, "quit") == 0) {
-            // Repeat the loop unless the user entered the "quit" command
             break;
-        } else {
+        case CmdQuit:
+            // Stop the command loop once the user enters the "quit" command
+            return;
+        default:
             error("invalid command");
         }
     }
@@ -160,6 +180,7 @@ void cmd_help(void) {
     println("  get         Retrieve the value associated with a given key");
     println("  contains    Check if the hash map contains a given key");
     println("  drop        Delete the entire hash map");
+    println("  clear       Remove every item from the hash map");
     println("  len         Print the number of items in the hash map");
     println("  capacity    Print the current capacity of the hash map");
     println("  reserve     Change the capacity of the hash map");
@@ -199,32 +220,37 @@ void cmd_new(void) {
         error("failed to create hash map");
         return;
     }
+    // Let the hash map free its keys and values
+    hashmap_set_free(map, free, free);
 
     info("hash map created");
 }
 
 // Delete the hash map
-static void cmd_drop_item(const void *key, void *data, void *_context) {
-    debug("  %s => %d", (char *)key, *((int *)data));
-    free((void *)key);
-    free((void *)data);
-}
 void cmd_drop(void) {
     if (map == NULL) {
         error("hash map is not created");
         return;
     }
 
-    // Delete the hash map
-    if (hashmap_len(map)) {
-        debug("deleting items:");
-        hashmap_iter(map, cmd_drop_item, NULL);
-    }
+    // Delete the hash map, which frees its keys and values
     hashmap_drop(map);
     map = NULL;
     info("hash map deleted");
 }
 
+// Remove every item from the hash map
+void cmd_clear(void) {
+    if (map == NULL) {
+        error("hash map is not created");
+        return;
+    }
+
+    // Clear the hash map, which frees its keys and values
+    hashmap_clear(map);
+    info("hash map cleared");
+}
+
 // Insert an item with a string key and integer value into the hash map
 void cmd_insert(void) {
     if (map == NULL) {
@@ -268,6 +294,7 @@ void cmd_remove(void) {
     int *value = hashmap_remove(map, key);
     if (value != NULL) {
         info("item removed (value = %d)", *value);
+        free(value);
     } else {
         error("item not found");
     }
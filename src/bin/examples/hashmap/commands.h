@@ -0,0 +1,62 @@
+// Generated by `phash` from commands.txt.
+// Do not edit.
+
+#pragma once
+
+#include "zakc/phash.h" // for phash
+#include "zakc/types.h" // for u32, usize
+
+// Position of each key of `commands`
+enum commands_key {
+    CmdHelp,
+    CmdPrint,
+    CmdNew,
+    CmdInsert,
+    CmdRemove,
+    CmdGet,
+    CmdContains,
+    CmdDrop,
+    CmdClear,
+    CmdLen,
+    CmdCapacity,
+    CmdReserve,
+    CmdQuit,
+};
+
+// Seed of each bucket of `commands`
+static const u32 commands_seeds[] = {
+    0, 4, 30, 0, 0, 2, 16,
+};
+
+// Key in each slot of `commands`
+static const char *const commands_keys[] = {
+    "capacity",
+    "drop",
+    "insert",
+    "reserve",
+    "contains",
+    "new",
+    "remove",
+    "get",
+    "quit",
+    "len",
+    "print",
+    "help",
+    "clear",
+};
+
+// Position of the key in each slot of `commands`
+static const usize commands_ranks[] = {
+    10, 7, 3, 11, 6, 2, 4, 5,
+    12, 9, 1, 0, 8,
+};
+
+// Perfect hash table of 13 keys
+static const struct phash commands = {
+    .len = 13,
+    .nbuckets = 7,
+    .seeds = commands_seeds,
+    .keys = commands_keys,
+    .ranks = commands_ranks,
+    .values = NULL,
+};
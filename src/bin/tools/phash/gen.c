@@ -0,0 +1,449 @@
+// File:        gen.c
+// Author:      Zakhary Kaplan <https://zakhary.dev>
+// Created:     17 Oct 2026
+// SPDX-License-Identifier: MIT
+
+#include <ctype.h>  // for isalnum, isalpha, isprint, isspace, toupper
+#include <stdio.h>  // for FILE, fclose, fopen, getline, stdin
+#include <stdlib.h> // for EXIT_{FAILURE,SUCCESS}, calloc, free, malloc
+#include <string.h> // for strcmp, strcpy, strdup, strlen
+
+#include "zakc/hashmap.h" // for hashmap, str_{cmp,hash}
+#include "zakc/log.h"     // for error
+#include "zakc/phash.h"   // for phash_{bucket,hash,slot}
+#include "zakc/print.h"   // for print, println
+#include "zakc/types.h"   // for u32, u64, usize
+#include "zakc/vector.h"  // for vector
+
+#define NAME "phash"
+
+// Average number of keys per bucket
+#define LOAD 2
+// Number of seeds tried for a bucket before giving up
+#define MAX_SEED (1u << 24)
+// Number of values printed per line of an array
+#define PER_LINE 8
+
+// Key read from the input
+struct entry {
+    // Key, as a C-string
+    char *key;
+    // C expression for the key's data, or `NULL` if it has none
+    char *value;
+    // Name of the key's position, or `NULL` if it is not named
+    char *name;
+    // Hash of the key
+    u64 hash;
+    // Position of the key within the input
+    usize rank;
+};
+
+// Command-line arguments
+struct args {
+    // Name of the generated table
+    const char *name;
+    // Prefix of the names of each key's position, or `NULL` to not name them
+    const char *prefix;
+    // Path of the input, or `NULL` to read from stdin
+    const char *path;
+};
+
+// Print help instructions
+static void help(void) {
+    println("Generate a static perfect hash table as C source");
+    println();
+    println("Usage: %s [OPTIONS] [FILE]", NAME);
+    println();
+    println("Each line of the input holds a key, optionally followed by");
+    println("whitespace and a C expression for the key's data. Blank lines");
+    println("and lines starting with '#' are ignored.");
+    println();
+    println("Options:");
+    println("  -n, --name <NAME>        Name of the table [default: table]");
+    println("  -p, --prefix <PREFIX>    Prefix for an enum naming each key");
+    println("  -h, --help               Print help information");
+}
+
+// Parse the command-line arguments
+static struct args parse(int argc, char *argv[]) {
+    struct args args = {
+        .name = "table",
+        .prefix = NULL,
+        .path = NULL,
+    };
+    for (int i = 1; i < argc; i++) {
+        if (!strcmp(argv[i], "-h") || !strcmp(argv[i], "--help")) {
+            help();
+            exit(EXIT_SUCCESS);
+        } else if (!strcmp(argv[i], "-n") || !strcmp(argv[i], "--name")) {
+            if (++i == argc) {
+                error("missing table name");
+                exit(EXIT_FAILURE);
+            }
+            args.name = argv[i];
+        } else if (!strcmp(argv[i], "-p") || !strcmp(argv[i], "--prefix")) {
+            if (++i == argc) {
+                error("missing enum prefix");
+                exit(EXIT_FAILURE);
+            }
+            args.prefix = argv[i];
+        } else if (argv[i][0] == '-' || args.path) {
+            error("invalid argument: %s", argv[i]);
+            exit(EXIT_FAILURE);
+        } else {
+            args.path = argv[i];
+        }
+    }
+    return args;
+}
+
+// Read the keys of the input, in order
+static bool read_keys(FILE *file, struct vector *entries) {
+    char *line = NULL;
+    usize cap = 0;
+    for (isize n; (n = getline(&line, &cap, file)) >= 0;) {
+        // Split the line into a key and an optional value
+        char *key = line;
+        while (isspace((unsigned char)*key))
+            key++;
+        if (!*key || *key == '#')
+            // Skip blank lines and comments
+            continue;
+        char *end = key;
+        while (*end && !isspace((unsigned char)*end))
+            end++;
+        char *value = end;
+        while (isspace((unsigned char)*value))
+            value++;
+        for (char *c = value + strlen(value); c > value && isspace(c[-1]);)
+            *--c = '\0';
+        *end = '\0';
+
+        struct entry *entry = malloc(sizeof(struct entry));
+        if (!entry) {
+            free(line);
+            return false;
+        }
+        *entry = (struct entry){
+            .key = strdup(key),
+            .value = *value ? strdup(value) : NULL,
+            .name = NULL,
+            .hash = phash_hash(key),
+            .rank = vector_len(entries),
+        };
+        if (!entry->key || (*value && !entry->value)
+            || !vector_append(entries, entry)) {
+            free(entry->key);
+            free(entry->value);
+            free(entry);
+            free(line);
+            return false;
+        }
+    }
+    free(line);
+    return true;
+}
+
+// Find a seed for each bucket which places every key in its own slot
+//
+// Buckets are seeded from largest to smallest, as the keys of large buckets
+// are the hardest to place once most slots are taken.
+static bool find_seeds(
+    struct entry **entries, usize len, u32 *seeds, usize nbuckets, usize *slots
+) {
+    usize *starts = calloc(nbuckets + 1, sizeof(usize));
+    usize *members = malloc(len * sizeof(usize));
+    bool *taken = calloc(len, sizeof(bool));
+    bool ok = starts && members && taken;
+    if (!ok)
+        goto done;
+
+    // Group the keys by bucket, so that the keys of bucket `b` are listed by
+    // `members[starts[b]..starts[b + 1]]`
+    for (usize i = 0; i < len; i++)
+        starts[phash_bucket(entries[i]->hash, nbuckets) + 1]++;
+    usize max = 0;
+    for (usize b = 0; b < nbuckets; b++) {
+        if (starts[b + 1] > max)
+            max = starts[b + 1];
+        starts[b + 1] += starts[b];
+    }
+    for (usize i = len; i > 0; i--) {
+        usize b = phash_bucket(entries[i - 1]->hash, nbuckets);
+        members[--starts[b + 1]] = i - 1;
+    }
+    for (usize b = 0; b < nbuckets; b++)
+        starts[b] = starts[b + 1];
+    starts[nbuckets] = len;
+
+    // Seed the buckets in decreasing order of size
+    for (usize size = max; ok && size > 0; size--) {
+        for (usize b = 0; ok && b < nbuckets; b++) {
+            usize start = starts[b];
+            if (starts[b + 1] - start != size)
+                continue;
+            u32 seed = 0;
+            for (; seed < MAX_SEED; seed++) {
+                // Try to place every key of the bucket in a free slot
+                usize placed = 0;
+                for (; placed < size; placed++) {
+                    struct entry *entry = entries[members[start + placed]];
+                    usize slot = phash_slot(entry->hash, seed, len);
+                    if (taken[slot])
+                        break;
+                    taken[slot] = true;
+                    slots[members[start + placed]] = slot;
+                }
+                if (placed == size)
+                    break;
+                // Release the slots taken before the collision
+                while (placed-- > 0)
+                    taken[slots[members[start + placed]]] = false;
+            }
+            seeds[b] = seed;
+            ok = seed < MAX_SEED;
+        }
+    }
+
+done:
+    free(taken);
+    free(members);
+    free(starts);
+    return ok;
+}
+
+// Print a key as a C-string literal
+static void print_key(const char *key) {
+    print("\"");
+    for (const unsigned char *c = (const unsigned char *)key; *c; c++) {
+        if (*c == '"' || *c == '\\')
+            print("\\%c", *c);
+        else if (isprint(*c))
+            print("%c", *c);
+        else
+            print("\\%03o", *c);
+    }
+    print("\"");
+}
+
+// Make the name of a key's position, made of the prefix and the key's words
+static char *make_name(const char *prefix, const char *key) {
+    usize len = strlen(prefix);
+    char *name = malloc(len + strlen(key) + 1);
+    if (!name)
+        return NULL;
+    strcpy(name, prefix);
+    bool word = true;
+    for (const char *c = key; *c; c++) {
+        if (!isalnum((unsigned char)*c)) {
+            word = true;
+            continue;
+        }
+        name[len++] = word ? toupper((unsigned char)*c) : *c;
+        word = false;
+    }
+    name[len] = '\0';
+    return name;
+}
+
+// Print the generated table
+static void emit(
+    const struct args *args,
+    struct entry **entries,
+    usize len,
+    const u32 *seeds,
+    usize nbuckets,
+    struct entry **by_slot
+) {
+    const char *name = args->name;
+    bool values = false;
+    for (usize i = 0; i < len; i++)
+        values |= entries[i]->value != NULL;
+
+    const char *path = args->path ? args->path : "stdin";
+    println("// Generated by `%s` from %s.", NAME, path);
+    println("// Do not edit.");
+    println();
+    println("#pragma once");
+    println();
+    println("#include \"zakc/phash.h\" // for phash");
+    println("#include \"zakc/types.h\" // for u32, usize");
+    println();
+
+    if (args->prefix) {
+        // Name the position of each key
+        println("// Position of each key of `%s`", name);
+        println("enum %s_key {", name);
+        for (usize i = 0; i < len; i++) {
+            println("    %s,", entries[i]->name);
+        }
+        println("};");
+        println();
+    }
+
+    println("// Seed of each bucket of `%s`", name);
+    print("static const u32 %s_seeds[] = {", name);
+    for (usize b = 0; b < nbuckets; b++)
+        print("%s%u,", b % PER_LINE ? " " : "\n    ", seeds[b]);
+    println("\n};");
+    println();
+
+    println("// Key in each slot of `%s`", name);
+    println("static const char *const %s_keys[] = {", name);
+    for (usize s = 0; s < len; s++) {
+        print("    ");
+        print_key(by_slot[s]->key);
+        println(",");
+    }
+    println("};");
+    println();
+
+    println("// Position of the key in each slot of `%s`", name);
+    print("static const usize %s_ranks[] = {", name);
+    for (usize s = 0; s < len; s++)
+        print("%s%zu,", s % PER_LINE ? " " : "\n    ", by_slot[s]->rank);
+    println("\n};");
+    println();
+
+    if (values) {
+        println("// Data of the key in each slot of `%s`", name);
+        println("static void *const %s_values[] = {", name);
+        for (usize s = 0; s < len; s++) {
+            const char *value = by_slot[s]->value;
+            if (value)
+                println("    (void *)(%s),", value);
+            else
+                println("    NULL,");
+        }
+        println("};");
+        println();
+    }
+
+    println("// Perfect hash table of %zu keys", len);
+    println("static const struct phash %s = {", name);
+    println("    .len = %zu,", len);
+    println("    .nbuckets = %zu,", nbuckets);
+    println("    .seeds = %s_seeds,", name);
+    println("    .keys = %s_keys,", name);
+    println("    .ranks = %s_ranks,", name);
+    if (values)
+        println("    .values = %s_values,", name);
+    else
+        println("    .values = NULL,");
+    println("};");
+}
+
+int main(int argc, char *argv[]) {
+    // Parse args
+    struct args args = parse(argc, argv);
+
+    // Read the keys
+    FILE *file = args.path ? fopen(args.path, "r") : stdin;
+    if (!file) {
+        error("failed to open %s", args.path);
+        return EXIT_FAILURE;
+    }
+    struct vector *vec = vector_new();
+    if (!vec || !read_keys(file, vec)) {
+        error("failed to read keys");
+        return EXIT_FAILURE;
+    }
+    if (args.path)
+        fclose(file);
+    struct entry **entries = (struct entry **)vector_array(vec);
+    usize len = vector_len(vec);
+    if (len == 0) {
+        error("no keys given");
+        return EXIT_FAILURE;
+    }
+
+    // Reject duplicate keys, which cannot have slots of their own
+    struct hashmap *seen = hashmap_new(str_hash, str_cmp);
+    if (!seen) {
+        error("failed to create hash map");
+        return EXIT_FAILURE;
+    }
+    for (usize i = 0; i < len; i++) {
+        if (hashmap_contains(seen, entries[i]->key)) {
+            error("duplicate key: %s", entries[i]->key);
+            return EXIT_FAILURE;
+        }
+        if (!hashmap_insert(seen, entries[i]->key, entries[i])) {
+            error("failed to insert key");
+            return EXIT_FAILURE;
+        }
+    }
+    hashmap_drop(seen);
+
+    if (args.prefix) {
+        // Name the position of each key, rejecting names which are not
+        // identifiers or which are shared by keys differing only in
+        // punctuation or case
+        struct hashmap *names = hashmap_new(str_hash, str_cmp);
+        if (!names) {
+            error("failed to create hash map");
+            return EXIT_FAILURE;
+        }
+        for (usize i = 0; i < len; i++) {
+            char *name = make_name(args.prefix, entries[i]->key);
+            if (!name) {
+                error("failed to allocate name");
+                return EXIT_FAILURE;
+            }
+            entries[i]->name = name;
+            if (!isalpha((unsigned char)*name) && *name != '_') {
+                error(
+                    "invalid enum name for key %s: %s", entries[i]->key, name
+                );
+                return EXIT_FAILURE;
+            }
+            const struct entry *other = hashmap_get(names, name);
+            if (other) {
+                error(
+                    "duplicate enum name for keys %s and %s: %s",
+                    other->key,
+                    entries[i]->key,
+                    name
+                );
+                return EXIT_FAILURE;
+            }
+            if (!hashmap_insert(names, name, entries[i])) {
+                error("failed to insert name");
+                return EXIT_FAILURE;
+            }
+        }
+        hashmap_drop(names);
+    }
+
+    // Place each key in its own slot
+    usize nbuckets = (len + LOAD - 1) / LOAD;
+    u32 *seeds = calloc(nbuckets, sizeof(u32));
+    usize *slots = malloc(len * sizeof(usize));
+    struct entry **by_slot = malloc(len * sizeof(struct entry *));
+    if (!seeds || !slots || !by_slot) {
+        error("failed to allocate table");
+        return EXIT_FAILURE;
+    }
+    if (!find_seeds(entries, len, seeds, nbuckets, slots)) {
+        error("failed to find a perfect hash");
+        return EXIT_FAILURE;
+    }
+    for (usize i = 0; i < len; i++)
+        by_slot[slots[i]] = entries[i];
+
+    // Print the table
+    emit(&args, entries, len, seeds, nbuckets, by_slot);
+
+    // Clean up
+    for (usize i = 0; i < len; i++) {
+        free(entries[i]->key);
+        free(entries[i]->value);
+        free(entries[i]->name);
+        free(entries[i]);
+    }
+    vector_drop(vec);
+    free(by_slot);
+    free(slots);
+    free(seeds);
+    return EXIT_SUCCESS;
+}
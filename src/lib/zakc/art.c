@@ -0,0 +1,1037 @@
+// File:        art.c
+// Author:      Zakhary Kaplan <https://zakhary.dev>
+// Created:     17 Oct 2026
+// SPDX-License-Identifier: MIT
+
+#include "zakc/art.h"
+
+#include <stdint.h> // for uintptr_t
+#include <stdlib.h> // for calloc, free, malloc
+#include <string.h> // for mem{cmp,cpy,move}
+
+#ifdef __SSE2__
+#include <emmintrin.h> // for _mm_*
+#endif
+
+#include "zakc/types.h" // for u{8,16,32}, usize
+
+// Number of prefix bytes stored inline in each node
+#define MAX_PREFIX 10
+
+// Tag bit of a child pointer which refers to a leaf
+#define LEAF ((uintptr_t)1)
+#define is_leaf(child) ((uintptr_t)(child) & LEAF)
+#define to_leaf(child) ((struct aleaf *)((uintptr_t)(child) & ~LEAF))
+#define tag_leaf(leaf) ((struct anode *)((uintptr_t)(leaf) | LEAF))
+
+#define min(a, b) ((a) < (b) ? (a) : (b))
+
+// Adaptive radix tree structure
+struct art {
+    // Root of the tree, or `NULL` if empty
+    struct anode *root;
+    // Number of items in the tree
+    usize nitems;
+};
+
+// Leaf structure
+struct aleaf {
+    // Key of the item
+    const u8 *key;
+    // Length of the key
+    usize len;
+    // Data of the item
+    void *data;
+};
+
+// Node types, by maximum number of children
+enum anode_type {
+    Node4,
+    Node16,
+    Node48,
+    Node256,
+};
+
+// Node header structure
+struct anode {
+    // Type of the node
+    u8 type;
+    // Number of children
+    u16 nchildren;
+    // Length of the compressed path leading to the children
+    u32 prefix_len;
+    // First bytes of the compressed path
+    u8 prefix[MAX_PREFIX];
+    // Leaf whose key ends at this node, if any
+    struct aleaf *value;
+};
+
+// Node with up to 4 children, with sorted keys
+struct anode4 {
+    struct anode node;
+    u8 keys[4];
+    struct anode *children[4];
+};
+
+// Node with up to 16 children, with sorted keys
+struct anode16 {
+    struct anode node;
+    u8 keys[16];
+    struct anode *children[16];
+};
+
+// Node with up to 48 children, indexed by key
+struct anode48 {
+    struct anode node;
+    // Index of each key's child plus one, or zero if absent
+    u8 index[256];
+    struct anode *children[48];
+};
+
+// Node with up to 256 children, directly indexed by key
+struct anode256 {
+    struct anode node;
+    struct anode *children[256];
+};
+
+// Size of each type of node
+static const usize anode_size[] = {
+    [Node4] = sizeof(struct anode4),
+    [Node16] = sizeof(struct anode16),
+    [Node48] = sizeof(struct anode48),
+    [Node256] = sizeof(struct anode256),
+};
+
+/*
+ * Keys
+ */
+
+// Compare two keys lexicographically
+static int key_cmp(const u8 *left, usize llen, const u8 *right, usize rlen) {
+    int cmp = memcmp(left, right, min(llen, rlen));
+    if (cmp)
+        return cmp;
+    return (llen > rlen) - (llen < rlen);
+}
+
+// Check if a leaf has the given key
+static bool aleaf_matches(const struct aleaf *leaf, const u8 *key, usize len) {
+    return leaf->len == len && !memcmp(leaf->key, key, len);
+}
+
+/*
+ * Nodes
+ */
+
+// Create a new node of the given type
+static struct anode *anode_new(enum anode_type type) {
+    struct anode *node = calloc(1, anode_size[type]);
+    if (node)
+        node->type = type;
+    return node;
+}
+
+// Free a node and everything below it
+static void anode_free(struct anode *node) {
+    if (!node)
+        return;
+    if (is_leaf(node)) {
+        free(to_leaf(node));
+        return;
+    }
+    free(node->value);
+    switch (node->type) {
+    case Node4:
+        for (usize i = 0; i < node->nchildren; i++)
+            anode_free(((struct anode4 *)node)->children[i]);
+        break;
+    case Node16:
+        for (usize i = 0; i < node->nchildren; i++)
+            anode_free(((struct anode16 *)node)->children[i]);
+        break;
+    case Node48:
+        for (usize i = 0; i < 48; i++)
+            anode_free(((struct anode48 *)node)->children[i]);
+        break;
+    case Node256:
+        for (usize i = 0; i < 256; i++)
+            anode_free(((struct anode256 *)node)->children[i]);
+        break;
+    }
+    free(node);
+}
+
+// Copy the header of a node into a node of another type
+static void anode_copy_header(struct anode *dst, const struct anode *src) {
+    dst->nchildren = src->nchildren;
+    dst->prefix_len = src->prefix_len;
+    memcpy(dst->prefix, src->prefix, min(src->prefix_len, MAX_PREFIX));
+    dst->value = src->value;
+}
+
+// Get the next child of a node in key order, advancing a cursor
+static struct anode *anode_next(const struct anode *node, usize *pos, u8 *key) {
+    switch (node->type) {
+    case Node4: {
+        const struct anode4 *n = (const struct anode4 *)node;
+        if (*pos >= node->nchildren)
+            return NULL;
+        *key = n->keys[*pos];
+        return n->children[(*pos)++];
+    }
+    case Node16: {
+        const struct anode16 *n = (const struct anode16 *)node;
+        if (*pos >= node->nchildren)
+            return NULL;
+        *key = n->keys[*pos];
+        return n->children[(*pos)++];
+    }
+    case Node48: {
+        const struct anode48 *n = (const struct anode48 *)node;
+        for (; *pos < 256; (*pos)++) {
+            if (n->index[*pos]) {
+                *key = *pos;
+                return n->children[n->index[(*pos)++] - 1];
+            }
+        }
+        return NULL;
+    }
+    case Node256: {
+        const struct anode256 *n = (const struct anode256 *)node;
+        for (; *pos < 256; (*pos)++) {
+            if (n->children[*pos]) {
+                *key = *pos;
+                return n->children[(*pos)++];
+            }
+        }
+        return NULL;
+    }
+    }
+    return NULL;
+}
+
+// Find the leaf with the smallest key below a node
+static struct aleaf *anode_min(const struct anode *node) {
+    while (!is_leaf(node)) {
+        if (node->value)
+            return node->value;
+        usize pos = 0;
+        u8 key;
+        node = anode_next(node, &pos, &key);
+    }
+    return to_leaf(node);
+}
+
+// Get the full compressed path of a node at the given depth
+static const u8 *anode_prefix(const struct anode *node, usize depth) {
+    if (node->prefix_len <= MAX_PREFIX)
+        return node->prefix;
+    // Recover the bytes which are not stored inline from any leaf below
+    return anode_min(node)->key + depth;
+}
+
+// Find the length of the common prefix of a node's path and a key
+static usize anode_mismatch(
+    const struct anode *node, const u8 *key, usize len, usize depth
+) {
+    usize max = min(node->prefix_len, len - depth);
+    // Compare the bytes stored inline first
+    usize i = 0;
+    for (usize n = min(max, MAX_PREFIX); i < n; i++)
+        if (node->prefix[i] != key[depth + i])
+            return i;
+    if (i == max)
+        return i;
+    // Compare the remaining bytes against a leaf
+    const u8 *prefix = anode_prefix(node, depth);
+    for (; i < max; i++)
+        if (prefix[i] != key[depth + i])
+            return i;
+    return i;
+}
+
+// Find the position of a key in a node with up to 16 sorted keys
+static struct anode **anode16_find(struct anode16 *n, u8 key) {
+#ifdef __SSE2__
+    // Compare the key against every key at once
+    __m128i keys = _mm_loadu_si128((const __m128i *)n->keys);
+    __m128i cmp = _mm_cmpeq_epi8(_mm_set1_epi8((char)key), keys);
+    u32 mask = _mm_movemask_epi8(cmp) & ((1u << n->node.nchildren) - 1);
+    return mask ? &n->children[__builtin_ctz(mask)] : NULL;
+#else
+    for (usize i = 0; i < n->node.nchildren; i++)
+        if (n->keys[i] == key)
+            return &n->children[i];
+    return NULL;
+#endif
+}
+
+// Find the insertion position of a key in a node with up to 16 sorted keys
+static usize anode16_lower(const struct anode16 *n, u8 key) {
+#ifdef __SSE2__
+    // Flip the sign bits to compare the keys as unsigned bytes
+    __m128i bias = _mm_set1_epi8((char)0x80);
+    __m128i keys = _mm_xor_si128(
+        _mm_loadu_si128((const __m128i *)n->keys), bias
+    );
+    __m128i probe = _mm_xor_si128(_mm_set1_epi8((char)key), bias);
+    u32 mask = _mm_movemask_epi8(_mm_cmplt_epi8(keys, probe)) &
+               ((1u << n->node.nchildren) - 1);
+    return __builtin_popcount(mask);
+#else
+    usize i = 0;
+    while (i < n->node.nchildren && n->keys[i] < key)
+        i++;
+    return i;
+#endif
+}
+
+// Find the child of a node for the given key
+static struct anode **anode_find(struct anode *node, u8 key) {
+    switch (node->type) {
+    case Node4: {
+        struct anode4 *n = (struct anode4 *)node;
+        for (usize i = 0; i < node->nchildren; i++)
+            if (n->keys[i] == key)
+                return &n->children[i];
+        return NULL;
+    }
+    case Node16:
+        return anode16_find((struct anode16 *)node, key);
+    case Node48: {
+        struct anode48 *n = (struct anode48 *)node;
+        return n->index[key] ? &n->children[n->index[key] - 1] : NULL;
+    }
+    case Node256: {
+        struct anode256 *n = (struct anode256 *)node;
+        return n->children[key] ? &n->children[key] : NULL;
+    }
+    }
+    return NULL;
+}
+
+// Add a child to a node, growing it into a larger node if it is full
+static bool anode_add(
+    struct anode **ref, struct anode *node, u8 key, struct anode *child
+) {
+    switch (node->type) {
+    case Node4: {
+        struct anode4 *n = (struct anode4 *)node;
+        if (node->nchildren < 4) {
+            // Insert the child in sorted order
+            usize i = 0;
+            while (i < node->nchildren && n->keys[i] < key)
+                i++;
+            usize tail = node->nchildren - i;
+            memmove(&n->keys[i + 1], &n->keys[i], tail);
+            memmove(
+                &n->children[i + 1], &n->children[i], tail * sizeof(void *)
+            );
+            n->keys[i] = key;
+            n->children[i] = child;
+            node->nchildren++;
+            return true;
+        }
+        // Grow into a node with up to 16 children
+        struct anode16 *grown = (struct anode16 *)anode_new(Node16);
+        if (!grown)
+            return false;
+        anode_copy_header(&grown->node, node);
+        memcpy(grown->keys, n->keys, 4);
+        memcpy(grown->children, n->children, 4 * sizeof(void *));
+        *ref = &grown->node;
+        free(node);
+        return anode_add(ref, &grown->node, key, child);
+    }
+    case Node16: {
+        struct anode16 *n = (struct anode16 *)node;
+        if (node->nchildren < 16) {
+            // Insert the child in sorted order
+            usize i = anode16_lower(n, key);
+            usize tail = node->nchildren - i;
+            memmove(&n->keys[i + 1], &n->keys[i], tail);
+            memmove(
+                &n->children[i + 1], &n->children[i], tail * sizeof(void *)
+            );
+            n->keys[i] = key;
+            n->children[i] = child;
+            node->nchildren++;
+            return true;
+        }
+        // Grow into a node with up to 48 children
+        struct anode48 *grown = (struct anode48 *)anode_new(Node48);
+        if (!grown)
+            return false;
+        anode_copy_header(&grown->node, node);
+        memcpy(grown->children, n->children, 16 * sizeof(void *));
+        for (usize i = 0; i < 16; i++)
+            grown->index[n->keys[i]] = i + 1;
+        *ref = &grown->node;
+        free(node);
+        return anode_add(ref, &grown->node, key, child);
+    }
+    case Node48: {
+        struct anode48 *n = (struct anode48 *)node;
+        if (node->nchildren < 48) {
+            // Place the child in the first free slot
+            usize i = 0;
+            while (n->children[i])
+                i++;
+            n->children[i] = child;
+            n->index[key] = i + 1;
+            node->nchildren++;
+            return true;
+        }
+        // Grow into a node with up to 256 children
+        struct anode256 *grown = (struct anode256 *)anode_new(Node256);
+        if (!grown)
+            return false;
+        anode_copy_header(&grown->node, node);
+        for (usize i = 0; i < 256; i++)
+            if (n->index[i])
+                grown->children[i] = n->children[n->index[i] - 1];
+        *ref = &grown->node;
+        free(node);
+        return anode_add(ref, &grown->node, key, child);
+    }
+    case Node256: {
+        struct anode256 *n = (struct anode256 *)node;
+        n->children[key] = child;
+        node->nchildren++;
+        return true;
+    }
+    }
+    return false;
+}
+
+// Replace a node which has a single entry left with that entry
+static void anode_collapse(struct anode **ref, struct anode *node) {
+    struct anode4 *n = (struct anode4 *)node;
+    if (node->nchildren == 0) {
+        // Replace the node with the leaf ending at it
+        *ref = tag_leaf(node->value);
+        free(node);
+        return;
+    }
+    struct anode *child = n->children[0];
+    if (!is_leaf(child)) {
+        // Prepend the node's path and key to the child's path
+        usize len = node->prefix_len;
+        if (len < MAX_PREFIX)
+            node->prefix[len++] = n->keys[0];
+        if (len < MAX_PREFIX) {
+            usize sub = min(child->prefix_len, MAX_PREFIX - len);
+            memcpy(&node->prefix[len], child->prefix, sub);
+            len += sub;
+        }
+        memcpy(child->prefix, node->prefix, min(len, MAX_PREFIX));
+        child->prefix_len += node->prefix_len + 1;
+    }
+    *ref = child;
+    free(node);
+}
+
+// Remove a child from a node, shrinking it into a smaller node if sparse
+static void anode_del(struct anode **ref, struct anode *node, u8 key) {
+    switch (node->type) {
+    case Node4: {
+        struct anode4 *n = (struct anode4 *)node;
+        usize i = 0;
+        while (n->keys[i] != key)
+            i++;
+        usize tail = node->nchildren - i - 1;
+        memmove(&n->keys[i], &n->keys[i + 1], tail);
+        memmove(&n->children[i], &n->children[i + 1], tail * sizeof(void *));
+        node->nchildren--;
+        if (node->nchildren + !!node->value == 1)
+            anode_collapse(ref, node);
+        return;
+    }
+    case Node16: {
+        struct anode16 *n = (struct anode16 *)node;
+        usize i = anode16_find(n, key) - n->children;
+        usize tail = node->nchildren - i - 1;
+        memmove(&n->keys[i], &n->keys[i + 1], tail);
+        memmove(&n->children[i], &n->children[i + 1], tail * sizeof(void *));
+        node->nchildren--;
+        if (node->nchildren > 3)
+            return;
+        // Shrink into a node with up to 4 children
+        struct anode4 *shrunk = (struct anode4 *)anode_new(Node4);
+        if (!shrunk)
+            // Keep the sparse node if memory allocation failed
+            return;
+        anode_copy_header(&shrunk->node, node);
+        memcpy(shrunk->keys, n->keys, 3);
+        memcpy(shrunk->children, n->children, 3 * sizeof(void *));
+        *ref = &shrunk->node;
+        free(node);
+        return;
+    }
+    case Node48: {
+        struct anode48 *n = (struct anode48 *)node;
+        n->children[n->index[key] - 1] = NULL;
+        n->index[key] = 0;
+        node->nchildren--;
+        if (node->nchildren > 12)
+            return;
+        // Shrink into a node with up to 16 children
+        struct anode16 *shrunk = (struct anode16 *)anode_new(Node16);
+        if (!shrunk)
+            // Keep the sparse node if memory allocation failed
+            return;
+        anode_copy_header(&shrunk->node, node);
+        usize j = 0;
+        for (usize i = 0; i < 256; i++) {
+            if (n->index[i]) {
+                shrunk->keys[j] = i;
+                shrunk->children[j++] = n->children[n->index[i] - 1];
+            }
+        }
+        *ref = &shrunk->node;
+        free(node);
+        return;
+    }
+    case Node256: {
+        struct anode256 *n = (struct anode256 *)node;
+        n->children[key] = NULL;
+        node->nchildren--;
+        if (node->nchildren > 37)
+            return;
+        // Shrink into a node with up to 48 children
+        struct anode48 *shrunk = (struct anode48 *)anode_new(Node48);
+        if (!shrunk)
+            // Keep the sparse node if memory allocation failed
+            return;
+        anode_copy_header(&shrunk->node, node);
+        usize j = 0;
+        for (usize i = 0; i < 256; i++) {
+            if (n->children[i]) {
+                shrunk->children[j] = n->children[i];
+                shrunk->index[i] = ++j;
+            }
+        }
+        *ref = &shrunk->node;
+        free(node);
+        return;
+    }
+    }
+}
+
+/*
+ * Iteration
+ */
+
+// Iteration state
+struct awalk {
+    // End key of the range, or `NULL` if unbounded
+    const u8 *hi;
+    // Length of the end key
+    usize hilen;
+    // Callback function to call for each item
+    void (*callback)(const void *key, usize len, void *data, void *context);
+    // User-defined context to pass to the callback function
+    void *context;
+};
+
+// Visit a leaf, returning `false` once past the end of the range
+static bool awalk_leaf(const struct awalk *walk, const struct aleaf *leaf) {
+    if (walk->hi && key_cmp(leaf->key, leaf->len, walk->hi, walk->hilen) >= 0)
+        return false;
+    walk->callback(leaf->key, leaf->len, leaf->data, walk->context);
+    return true;
+}
+
+// Visit every leaf below a node in order
+static bool awalk_all(const struct awalk *walk, const struct anode *node) {
+    if (is_leaf(node))
+        return awalk_leaf(walk, to_leaf(node));
+    // Visit the leaf ending at the node first, as its key is the shortest
+    if (node->value && !awalk_leaf(walk, node->value))
+        return false;
+    usize pos = 0;
+    u8 key;
+    for (const struct anode *child; (child = anode_next(node, &pos, &key));)
+        if (!awalk_all(walk, child))
+            return false;
+    return true;
+}
+
+// Visit every leaf below a node whose key is not less than a lower bound
+static bool awalk_from(
+    const struct awalk *walk,
+    const struct anode *node,
+    const u8 *lo,
+    usize lolen,
+    usize depth
+) {
+    if (is_leaf(node)) {
+        const struct aleaf *leaf = to_leaf(node);
+        if (key_cmp(leaf->key, leaf->len, lo, lolen) < 0)
+            return true;
+        return awalk_leaf(walk, leaf);
+    }
+    if (node->prefix_len) {
+        // Compare the node's path against the lower bound
+        const u8 *prefix = anode_prefix(node, depth);
+        usize max = min(node->prefix_len, lolen - depth);
+        for (usize i = 0; i < max; i++) {
+            if (prefix[i] != lo[depth + i])
+                // Skip the node if it is entirely before the lower bound
+                return prefix[i] < lo[depth + i] || awalk_all(walk, node);
+        }
+        depth += node->prefix_len;
+    }
+    if (depth >= lolen)
+        // Visit the whole node if the lower bound is a prefix of its path
+        return awalk_all(walk, node);
+    // Skip the leaf ending at the node, which is a prefix of the lower bound,
+    // along with every child before the lower bound
+    usize pos = 0;
+    u8 key;
+    for (const struct anode *child; (child = anode_next(node, &pos, &key));) {
+        if (key < lo[depth])
+            continue;
+        bool more = key == lo[depth]
+                      ? awalk_from(walk, child, lo, lolen, depth + 1)
+                      : awalk_all(walk, child);
+        if (!more)
+            return false;
+    }
+    return true;
+}
+
+/**
+ * Create a new adaptive radix tree.
+ *
+ * @return  Pointer to the newly-created tree, or `NULL` if memory allocation
+ *          failed.
+ */
+struct art *art_new(void) {
+    // Allocate memory for the tree
+    struct art *tree = malloc(sizeof(struct art));
+    if (!tree)
+        // Return `NULL` if memory allocation failed
+        return NULL;
+    // Initialize the tree to be empty
+    *tree = (struct art){
+        .root = NULL,
+        .nitems = 0,
+    };
+    // Return the newly-created tree
+    return tree;
+}
+
+/**
+ * Delete the adaptive radix tree.
+ *
+ * @param tree  Pointer to the tree to delete.
+ */
+void art_drop(struct art *tree) {
+    if (!tree)
+        // Return early if the tree is `NULL`
+        return;
+    // Free every node and leaf
+    anode_free(tree->root);
+    // Free the tree
+    free(tree);
+}
+
+/**
+ * Insert an item into the adaptive radix tree.
+ *
+ * @param tree  Pointer to the tree.
+ * @param key   Key of the item to insert.
+ * @param len   Length of the key in bytes.
+ * @param data  Data of the item to insert.
+ * @return      `true` if the operation was successful, `false` otherwise.
+ */
+bool art_insert(struct art *tree, const void *key, usize len, void *data) {
+    if (!tree || (!key && len))
+        // Return `false` if the tree or key is `NULL`
+        return false;
+    const u8 *bytes = key;
+    struct anode **ref = &tree->root;
+    usize depth = 0;
+    for (;;) {
+        struct anode *node = *ref;
+        if (node && is_leaf(node) &&
+            aleaf_matches(to_leaf(node), bytes, len)) {
+            // Replace the data of an existing item
+            to_leaf(node)->data = data;
+            return true;
+        }
+        if (node && !is_leaf(node) && node->prefix_len) {
+            usize diff = anode_mismatch(node, bytes, len, depth);
+            if (diff < node->prefix_len) {
+                // Split the node's path where the key diverges from it
+                struct aleaf *leaf = malloc(sizeof(struct aleaf));
+                struct anode *split = anode_new(Node4);
+                if (!leaf || !split) {
+                    free(leaf);
+                    free(split);
+                    return false;
+                }
+                *leaf = (struct aleaf){.key = bytes, .len = len, .data = data};
+                split->prefix_len = diff;
+                memcpy(split->prefix, node->prefix, min(diff, MAX_PREFIX));
+                // Move the rest of the path below the split
+                const u8 *prefix = anode_prefix(node, depth);
+                u8 edge = prefix[diff];
+                node->prefix_len -= diff + 1;
+                memmove(
+                    node->prefix,
+                    prefix + diff + 1,
+                    min(node->prefix_len, MAX_PREFIX)
+                );
+                anode_add(ref, split, edge, node);
+                if (depth + diff == len)
+                    split->value = leaf;
+                else
+                    anode_add(ref, split, bytes[depth + diff], tag_leaf(leaf));
+                *ref = split;
+                tree->nitems++;
+                return true;
+            }
+            depth += node->prefix_len;
+        }
+        if (!node || is_leaf(node)) {
+            // Create a leaf for the new item
+            struct aleaf *leaf = malloc(sizeof(struct aleaf));
+            if (!leaf)
+                return false;
+            *leaf = (struct aleaf){.key = bytes, .len = len, .data = data};
+            if (!node) {
+                // Store the leaf directly in an empty slot
+                *ref = tag_leaf(leaf);
+                tree->nitems++;
+                return true;
+            }
+            // Split the existing leaf into a node with both leaves
+            struct aleaf *other = to_leaf(node);
+            struct anode *split = anode_new(Node4);
+            if (!split) {
+                free(leaf);
+                return false;
+            }
+            usize max = min(len, other->len);
+            usize lcp = depth;
+            while (lcp < max && bytes[lcp] == other->key[lcp])
+                lcp++;
+            split->prefix_len = lcp - depth;
+            memcpy(
+                split->prefix, bytes + depth, min(lcp - depth, MAX_PREFIX)
+            );
+            if (other->len == lcp)
+                split->value = other;
+            else
+                anode_add(ref, split, other->key[lcp], node);
+            if (len == lcp)
+                split->value = leaf;
+            else
+                anode_add(ref, split, bytes[lcp], tag_leaf(leaf));
+            *ref = split;
+            tree->nitems++;
+            return true;
+        }
+        if (depth == len) {
+            // Store the item at the node its key ends at
+            if (node->value) {
+                node->value->data = data;
+                return true;
+            }
+            node->value = malloc(sizeof(struct aleaf));
+            if (!node->value)
+                return false;
+            *node->value =
+                (struct aleaf){.key = bytes, .len = len, .data = data};
+            tree->nitems++;
+            return true;
+        }
+        // Descend into the child for the next byte, or add a new child
+        struct anode **child = anode_find(node, bytes[depth]);
+        if (!child) {
+            struct aleaf *leaf = malloc(sizeof(struct aleaf));
+            if (!leaf)
+                return false;
+            *leaf = (struct aleaf){.key = bytes, .len = len, .data = data};
+            if (!anode_add(ref, node, bytes[depth], tag_leaf(leaf))) {
+                free(leaf);
+                return false;
+            }
+            tree->nitems++;
+            return true;
+        }
+        ref = child;
+        depth++;
+    }
+}
+
+/**
+ * Remove an item with the given key from the adaptive radix tree.
+ *
+ * @param tree  Pointer to the tree.
+ * @param key   Key of the item to remove.
+ * @param len   Length of the key in bytes.
+ * @return      Pointer to the removed data, or `NULL` if the key was not
+ *              found.
+ */
+void *art_remove(struct art *tree, const void *key, usize len) {
+    if (!tree || !tree->root || (!key && len))
+        // Return `NULL` if the tree is `NULL` or empty, or the key is `NULL`
+        return NULL;
+    const u8 *bytes = key;
+    if (is_leaf(tree->root)) {
+        // Remove the only item if it matches
+        struct aleaf *leaf = to_leaf(tree->root);
+        if (!aleaf_matches(leaf, bytes, len))
+            return NULL;
+        void *data = leaf->data;
+        free(leaf);
+        tree->root = NULL;
+        tree->nitems--;
+        return data;
+    }
+    struct anode **ref = &tree->root;
+    usize depth = 0;
+    for (;;) {
+        struct anode *node = *ref;
+        if (node->prefix_len) {
+            if (anode_mismatch(node, bytes, len, depth) < node->prefix_len)
+                // Return `NULL` if the key diverges from the node's path
+                return NULL;
+            depth += node->prefix_len;
+        }
+        if (depth == len) {
+            // Remove the item whose key ends at the node
+            struct aleaf *leaf = node->value;
+            if (!leaf)
+                return NULL;
+            void *data = leaf->data;
+            free(leaf);
+            node->value = NULL;
+            if (node->type == Node4 && node->nchildren == 1)
+                anode_collapse(ref, node);
+            tree->nitems--;
+            return data;
+        }
+        struct anode **child = anode_find(node, bytes[depth]);
+        if (!child)
+            // Return `NULL` if there is no child for the next byte
+            return NULL;
+        if (is_leaf(*child)) {
+            // Remove the leaf if it matches
+            struct aleaf *leaf = to_leaf(*child);
+            if (!aleaf_matches(leaf, bytes, len))
+                return NULL;
+            void *data = leaf->data;
+            free(leaf);
+            anode_del(ref, node, bytes[depth]);
+            tree->nitems--;
+            return data;
+        }
+        ref = child;
+        depth++;
+    }
+}
+
+/**
+ * Check if a key is in the adaptive radix tree.
+ *
+ * @param tree  Pointer to the tree.
+ * @param key   Key to search for.
+ * @param len   Length of the key in bytes.
+ * @return      `true` if the key exists in the tree, `false` otherwise.
+ */
+bool art_contains(const struct art *tree, const void *key, usize len) {
+    if (!tree || (!key && len))
+        // Return `false` if the tree or key is `NULL`
+        return false;
+    const u8 *bytes = key;
+    const struct anode *node = tree->root;
+    usize depth = 0;
+    while (node) {
+        if (is_leaf(node))
+            // Check the leaf's full key, since paths are only partially
+            // compared on the way down
+            return aleaf_matches(to_leaf(node), bytes, len);
+        if (node->prefix_len) {
+            // Optimistically compare only the bytes of the path stored inline
+            usize n = min(min(node->prefix_len, MAX_PREFIX), len - depth);
+            if (memcmp(node->prefix, bytes + depth, n))
+                return false;
+            depth += node->prefix_len;
+            if (depth > len)
+                return false;
+        }
+        if (depth == len)
+            return node->value && aleaf_matches(node->value, bytes, len);
+        struct anode **child = anode_find((struct anode *)node, bytes[depth]);
+        node = child ? *child : NULL;
+        depth++;
+    }
+    return false;
+}
+
+/**
+ * Get the data associated with a key in the adaptive radix tree.
+ *
+ * @param tree  Pointer to the tree.
+ * @param key   Key to look up.
+ * @param len   Length of the key in bytes.
+ * @return      Pointer to the data associated with the key, or `NULL` if the
+ *              key was not found.
+ */
+void *art_get(const struct art *tree, const void *key, usize len) {
+    if (!tree || (!key && len))
+        // Return `NULL` if the tree or key is `NULL`
+        return NULL;
+    const u8 *bytes = key;
+    const struct anode *node = tree->root;
+    usize depth = 0;
+    while (node) {
+        if (is_leaf(node)) {
+            // Check the leaf's full key, since paths are only partially
+            // compared on the way down
+            const struct aleaf *leaf = to_leaf(node);
+            return aleaf_matches(leaf, bytes, len) ? leaf->data : NULL;
+        }
+        if (node->prefix_len) {
+            // Optimistically compare only the bytes of the path stored inline
+            usize n = min(min(node->prefix_len, MAX_PREFIX), len - depth);
+            if (memcmp(node->prefix, bytes + depth, n))
+                return NULL;
+            depth += node->prefix_len;
+            if (depth > len)
+                return NULL;
+        }
+        if (depth == len) {
+            const struct aleaf *leaf = node->value;
+            return leaf && aleaf_matches(leaf, bytes, len) ? leaf->data : NULL;
+        }
+        struct anode **child = anode_find((struct anode *)node, bytes[depth]);
+        node = child ? *child : NULL;
+        depth++;
+    }
+    return NULL;
+}
+
+/**
+ * Get the number of items in the adaptive radix tree.
+ *
+ * @param tree  Pointer to the tree.
+ * @return      Number of items in the tree, or 0 if the tree is `NULL`.
+ */
+usize art_len(const struct art *tree) {
+    if (!tree)
+        // Return zero if the tree is `NULL`
+        return 0;
+    // Return the number of items in the tree
+    return tree->nitems;
+}
+
+/**
+ * Iterate over the items in the adaptive radix tree in order of their keys.
+ *
+ * @param tree      Pointer to the tree.
+ * @param callback  Callback function to call for each item.
+ * @param context   User-defined context to pass to the callback function.
+ */
+void art_iter(
+    const struct art *tree,
+    void (*callback)(const void *key, usize len, void *data, void *context),
+    void *context
+) {
+    // Iterate over the unbounded range
+    art_range(tree, NULL, 0, NULL, 0, callback, context);
+}
+
+/**
+ * Iterate over the items whose keys start with a given prefix, in order.
+ *
+ * @param tree      Pointer to the tree.
+ * @param prefix    Prefix of the keys to visit.
+ * @param len       Length of the prefix in bytes.
+ * @param callback  Callback function to call for each item.
+ * @param context   User-defined context to pass to the callback function.
+ */
+void art_prefix(
+    const struct art *tree,
+    const void *prefix,
+    usize len,
+    void (*callback)(const void *key, usize len, void *data, void *context),
+    void *context
+) {
+    if (!tree || !callback || (!prefix && len))
+        // Return early if the tree, prefix or callback is `NULL`
+        return;
+    struct awalk walk = {.callback = callback, .context = context};
+    const u8 *bytes = prefix;
+    const struct anode *node = tree->root;
+    usize depth = 0;
+    while (node) {
+        if (is_leaf(node)) {
+            // Visit the leaf if its key starts with the prefix
+            const struct aleaf *leaf = to_leaf(node);
+            if (leaf->len >= len && !memcmp(leaf->key, bytes, len))
+                awalk_leaf(&walk, leaf);
+            return;
+        }
+        if (node->prefix_len) {
+            usize diff = anode_mismatch(node, bytes, len, depth);
+            if (depth + diff == len)
+                // Visit the whole node if the prefix ends within its path
+                break;
+            if (diff < node->prefix_len)
+                // Return early if the prefix diverges from the node's path
+                return;
+            depth += node->prefix_len;
+        }
+        if (depth == len)
+            // Visit the whole node if the prefix ends at it
+            break;
+        struct anode **child = anode_find((struct anode *)node, bytes[depth]);
+        node = child ? *child : NULL;
+        depth++;
+    }
+    if (node)
+        awalk_all(&walk, node);
+}
+
+/**
+ * Iterate over the items in a range of keys, in order.
+ *
+ * @param tree      Pointer to the tree.
+ * @param lo        First key of the range, or `NULL` for no lower bound.
+ * @param lolen     Length of the first key in bytes.
+ * @param hi        Key one past the end of the range, or `NULL` for no upper
+ *                  bound.
+ * @param hilen     Length of the end key in bytes.
+ * @param callback  Callback function to call for each item.
+ * @param context   User-defined context to pass to the callback function.
+ */
+void art_range(
+    const struct art *tree,
+    const void *lo,
+    usize lolen,
+    const void *hi,
+    usize hilen,
+    void (*callback)(const void *key, usize len, void *data, void *context),
+    void *context
+) {
+    if (!tree || !tree->root || !callback)
+        // Return early if the tree is `NULL` or empty, or the callback is
+        // `NULL`
+        return;
+    struct awalk walk = {
+        .hi = hi,
+        .hilen = hilen,
+        .callback = callback,
+        .context = context,
+    };
+    if (lo)
+        // Skip every item before the lower bound
+        awalk_from(&walk, tree->root, lo, lolen, 0);
+    else
+        awalk_all(&walk, tree->root);
+}
@@ -0,0 +1,257 @@
+// File:        cvec.c
+// Author:      Zakhary Kaplan <https://zakhary.dev>
+// Created:     17 Oct 2026
+// SPDX-License-Identifier: MIT
+
+#include "zakc/cvec.h"
+
+#include <stdatomic.h> // for atomic_*
+#include <stdlib.h>    // for calloc, free
+
+#include "zakc/types.h" // for u32, usize
+
+// Number of elements in the first bucket, as a power of two
+#define BITS 5
+#define BASE ((usize)1 << BITS)
+// Number of buckets needed to address every index
+#define NBUCKETS (64 - BITS)
+
+// Concurrent vector structure
+struct cvec {
+    // Number of reserved elements
+    atomic_size_t len;
+    // Table of buckets, each twice the size of the previous one
+    _Atomic(void *) *_Atomic buckets[NBUCKETS];
+};
+
+// Get the bucket containing the element at the given index
+static inline u32 cvec_bucket(usize index) {
+    return 63 - __builtin_clzll(index + BASE) - BITS;
+}
+
+// Get the offset of the element at the given index within its bucket
+static inline usize cvec_offset(usize index, u32 bucket) {
+    return index + BASE - (BASE << bucket);
+}
+
+// Get a bucket, allocating it if necessary
+static _Atomic(void *) *cvec_ensure(struct cvec *vec, u32 bucket) {
+    _Atomic(void *) *data =
+        atomic_load_explicit(&vec->buckets[bucket], memory_order_acquire);
+    if (data)
+        // Return the bucket if it is already allocated
+        return data;
+    // Allocate the bucket, with every element initialized to `NULL`
+    _Atomic(void *) *fresh = calloc(BASE << bucket, sizeof(void *));
+    if (!fresh)
+        return NULL;
+    // Publish the bucket, deferring to any other thread that beat us
+    if (!atomic_compare_exchange_strong_explicit(
+            &vec->buckets[bucket],
+            &data,
+            fresh,
+            memory_order_acq_rel,
+            memory_order_acquire
+        )) {
+        free(fresh);
+        return data;
+    }
+    return fresh;
+}
+
+/**
+ * Create a new concurrent vector.
+ *
+ * @return  Pointer to the newly-created concurrent vector, or `NULL` if
+ *          memory allocation failed.
+ */
+struct cvec *cvec_new(void) {
+    // Allocate memory for the concurrent vector, with no buckets
+    struct cvec *vec = calloc(1, sizeof(struct cvec));
+    if (!vec)
+        // Return `NULL` if memory allocation failed
+        return NULL;
+    atomic_init(&vec->len, 0);
+    // Return the newly-created concurrent vector
+    return vec;
+}
+
+/**
+ * Delete the concurrent vector.
+ *
+ * @param vec  Pointer to the concurrent vector to delete.
+ */
+void cvec_drop(struct cvec *vec) {
+    if (!vec)
+        // Return early if the concurrent vector is `NULL`
+        return;
+    // Free each of the buckets
+    for (u32 i = 0; i < NBUCKETS; i++)
+        free(atomic_load_explicit(&vec->buckets[i], memory_order_relaxed));
+    // Free the concurrent vector
+    free(vec);
+}
+
+/**
+ * Append an element to the end of the concurrent vector.
+ *
+ * @param vec    Pointer to the concurrent vector.
+ * @param data   Pointer to the element to append.
+ * @param index  Optional pointer to store the index of the element, which is
+ *               stored even if the operation fails.
+ * @return       `true` if the operation was successful, `false` otherwise.
+ */
+bool cvec_append(struct cvec *vec, void *data, usize *index) {
+    if (!vec)
+        // Return `false` if the concurrent vector is `NULL`
+        return false;
+    // Reserve a slot for the element
+    usize i = atomic_fetch_add_explicit(&vec->len, 1, memory_order_relaxed);
+    // Report the index even if the element cannot be published, as the slot
+    // stays reserved and can still be filled in with `cvec_set()`
+    if (index)
+        *index = i;
+    u32 bucket = cvec_bucket(i);
+    _Atomic(void *) *slots = cvec_ensure(vec, bucket);
+    if (!slots)
+        // Return `false` if unable to allocate the bucket
+        return false;
+    // Publish the element
+    atomic_store_explicit(
+        &slots[cvec_offset(i, bucket)], data, memory_order_release
+    );
+    return true;
+}
+
+/**
+ * Reserve a contiguous range of elements at the end of the concurrent vector.
+ *
+ * @param vec    Pointer to the concurrent vector.
+ * @param n      Number of elements to reserve.
+ * @param index  Optional pointer to store the index of the first element,
+ *               which is stored even if the operation fails.
+ * @return       `true` if the operation was successful, `false` otherwise.
+ */
+bool cvec_grow_by(struct cvec *vec, usize n, usize *index) {
+    if (!vec)
+        // Return `false` if the concurrent vector is `NULL`
+        return false;
+    // Reserve the range of slots
+    usize first = atomic_fetch_add_explicit(&vec->len, n, memory_order_relaxed);
+    // Report the range even if its buckets cannot be allocated, as it stays
+    // reserved and can still be filled in with `cvec_set()`
+    if (index)
+        *index = first;
+    // Allocate every bucket spanned by the range
+    if (n > 0) {
+        for (u32 b = cvec_bucket(first); b <= cvec_bucket(first + n - 1); b++)
+            if (!cvec_ensure(vec, b))
+                return false;
+    }
+    return true;
+}
+
+/**
+ * Get the element at a given index in the concurrent vector.
+ *
+ * @param vec    Pointer to the concurrent vector.
+ * @param index  Index of the element to get.
+ * @return       Pointer to the element at the given index, or `NULL` if the
+ *               index is out of bounds or the element is not yet published.
+ */
+void *cvec_get(const struct cvec *vec, usize index) {
+    if (!vec || index >= atomic_load_explicit(&vec->len, memory_order_relaxed))
+        // Return `NULL` if the concurrent vector is `NULL` or the index is out
+        // of bounds
+        return NULL;
+    u32 bucket = cvec_bucket(index);
+    _Atomic(void *) *slots =
+        atomic_load_explicit(&vec->buckets[bucket], memory_order_acquire);
+    if (!slots)
+        // Return `NULL` if the bucket is not yet allocated
+        return NULL;
+    // Return the element at the given index
+    return atomic_load_explicit(
+        &slots[cvec_offset(index, bucket)], memory_order_acquire
+    );
+}
+
+/**
+ * Set the element at a given index in the concurrent vector.
+ *
+ * @param vec    Pointer to the concurrent vector.
+ * @param index  Index of the element to set.
+ * @param data   Pointer to the element to set.
+ * @return       `true` if the operation was successful, `false` otherwise.
+ */
+bool cvec_set(struct cvec *vec, usize index, void *data) {
+    if (!vec || index >= atomic_load_explicit(&vec->len, memory_order_relaxed))
+        // Return `false` if the concurrent vector is `NULL` or the index is out
+        // of bounds
+        return false;
+    u32 bucket = cvec_bucket(index);
+    _Atomic(void *) *slots = cvec_ensure(vec, bucket);
+    if (!slots)
+        // Return `false` if unable to allocate the bucket
+        return false;
+    // Publish the element
+    atomic_store_explicit(
+        &slots[cvec_offset(index, bucket)], data, memory_order_release
+    );
+    return true;
+}
+
+/**
+ * Get the number of elements in the concurrent vector.
+ *
+ * @param vec  Pointer to the concurrent vector.
+ * @return     The number of elements in the concurrent vector.
+ */
+usize cvec_len(const struct cvec *vec) {
+    if (!vec)
+        // Return zero if the concurrent vector is `NULL`
+        return 0;
+    // Return the number of reserved elements
+    return atomic_load_explicit(&vec->len, memory_order_relaxed);
+}
+
+/**
+ * Get the capacity of the concurrent vector.
+ *
+ * @param vec  Pointer to the concurrent vector.
+ * @return     The number of elements that can be stored without allocating.
+ */
+usize cvec_capacity(const struct cvec *vec) {
+    if (!vec)
+        // Return zero if the concurrent vector is `NULL`
+        return 0;
+    // Sum the sizes of the leading allocated buckets
+    usize capacity = 0;
+    for (u32 i = 0; i < NBUCKETS; i++) {
+        if (!atomic_load_explicit(&vec->buckets[i], memory_order_acquire))
+            break;
+        capacity += BASE << i;
+    }
+    return capacity;
+}
+
+/**
+ * Reserve a given amount of capacity for the concurrent vector.
+ *
+ * @param vec       Pointer to the concurrent vector.
+ * @param capacity  Amount of capacity to reserve.
+ * @return          `true` if the operation was successful, `false` otherwise.
+ */
+bool cvec_reserve(struct cvec *vec, usize capacity) {
+    if (!vec)
+        // Return `false` if the concurrent vector is `NULL`
+        return false;
+    if (capacity == 0)
+        // Return `true` if there is nothing to reserve
+        return true;
+    // Allocate every bucket up to the given capacity
+    for (u32 b = 0; b <= cvec_bucket(capacity - 1); b++)
+        if (!cvec_ensure(vec, b))
+            return false;
+    return true;
+}
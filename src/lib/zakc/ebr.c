@@ -0,0 +1,577 @@
+// File:        ebr.c
+// Author:      Zakhary Kaplan <https://zakhary.dev>
+// Created:     17 Oct 2026
+// SPDX-License-Identifier: MIT
+
+#include "zakc/ebr.h"
+
+#include <stdatomic.h> // for atomic_*
+#include <stdint.h>    // for uintptr_t
+#include <stdlib.h>    // for bsearch, calloc, free, malloc, qsort, realloc
+
+#include "zakc/types.h" // for u64, usize
+
+// Number of retired objects after which to try advancing the epoch
+#define RETIRE_BATCH 64
+// Minimum number of retired objects between scans of the hazard pointers
+#define SCAN_BATCH 64
+// Number of cached per-thread records
+#define NCACHE 4
+
+// Retired object
+struct retired {
+    // Pointer to the object
+    void *ptr;
+    // Function to free the object with
+    void (*func)(void *ptr);
+};
+
+// Bag of retired objects
+struct bag {
+    // Array of retired objects
+    struct retired *items;
+    // Number of retired objects
+    usize len;
+    // Capacity of the array
+    usize capacity;
+};
+
+// Per-thread record, at the start of each domain's own record
+struct record {
+    // Identifier of the owning thread
+    u64 owner;
+    // Next record in the registry
+    struct record *next;
+};
+
+// Registry of per-thread records
+struct registry {
+    // Unique identifier of the registry
+    u64 id;
+    // List of records
+    _Atomic(struct record *) records;
+};
+
+// Per-thread epoch record
+struct erecord {
+    // Common record
+    struct record header;
+    // Epoch at which the thread is active, shifted left by one and with the
+    // low bit set, or 0 if the thread is inactive
+    atomic_uint_least64_t state;
+    // Depth of nested critical sections
+    usize depth;
+    // Retired objects for each of the last three epochs
+    struct bag limbo[3];
+    // Epoch of the objects in each limbo bag
+    u64 tags[3];
+    // Number of objects retired since the last attempt to advance the epoch
+    usize nretired;
+};
+
+// Epoch-based reclamation domain
+struct ebr {
+    // Registry of per-thread records
+    struct registry registry;
+    // Mode of the domain
+    enum ebr_mode mode;
+    // Global epoch
+    atomic_uint_least64_t epoch;
+};
+
+// Per-thread hazard pointer record
+struct hrecord {
+    // Common record
+    struct record header;
+    // Retired objects
+    struct bag retired;
+    // Number of retired objects at which to scan the hazard pointers
+    usize limit;
+    // Buffer for collecting the hazard pointers of every thread
+    const void **scratch;
+    // Capacity of the buffer
+    usize nscratch;
+    // Hazard pointer slots
+    _Atomic(const void *) slots[];
+};
+
+// Hazard pointer domain
+struct hazard {
+    // Registry of per-thread records
+    struct registry registry;
+    // Number of slots per thread
+    usize nslots;
+};
+
+// Source of unique registry and thread identifiers
+static atomic_uint_least64_t ids = 1;
+
+// Identifier of the current thread
+static _Thread_local u64 self;
+// Cache of the current thread's records
+static _Thread_local struct {
+    u64 id;
+    struct record *rec;
+} cache[NCACHE];
+
+/*
+ * Retired Objects
+ */
+
+// Add an object to a bag
+static bool bag_push(struct bag *bag, void *ptr, void (*func)(void *ptr)) {
+    if (bag->len == bag->capacity) {
+        // Grow the array
+        usize capacity = bag->capacity ? bag->capacity * 2 : RETIRE_BATCH;
+        struct retired *items =
+            realloc(bag->items, capacity * sizeof(struct retired));
+        if (!items)
+            return false;
+        bag->items = items;
+        bag->capacity = capacity;
+    }
+    bag->items[bag->len++] = (struct retired){.ptr = ptr, .func = func};
+    return true;
+}
+
+// Free every object in a bag, keeping its array for reuse
+static void bag_empty(struct bag *bag) {
+    for (usize i = 0; i < bag->len; i++)
+        bag->items[i].func(bag->items[i].ptr);
+    bag->len = 0;
+}
+
+/*
+ * Registry
+ */
+
+// Get the current thread's record, registering one of the given size if
+// necessary
+static struct record *registry_find(struct registry *registry, usize size) {
+    if (!self)
+        self = atomic_fetch_add(&ids, 1);
+    // Check the cache first
+    usize slot = registry->id % NCACHE;
+    if (cache[slot].id == registry->id)
+        return cache[slot].rec;
+    // Search the list of records for one owned by this thread
+    struct record *rec = atomic_load(&registry->records);
+    while (rec && rec->owner != self)
+        rec = rec->next;
+    if (!rec) {
+        // Register a new record
+        rec = calloc(1, size);
+        if (!rec)
+            return NULL;
+        rec->owner = self;
+        rec->next = atomic_load(&registry->records);
+        while (!atomic_compare_exchange_weak(
+            &registry->records, &rec->next, rec
+        ))
+            ;
+    }
+    cache[slot].id = registry->id;
+    cache[slot].rec = rec;
+    return rec;
+}
+
+// Initialize an empty registry
+static void registry_init(struct registry *registry) {
+    registry->id = atomic_fetch_add(&ids, 1);
+    atomic_init(&registry->records, NULL);
+}
+
+/*
+ * Epoch-Based Reclamation
+ */
+
+// Get the current thread's epoch record
+static inline struct erecord *ebr_record(struct ebr *ebr) {
+    return (struct erecord *)registry_find(
+        &ebr->registry, sizeof(struct erecord)
+    );
+}
+
+// Free every retired object which no thread can still be reading
+static void ebr_collect(struct ebr *ebr, struct erecord *rec) {
+    u64 epoch = atomic_load(&ebr->epoch);
+    for (usize i = 0; i < 3; i++)
+        if (rec->limbo[i].len && rec->tags[i] + 2 <= epoch)
+            bag_empty(&rec->limbo[i]);
+}
+
+// Advance the global epoch if every active thread has observed it
+static void ebr_advance(struct ebr *ebr) {
+    u64 epoch = atomic_load(&ebr->epoch);
+    for (struct record *rec = atomic_load(&ebr->registry.records); rec;
+         rec = rec->next) {
+        u64 state = atomic_load(&((struct erecord *)rec)->state);
+        if ((state & 1) && (state >> 1) != epoch)
+            // Return early if a thread is still active in an older epoch
+            return;
+    }
+    atomic_compare_exchange_strong(&ebr->epoch, &epoch, epoch + 1);
+}
+
+// Check if a record has any retired objects
+static bool ebr_pending(const struct erecord *rec) {
+    return rec->limbo[0].len || rec->limbo[1].len || rec->limbo[2].len;
+}
+
+/**
+ * Create a new epoch-based reclamation domain.
+ *
+ * @param mode  Mode of the domain.
+ * @return      Pointer to the newly-created domain, or `NULL` if memory
+ *              allocation failed.
+ */
+struct ebr *ebr_new(enum ebr_mode mode) {
+    // Allocate memory for the domain
+    struct ebr *ebr = malloc(sizeof(struct ebr));
+    if (!ebr)
+        // Return `NULL` if memory allocation failed
+        return NULL;
+    // Initialize the domain
+    *ebr = (struct ebr){
+        .mode = mode,
+    };
+    registry_init(&ebr->registry);
+    atomic_init(&ebr->epoch, 1);
+    // Return the newly-created domain
+    return ebr;
+}
+
+/**
+ * Delete the epoch-based reclamation domain, freeing every retired object.
+ *
+ * @param ebr  Pointer to the domain to delete.
+ */
+void ebr_drop(struct ebr *ebr) {
+    if (!ebr)
+        // Return early if the domain is `NULL`
+        return;
+    // Free every record, along with its retired objects
+    struct record *rec = atomic_load(&ebr->registry.records);
+    while (rec) {
+        struct record *next = rec->next;
+        struct erecord *erec = (struct erecord *)rec;
+        for (usize i = 0; i < 3; i++) {
+            bag_empty(&erec->limbo[i]);
+            free(erec->limbo[i].items);
+        }
+        free(rec);
+        rec = next;
+    }
+    // Free the domain
+    free(ebr);
+}
+
+/**
+ * Enter a critical section.
+ *
+ * @param ebr  Pointer to the domain.
+ * @return     `true` if the operation was successful, `false` if memory
+ *             allocation failed while registering the thread.
+ */
+bool ebr_enter(struct ebr *ebr) {
+    struct erecord *rec = ebr_record(ebr);
+    if (!rec)
+        // Return `false` if unable to register the thread
+        return false;
+    if (rec->depth++)
+        // Return early if already within a critical section
+        return true;
+    if (ebr->mode == EbrQsbr &&
+        atomic_load_explicit(&rec->state, memory_order_relaxed))
+        // Return early if the thread is already online
+        return true;
+    // Announce the current epoch, with a full barrier before any object is
+    // read
+    u64 epoch = atomic_load(&ebr->epoch);
+    atomic_exchange(&rec->state, epoch << 1 | 1);
+    if (ebr->mode == EbrEpoch)
+        ebr_collect(ebr, rec);
+    return true;
+}
+
+/**
+ * Exit a critical section.
+ *
+ * @param ebr  Pointer to the domain.
+ */
+void ebr_exit(struct ebr *ebr) {
+    struct erecord *rec = ebr_record(ebr);
+    if (!rec || !rec->depth)
+        // Return early if not within a critical section
+        return;
+    // Only epoch mode announces leaving the critical section
+    if (--rec->depth == 0 && ebr->mode == EbrEpoch)
+        atomic_store_explicit(&rec->state, 0, memory_order_release);
+}
+
+/**
+ * Announce that the calling thread holds no references to shared objects,
+ * then free any of its retired objects which are now safe to free.
+ *
+ * @param ebr  Pointer to the domain.
+ */
+void ebr_quiescent(struct ebr *ebr) {
+    struct erecord *rec = ebr_record(ebr);
+    if (!rec)
+        // Return early if unable to register the thread
+        return;
+    if (ebr->mode == EbrQsbr &&
+        atomic_load_explicit(&rec->state, memory_order_relaxed)) {
+        // Observe the current epoch, after every earlier read
+        u64 state = atomic_load(&ebr->epoch) << 1 | 1;
+        atomic_store_explicit(&rec->state, state, memory_order_release);
+    }
+    if (ebr_pending(rec)) {
+        // Try to reclaim the thread's retired objects
+        ebr_advance(ebr);
+        ebr_collect(ebr, rec);
+    }
+}
+
+/**
+ * Take the calling thread offline.
+ *
+ * @param ebr  Pointer to the domain.
+ */
+void ebr_offline(struct ebr *ebr) {
+    if (ebr->mode != EbrQsbr)
+        // Return early if threads are never online between critical sections
+        return;
+    struct erecord *rec = ebr_record(ebr);
+    if (rec)
+        atomic_store_explicit(&rec->state, 0, memory_order_release);
+}
+
+/**
+ * Retire an object which has been unlinked from a shared data structure.
+ *
+ * @param ebr   Pointer to the domain.
+ * @param ptr   Pointer to the object to retire.
+ * @param func  Function to free the object with.
+ * @return      `true` if the object was retired, `false` if memory
+ *              allocation failed.
+ */
+bool ebr_retire(struct ebr *ebr, void *ptr, void (*func)(void *ptr)) {
+    struct erecord *rec = ebr_record(ebr);
+    if (!rec)
+        // Return `false` if unable to register the thread
+        return false;
+    u64 epoch = atomic_load(&ebr->epoch);
+    usize i = epoch % 3;
+    if (rec->tags[i] != epoch) {
+        // Free the objects from three epochs ago which share the limbo bag
+        bag_empty(&rec->limbo[i]);
+        rec->tags[i] = epoch;
+    }
+    if (!bag_push(&rec->limbo[i], ptr, func))
+        // Return `false` if memory allocation failed
+        return false;
+    // Periodically try to advance the epoch and reclaim objects
+    if (++rec->nretired >= RETIRE_BATCH) {
+        rec->nretired = 0;
+        ebr_advance(ebr);
+        ebr_collect(ebr, rec);
+    }
+    return true;
+}
+
+/*
+ * Hazard Pointers
+ */
+
+// Get the current thread's hazard pointer record
+static inline struct hrecord *hazard_record(struct hazard *hazard) {
+    usize size =
+        sizeof(struct hrecord) + hazard->nslots * sizeof(_Atomic(void *));
+    return (struct hrecord *)registry_find(&hazard->registry, size);
+}
+
+// Compare two pointers by address
+static int ptr_cmp(const void *left, const void *right) {
+    uintptr_t l = (uintptr_t)*(const void *const *)left;
+    uintptr_t r = (uintptr_t)*(const void *const *)right;
+    return (l > r) - (l < r);
+}
+
+// Check if a pointer is in a sorted array of hazard pointers
+static bool hazard_find(const void **hazards, usize len, const void *ptr) {
+    return len && bsearch(&ptr, hazards, len, sizeof(const void *), ptr_cmp);
+}
+
+// Free every retired object which is not protected by any hazard pointer
+static void hazard_scan(struct hazard *hazard, struct hrecord *rec) {
+    // Order the unlinking of the retired objects before reading the slots
+    atomic_thread_fence(memory_order_seq_cst);
+
+    // Collect the hazard pointers of every thread
+    usize nhazards = 0;
+    for (struct record *it = atomic_load(&hazard->registry.records); it;
+         it = it->next) {
+        struct hrecord *other = (struct hrecord *)it;
+        for (usize i = 0; i < hazard->nslots; i++) {
+            const void *ptr = atomic_load(&other->slots[i]);
+            if (!ptr)
+                continue;
+            if (nhazards == rec->nscratch) {
+                // Grow the buffer, or try again on the next retirement
+                usize n = rec->nscratch ? rec->nscratch * 2 : hazard->nslots;
+                const void **scratch =
+                    realloc(rec->scratch, n * sizeof(const void *));
+                if (!scratch)
+                    return;
+                rec->scratch = scratch;
+                rec->nscratch = n;
+            }
+            rec->scratch[nhazards++] = ptr;
+        }
+    }
+    if (nhazards)
+        qsort(rec->scratch, nhazards, sizeof(const void *), ptr_cmp);
+
+    // Free the unprotected objects, keeping the rest
+    struct bag *bag = &rec->retired;
+    usize kept = 0;
+    for (usize i = 0; i < bag->len; i++) {
+        struct retired item = bag->items[i];
+        if (hazard_find(rec->scratch, nhazards, item.ptr))
+            bag->items[kept++] = item;
+        else
+            item.func(item.ptr);
+    }
+    bag->len = kept;
+    // Scan again once as many objects have been retired as could be
+    // protected, so that each scan frees at least half of them
+    rec->limit = kept + (nhazards > SCAN_BATCH ? nhazards : SCAN_BATCH);
+}
+
+/**
+ * Create a new hazard pointer domain.
+ *
+ * @param nslots  Number of hazard pointer slots per thread.
+ * @return        Pointer to the newly-created domain, or `NULL` if memory
+ *                allocation failed.
+ */
+struct hazard *hazard_new(usize nslots) {
+    // Allocate memory for the domain
+    struct hazard *hazard = malloc(sizeof(struct hazard));
+    if (!hazard)
+        // Return `NULL` if memory allocation failed
+        return NULL;
+    // Initialize the domain
+    *hazard = (struct hazard){
+        .nslots = nslots,
+    };
+    registry_init(&hazard->registry);
+    // Return the newly-created domain
+    return hazard;
+}
+
+/**
+ * Delete the hazard pointer domain, freeing every retired object.
+ *
+ * @param hazard  Pointer to the domain to delete.
+ */
+void hazard_drop(struct hazard *hazard) {
+    if (!hazard)
+        // Return early if the domain is `NULL`
+        return;
+    // Free every record, along with its retired objects
+    struct record *rec = atomic_load(&hazard->registry.records);
+    while (rec) {
+        struct record *next = rec->next;
+        struct hrecord *hrec = (struct hrecord *)rec;
+        bag_empty(&hrec->retired);
+        free(hrec->retired.items);
+        free(hrec->scratch);
+        free(rec);
+        rec = next;
+    }
+    // Free the domain
+    free(hazard);
+}
+
+/**
+ * Prepare the calling thread to protect objects.
+ *
+ * @param hazard  Pointer to the domain.
+ * @return        `true` if the operation was successful, `false` if memory
+ *                allocation failed while registering the thread.
+ */
+bool hazard_enter(struct hazard *hazard) {
+    return hazard_record(hazard) != NULL;
+}
+
+/**
+ * Clear every hazard pointer slot of the calling thread.
+ *
+ * @param hazard  Pointer to the domain.
+ */
+void hazard_exit(struct hazard *hazard) {
+    struct hrecord *rec = hazard_record(hazard);
+    if (!rec)
+        // Return early if unable to register the thread
+        return;
+    for (usize i = 0; i < hazard->nslots; i++)
+        atomic_store_explicit(&rec->slots[i], NULL, memory_order_release);
+}
+
+/**
+ * Load a pointer from a shared location and protect the object it points to.
+ *
+ * @param hazard  Pointer to the domain.
+ * @param slot    Index of the slot to protect the object with.
+ * @param src     Pointer to the shared location, an `_Atomic` pointer.
+ * @return        The protected pointer.
+ */
+void *hazard_protect(struct hazard *hazard, usize slot, const void *src) {
+    struct hrecord *rec = hazard_record(hazard);
+    _Atomic(void *) *loc = (_Atomic(void *) *)src;
+    void *ptr = atomic_load_explicit(loc, memory_order_acquire);
+    for (;;) {
+        // Publish the hazard pointer before checking it is still current
+        atomic_store(&rec->slots[slot], ptr);
+        void *again = atomic_load_explicit(loc, memory_order_acquire);
+        if (again == ptr)
+            return ptr;
+        ptr = again;
+    }
+}
+
+/**
+ * Protect an object with a hazard pointer slot.
+ *
+ * @param hazard  Pointer to the domain.
+ * @param slot    Index of the slot to protect the object with.
+ * @param ptr     Pointer to the object to protect, or `NULL` to clear the
+ *                slot.
+ */
+void hazard_set(struct hazard *hazard, usize slot, const void *ptr) {
+    struct hrecord *rec = hazard_record(hazard);
+    atomic_store(&rec->slots[slot], ptr);
+}
+
+/**
+ * Retire an object which has been unlinked from a shared data structure.
+ *
+ * @param hazard  Pointer to the domain.
+ * @param ptr     Pointer to the object to retire.
+ * @param func    Function to free the object with.
+ * @return        `true` if the object was retired, `false` if memory
+ *                allocation failed.
+ */
+bool hazard_retire(struct hazard *hazard, void *ptr, void (*func)(void *ptr)) {
+    struct hrecord *rec = hazard_record(hazard);
+    if (!rec || !bag_push(&rec->retired, ptr, func))
+        // Return `false` if memory allocation failed
+        return false;
+    // Scan the hazard pointers once enough objects have been retired
+    usize limit = rec->limit ? rec->limit : SCAN_BATCH;
+    if (rec->retired.len >= limit)
+        hazard_scan(hazard, rec);
+    return true;
+}
@@ -0,0 +1,392 @@
+// File:        gvec.c
+// Author:      Zakhary Kaplan <https://zakhary.dev>
+// Created:     17 Oct 2026
+// SPDX-License-Identifier: MIT
+
+#include "zakc/gvec.h"
+
+#include <stdlib.h> // for free, malloc, realloc
+#include <string.h> // for memmove
+
+#include "zakc/types.h"  // for usize
+#include "zakc/vector.h" // for slice
+
+// Gap vector structure
+struct gvec {
+    // Array of elements, with the gap in the middle
+    void **data;
+    // Capacity of the array
+    usize capacity;
+    // Index of the first slot of the gap, which is the number of elements
+    // before it
+    usize start;
+    // Index one past the last slot of the gap
+    usize end;
+    // Destructor for elements, or `NULL` if elements are not owned
+    void (*data_free)(void *data);
+};
+
+// Get the number of elements in the gap vector
+static inline usize gvec_count(const struct gvec *vec) {
+    return vec->capacity - (vec->end - vec->start);
+}
+
+// Get the slot holding the element at a given index
+static inline void **gvec_slot(const struct gvec *vec, usize index) {
+    usize gap = index < vec->start ? 0 : vec->end - vec->start;
+    return &vec->data[index + gap];
+}
+
+// Halve the capacity of the gap vector once it is less than a quarter full,
+// so that alternating inserts and removes never reallocate every time
+static inline void gvec_shrink(struct gvec *vec) {
+    if (gvec_count(vec) < vec->capacity / 4)
+        gvec_reserve(vec, vec->capacity / 2);
+}
+
+/**
+ * Create a new gap vector.
+ *
+ * @return  Pointer to the newly-created gap vector, or `NULL` if memory
+ *          allocation failed.
+ */
+struct gvec *gvec_new(void) {
+    // Allocate memory for the gap vector
+    struct gvec *vec = malloc(sizeof(struct gvec));
+    if (!vec)
+        // Return `NULL` if memory allocation failed
+        return NULL;
+
+    // Initialize the gap vector to be empty
+    *vec = (struct gvec){
+        .data = NULL,
+        .capacity = 0,
+        .start = 0,
+        .end = 0,
+        .data_free = NULL,
+    };
+
+    // Return the newly-created gap vector
+    return vec;
+}
+
+/**
+ * Set the destructor of the gap vector's elements.
+ *
+ * @param vec        Pointer to the gap vector.
+ * @param data_free  Destructor for elements, or `NULL` to not free elements.
+ */
+void gvec_set_free(struct gvec *vec, void (*data_free)(void *data)) {
+    if (!vec)
+        // Return early if the gap vector is `NULL`
+        return;
+    // Store the destructor
+    vec->data_free = data_free;
+}
+
+/**
+ * Delete the gap vector.
+ *
+ * @param vec  Pointer to the gap vector to delete.
+ */
+void gvec_drop(struct gvec *vec) {
+    if (!vec)
+        // Return early if the gap vector is `NULL`
+        return;
+    // Destroy the elements, then free the array and the gap vector
+    gvec_clear(vec);
+    free(vec->data);
+    free(vec);
+}
+
+/**
+ * Remove every element from the gap vector, keeping its capacity.
+ *
+ * @param vec  Pointer to the gap vector.
+ */
+void gvec_clear(struct gvec *vec) {
+    if (!vec)
+        // Return early if the gap vector is `NULL`
+        return;
+    if (vec->data_free) {
+        // Destroy the elements on either side of the gap
+        for (usize i = 0; i < vec->start; i++)
+            vec->data_free(vec->data[i]);
+        for (usize i = vec->end; i < vec->capacity; i++)
+            vec->data_free(vec->data[i]);
+    }
+    // Widen the gap to cover the whole array
+    vec->start = 0;
+    vec->end = vec->capacity;
+}
+
+/**
+ * Append an element to the end of the gap vector.
+ *
+ * @param vec   Pointer to the gap vector.
+ * @param data  Pointer to the element to append.
+ * @return      `true` if the operation was successful, `false` otherwise.
+ */
+bool gvec_append(struct gvec *vec, void *data) {
+    return vec && gvec_insert(vec, gvec_count(vec), data);
+}
+
+/**
+ * Remove the last element of the gap vector.
+ *
+ * @param vec  Pointer to the gap vector.
+ * @return     Pointer to the removed element, or `NULL` if the gap vector is
+ *             empty.
+ */
+void *gvec_pop(struct gvec *vec) {
+    if (!vec || gvec_count(vec) == 0)
+        // Return `NULL` if the gap vector is `NULL` or empty
+        return NULL;
+    return gvec_remove(vec, gvec_count(vec) - 1);
+}
+
+/**
+ * Insert an element into the gap vector.
+ *
+ * @param vec    Pointer to the gap vector.
+ * @param index  Index at which to insert the element.
+ * @param data   Pointer to the element to insert.
+ * @return       `true` if the operation was successful, `false` otherwise.
+ */
+bool gvec_insert(struct gvec *vec, usize index, void *data) {
+    if (!vec || index > gvec_count(vec))
+        // Return `false` if the gap vector is `NULL` or the index is out of
+        // bounds
+        return false;
+    if (vec->start == vec->end) {
+        // Reserve more capacity if the gap is closed
+        usize capacity = vec->capacity == 0 ? 1 : vec->capacity * 2;
+        if (!gvec_reserve(vec, capacity))
+            // Return `false` if unable to reserve more capacity
+            return false;
+    }
+    // Move the gap to the index, then fill its first slot
+    gvec_seek(vec, index);
+    vec->data[vec->start++] = data;
+    return true;
+}
+
+/**
+ * Remove an element from the gap vector.
+ *
+ * @param vec    Pointer to the gap vector.
+ * @param index  Index of the element to remove.
+ * @return       Pointer to the removed element, or `NULL` if the operation
+ *               was invalid.
+ */
+void *gvec_remove(struct gvec *vec, usize index) {
+    if (!vec || index >= gvec_count(vec))
+        // Return `NULL` if the gap vector is `NULL` or the index is out of
+        // bounds
+        return NULL;
+    void *removed;
+    if (index < vec->start) {
+        // Move the gap to just after the element, then take it from the end
+        // of the elements before the gap
+        gvec_seek(vec, index + 1);
+        removed = vec->data[--vec->start];
+    } else {
+        // Move the gap to just before the element, then take it from the
+        // start of the elements after the gap
+        gvec_seek(vec, index);
+        removed = vec->data[vec->end++];
+    }
+    // Shrink the array if it has become mostly empty
+    gvec_shrink(vec);
+    return removed;
+}
+
+/**
+ * Get an element from the gap vector.
+ *
+ * @param vec    Pointer to the gap vector.
+ * @param index  Index of the element to get.
+ * @return       Pointer to the element, or `NULL` if the index is out of
+ *               bounds.
+ */
+void *gvec_get(const struct gvec *vec, usize index) {
+    if (!vec || index >= gvec_count(vec))
+        // Return `NULL` if the gap vector is `NULL` or the index is out of
+        // bounds
+        return NULL;
+    // Return the element, skipping over the gap
+    return *gvec_slot(vec, index);
+}
+
+/**
+ * Set an element of the gap vector.
+ *
+ * @param vec    Pointer to the gap vector.
+ * @param index  Index of the element to set.
+ * @param data   Pointer to the element to set.
+ * @return       `true` if the operation was successful, `false` otherwise.
+ */
+bool gvec_set(struct gvec *vec, usize index, void *data) {
+    if (!vec || index >= gvec_count(vec))
+        // Return `false` if the gap vector is `NULL` or the index is out of
+        // bounds
+        return false;
+    void **slot = gvec_slot(vec, index);
+    // Destroy the element being replaced, unless it is being set again
+    if (vec->data_free && *slot != data)
+        vec->data_free(*slot);
+    *slot = data;
+    return true;
+}
+
+/**
+ * Get the number of elements in the gap vector.
+ *
+ * @param vec  Pointer to the gap vector.
+ * @return     The number of elements in the gap vector.
+ */
+usize gvec_len(const struct gvec *vec) {
+    if (!vec)
+        // Return zero if the gap vector is `NULL`
+        return 0;
+    // Return the number of elements on either side of the gap
+    return gvec_count(vec);
+}
+
+/**
+ * Get the capacity of the gap vector.
+ *
+ * @param vec  Pointer to the gap vector.
+ * @return     The number of elements the gap vector can hold without
+ *             reallocating.
+ */
+usize gvec_capacity(const struct gvec *vec) {
+    if (!vec)
+        // Return zero if the gap vector is `NULL`
+        return 0;
+    // Return the capacity of the gap vector
+    return vec->capacity;
+}
+
+/**
+ * Get the position of the gap, which is the index of the first element after
+ * it.
+ *
+ * @param vec  Pointer to the gap vector.
+ * @return     The position of the gap.
+ */
+usize gvec_gap(const struct gvec *vec) {
+    if (!vec)
+        // Return zero if the gap vector is `NULL`
+        return 0;
+    // Return the number of elements before the gap
+    return vec->start;
+}
+
+/**
+ * Move the gap to the given index.
+ *
+ * @param vec    Pointer to the gap vector.
+ * @param index  Index to move the gap to.
+ * @return       `true` if the operation was successful, `false` if the index
+ *               is out of bounds.
+ */
+bool gvec_seek(struct gvec *vec, usize index) {
+    if (!vec || index > gvec_count(vec))
+        // Return `false` if the gap vector is `NULL` or the index is out of
+        // bounds
+        return false;
+    if (index < vec->start) {
+        // Move the elements between the index and the gap to after the gap
+        usize n = vec->start - index;
+        memmove(
+            &vec->data[vec->end - n], &vec->data[index], n * sizeof(void *)
+        );
+        vec->start -= n;
+        vec->end -= n;
+    } else if (index > vec->start) {
+        // Move the elements between the gap and the index to before the gap
+        usize n = index - vec->start;
+        memmove(
+            &vec->data[vec->start], &vec->data[vec->end], n * sizeof(void *)
+        );
+        vec->start += n;
+        vec->end += n;
+    }
+    return true;
+}
+
+/**
+ * Reserve a given amount of capacity for the gap vector.
+ *
+ * @param vec       Pointer to the gap vector.
+ * @param capacity  Amount of capacity to reserve.
+ * @return          `true` if the operation was successful, `false` otherwise.
+ */
+bool gvec_reserve(struct gvec *vec, usize capacity) {
+    if (!vec || capacity < gvec_count(vec))
+        // Return `false` if the gap vector is `NULL` or the new capacity is
+        // smaller than the current size
+        return false;
+    if (capacity == vec->capacity)
+        // Return `true` if the new capacity is the same as the current capacity
+        return true;
+    if (capacity == 0) {
+        // Free the array of an empty gap vector
+        free(vec->data);
+        *vec = (struct gvec){.data_free = vec->data_free};
+        return true;
+    }
+
+    // Resize the gap, keeping the elements after it at the end of the array
+    usize tail = vec->capacity - vec->end;
+    if (capacity < vec->capacity)
+        // Move the elements after the gap down before the array shrinks
+        memmove(
+            &vec->data[capacity - tail],
+            &vec->data[vec->end],
+            tail * sizeof(void *)
+        );
+    void **data = realloc(vec->data, capacity * sizeof(void *));
+    if (!data) {
+        if (capacity < vec->capacity)
+            // Move the elements after the gap back if the array is unchanged
+            memmove(
+                &vec->data[vec->end],
+                &vec->data[capacity - tail],
+                tail * sizeof(void *)
+            );
+        // Return `false` if memory allocation failed
+        return false;
+    }
+    if (capacity > vec->capacity)
+        // Move the elements after the gap up once the array has grown
+        memmove(
+            &data[capacity - tail], &data[vec->end], tail * sizeof(void *)
+        );
+
+    // Update the gap vector with the new capacity and array of elements
+    vec->data = data;
+    vec->end = capacity - tail;
+    vec->capacity = capacity;
+    return true;
+}
+
+/**
+ * Get a contiguous slice of every element of the gap vector.
+ *
+ * @param vec  Pointer to the gap vector.
+ * @return     Slice of every element, or an empty slice if the gap vector is
+ *             `NULL`.
+ */
+struct slice gvec_as_slice(struct gvec *vec) {
+    if (!vec)
+        // Return an empty slice if the gap vector is `NULL`
+        return (struct slice){0};
+    // Move the gap past the last element, leaving the elements in order
+    gvec_seek(vec, gvec_count(vec));
+    return (struct slice){
+        .data = vec->data,
+        .len = vec->start,
+    };
+}
@@ -0,0 +1,854 @@
+// File:        hamt.c
+// Author:      Zakhary Kaplan <https://zakhary.dev>
+// Created:     17 Oct 2026
+// SPDX-License-Identifier: MIT
+
+#include "zakc/hamt.h"
+
+#include <stdatomic.h> // for atomic_*
+#include <stdlib.h>    // for free, malloc
+#include <string.h>    // for memcpy
+
+#include "zakc/types.h" // for u{32,64}, usize
+
+// Number of hash bits consumed by each level of the trie
+#define BITS 5
+#define MASK ((1 << BITS) - 1)
+// Shift at which the hash is exhausted and collision nodes are used
+#define HASH_BITS 64
+
+// Persistent hash map structure
+struct hamt {
+    // Hash function for keys
+    u64 (*hash)(const void *key);
+    // Comparison function for keys
+    bool (*cmp)(const void *left, const void *right);
+    // Root of the trie, or `NULL` if empty
+    struct hnode *root;
+    // Number of items in the map
+    usize nitems;
+    // Whether the version may be updated in place
+    bool transient;
+};
+
+// Item structure
+struct hentry {
+    // Key of the item
+    const void *key;
+    // Data of the item
+    void *data;
+    // Hash of the key
+    u64 hash;
+};
+
+// Slot of a trie node
+union hslot {
+    // Item stored inline in the node
+    struct hentry entry;
+    // Child node
+    struct hnode *node;
+};
+
+// Trie node structure
+//
+// Items are stored before child nodes, each in order of their bit in the
+// bitmap. Collision nodes (beyond the last level) only store items.
+struct hnode {
+    // Number of parents and versions referencing the node
+    atomic_size_t refs;
+    // Bitmap of items stored inline
+    u32 datamap;
+    // Bitmap of child nodes
+    u32 nodemap;
+    // Number of slots in the node
+    u32 size;
+    // Items followed by child nodes
+    union hslot slots[];
+};
+
+// Get the bit of a hash at the given shift
+static inline u32 hamt_bit(u64 hash, u32 shift) {
+    return (u32)1 << ((hash >> shift) & MASK);
+}
+
+// Get the slot index of an item in a node
+static inline u32 hnode_dindex(const struct hnode *node, u32 bit) {
+    return __builtin_popcount(node->datamap & (bit - 1));
+}
+
+// Get the slot index of a child node in a node
+static inline u32 hnode_nindex(const struct hnode *node, u32 bit) {
+    return node->size - __builtin_popcount(node->nodemap & ~(bit - 1));
+}
+
+// Copy slots between nodes
+static inline void hslot_copy(union hslot *dst, const union hslot *src, u32 n) {
+    memcpy(dst, src, n * sizeof(union hslot));
+}
+
+// Get the number of child nodes in a node
+static inline u32 hnode_nchild(const struct hnode *node) {
+    return __builtin_popcount(node->nodemap);
+}
+
+// Allocate a new node with the given layout
+static struct hnode *hnode_new(u32 datamap, u32 nodemap, u32 size) {
+    usize bytes = sizeof(struct hnode) + size * sizeof(union hslot);
+    struct hnode *node = malloc(bytes);
+    if (!node)
+        return NULL;
+    atomic_init(&node->refs, 1);
+    node->datamap = datamap;
+    node->nodemap = nodemap;
+    node->size = size;
+    return node;
+}
+
+// Add a reference to each child of a node
+static void hnode_retain_children(struct hnode *node) {
+    for (u32 i = node->size - hnode_nchild(node); i < node->size; i++) {
+        struct hnode *child = node->slots[i].node;
+        atomic_fetch_add_explicit(&child->refs, 1, memory_order_relaxed);
+    }
+}
+
+// Remove a reference to a node, freeing it if unused
+static void hnode_release(struct hnode *node) {
+    if (!node)
+        return;
+    if (atomic_fetch_sub_explicit(&node->refs, 1, memory_order_acq_rel) != 1)
+        // Return early if the node is still referenced
+        return;
+    for (u32 i = node->size - hnode_nchild(node); i < node->size; i++)
+        hnode_release(node->slots[i].node);
+    free(node);
+}
+
+// Ensure the node in a slot is referenced only once, copying it if shared
+static struct hnode *hnode_own(struct hnode **slot) {
+    struct hnode *node = *slot;
+    if (atomic_load_explicit(&node->refs, memory_order_acquire) == 1)
+        // Return the node if it is already unique
+        return node;
+    // Copy the shared node
+    struct hnode *copy = hnode_new(node->datamap, node->nodemap, node->size);
+    if (!copy)
+        return NULL;
+    hslot_copy(copy->slots, node->slots, node->size);
+    hnode_retain_children(copy);
+    // Replace the shared node with its copy
+    hnode_release(node);
+    *slot = copy;
+    return copy;
+}
+
+// Replace the node in a slot with a new layout, keeping its children
+static void hnode_replace(struct hnode **slot, struct hnode *node) {
+    hnode_retain_children(node);
+    hnode_release(*slot);
+    *slot = node;
+}
+
+// Create a node holding two items with distinct keys
+static struct hnode *hnode_merge(struct hentry a, struct hentry b, u32 shift) {
+    if (shift >= HASH_BITS) {
+        // Store both items in a collision node
+        struct hnode *node = hnode_new(0, 0, 2);
+        if (node) {
+            node->slots[0].entry = a;
+            node->slots[1].entry = b;
+        }
+        return node;
+    }
+    u32 abit = hamt_bit(a.hash, shift);
+    u32 bbit = hamt_bit(b.hash, shift);
+    if (abit == bbit) {
+        // Push both items down a level
+        struct hnode *child = hnode_merge(a, b, shift + BITS);
+        if (!child)
+            return NULL;
+        struct hnode *node = hnode_new(0, abit, 1);
+        if (!node) {
+            hnode_release(child);
+            return NULL;
+        }
+        node->slots[0].node = child;
+        return node;
+    }
+    // Store both items inline, in order of their bits
+    struct hnode *node = hnode_new(abit | bbit, 0, 2);
+    if (node) {
+        node->slots[abit < bbit ? 0 : 1].entry = a;
+        node->slots[abit < bbit ? 1 : 0].entry = b;
+    }
+    return node;
+}
+
+// Find an item in the trie
+static const struct hentry *hamt_find(
+    const struct hamt *map, const void *key
+) {
+    if (!map || !map->root)
+        return NULL;
+    u64 hash = map->hash(key);
+    const struct hnode *node = map->root;
+    for (u32 shift = 0;; shift += BITS) {
+        if (shift >= HASH_BITS) {
+            // Search the collision node
+            for (u32 i = 0; i < node->size; i++)
+                if (map->cmp(node->slots[i].entry.key, key))
+                    return &node->slots[i].entry;
+            return NULL;
+        }
+        u32 bit = hamt_bit(hash, shift);
+        if (node->datamap & bit) {
+            // Check the inline item
+            const struct hentry *entry =
+                &node->slots[hnode_dindex(node, bit)].entry;
+            if (entry->hash != hash || !map->cmp(entry->key, key))
+                return NULL;
+            return entry;
+        }
+        if (!(node->nodemap & bit))
+            return NULL;
+        // Descend into the child node
+        node = node->slots[hnode_nindex(node, bit)].node;
+    }
+}
+
+// Insert an item into the node in a slot at the given shift
+static bool hnode_insert(
+    const struct hamt *map,
+    struct hnode **slot,
+    u32 shift,
+    struct hentry entry,
+    bool *added
+) {
+    struct hnode *node = *slot, *next;
+    if (shift >= HASH_BITS) {
+        // Replace the item in the collision node if the key is present
+        for (u32 i = 0; i < node->size; i++) {
+            if (map->cmp(node->slots[i].entry.key, entry.key)) {
+                if (!(node = hnode_own(slot)))
+                    return false;
+                node->slots[i].entry.data = entry.data;
+                return true;
+            }
+        }
+        // Add the item to the collision node
+        if (!(next = hnode_new(0, 0, node->size + 1)))
+            return false;
+        hslot_copy(next->slots, node->slots, node->size);
+        next->slots[node->size].entry = entry;
+        hnode_replace(slot, next);
+        *added = true;
+        return true;
+    }
+
+    u32 bit = hamt_bit(entry.hash, shift);
+    if (node->datamap & bit) {
+        u32 idx = hnode_dindex(node, bit);
+        struct hentry other = node->slots[idx].entry;
+        if (other.hash == entry.hash && map->cmp(other.key, entry.key)) {
+            // Replace the data of the existing item
+            if (!(node = hnode_own(slot)))
+                return false;
+            node->slots[idx].entry.data = entry.data;
+            return true;
+        }
+        // Move both items into a new child node
+        struct hnode *child = hnode_merge(other, entry, shift + BITS);
+        if (!child)
+            return false;
+        next = hnode_new(node->datamap & ~bit, node->nodemap | bit, node->size);
+        if (!next) {
+            hnode_release(child);
+            return false;
+        }
+        u32 nidx = hnode_nindex(next, bit);
+        hslot_copy(next->slots, node->slots, idx);
+        hslot_copy(next->slots + idx, node->slots + idx + 1, nidx - idx);
+        u32 rest = node->size - nidx - 1;
+        hslot_copy(next->slots + nidx + 1, node->slots + nidx + 1, rest);
+        next->slots[nidx].node = child;
+        hnode_replace(slot, next);
+        // Drop the extra reference taken on the new child
+        atomic_store_explicit(&child->refs, 1, memory_order_relaxed);
+        *added = true;
+        return true;
+    }
+
+    if (node->nodemap & bit) {
+        // Insert the item into the child node
+        if (!(node = hnode_own(slot)))
+            return false;
+        struct hnode **child = &node->slots[hnode_nindex(node, bit)].node;
+        return hnode_insert(map, child, shift + BITS, entry, added);
+    }
+
+    // Add the item inline
+    u32 idx = hnode_dindex(node, bit);
+    if (!(next = hnode_new(node->datamap | bit, node->nodemap, node->size + 1)))
+        return false;
+    hslot_copy(next->slots, node->slots, idx);
+    next->slots[idx].entry = entry;
+    hslot_copy(next->slots + idx + 1, node->slots + idx, node->size - idx);
+    hnode_replace(slot, next);
+    *added = true;
+    return true;
+}
+
+// Remove an item from the node in a slot at the given shift
+static bool hnode_remove(
+    const struct hamt *map,
+    struct hnode **slot,
+    u32 shift,
+    u64 hash,
+    const void *key,
+    void **data
+) {
+    struct hnode *node = *slot, *next;
+    if (shift >= HASH_BITS) {
+        // Remove the item from the collision node
+        for (u32 i = 0; i < node->size; i++) {
+            if (map->cmp(node->slots[i].entry.key, key)) {
+                if (!(next = hnode_new(0, 0, node->size - 1)))
+                    return false;
+                *data = node->slots[i].entry.data;
+                hslot_copy(next->slots, node->slots, i);
+                hslot_copy(
+                    next->slots + i, node->slots + i + 1, node->size - i - 1
+                );
+                hnode_replace(slot, next);
+                return true;
+            }
+        }
+        return true;
+    }
+
+    u32 bit = hamt_bit(hash, shift);
+    if (node->datamap & bit) {
+        // Remove the inline item
+        u32 idx = hnode_dindex(node, bit);
+        *data = node->slots[idx].entry.data;
+        if (node->size == 1) {
+            hnode_release(node);
+            *slot = NULL;
+            return true;
+        }
+        next = hnode_new(node->datamap & ~bit, node->nodemap, node->size - 1);
+        if (!next)
+            return false;
+        hslot_copy(next->slots, node->slots, idx);
+        hslot_copy(
+            next->slots + idx, node->slots + idx + 1, node->size - idx - 1
+        );
+        hnode_replace(slot, next);
+        return true;
+    }
+
+    if (!(node->nodemap & bit))
+        // Return early if the key is not present
+        return true;
+
+    // Remove the item from the child node
+    if (!(node = hnode_own(slot)))
+        return false;
+    u32 nidx = hnode_nindex(node, bit);
+    struct hnode **link = &node->slots[nidx].node;
+    if (!hnode_remove(map, link, shift + BITS, hash, key, data))
+        return false;
+    struct hnode *child = *link;
+    if (child->size != 1 || child->nodemap)
+        return true;
+
+    // Move the last item of the child node inline
+    struct hentry entry = child->slots[0].entry;
+    next = hnode_new(node->datamap | bit, node->nodemap & ~bit, node->size);
+    if (!next)
+        // Leave the child node in place if unable to allocate
+        return true;
+    u32 idx = hnode_dindex(next, bit);
+    hslot_copy(next->slots, node->slots, idx);
+    next->slots[idx].entry = entry;
+    hslot_copy(next->slots + idx + 1, node->slots + idx, nidx - idx);
+    u32 rest = node->size - nidx - 1;
+    hslot_copy(next->slots + nidx + 1, node->slots + nidx + 1, rest);
+    hnode_replace(slot, next);
+    return true;
+}
+
+// Iterate over the items in a subtree
+static void hnode_iter(
+    const struct hnode *node,
+    void (*callback)(const void *key, void *data, void *context),
+    void *context
+) {
+    u32 nchild = hnode_nchild(node);
+    for (u32 i = 0; i < node->size - nchild; i++)
+        callback(node->slots[i].entry.key, node->slots[i].entry.data, context);
+    for (u32 i = node->size - nchild; i < node->size; i++)
+        hnode_iter(node->slots[i].node, callback, context);
+}
+
+// Diff state
+struct hdiff {
+    // Comparison function for keys
+    bool (*cmp)(const void *left, const void *right);
+    // Callback function to call for each difference
+    void (*callback)(
+        enum hamt_change change,
+        const void *key,
+        void *prev,
+        void *next,
+        void *context
+    );
+    // User-defined context to pass to the callback function
+    void *context;
+    // Item compared against a subtree
+    const struct hentry *entry;
+    // Whether the item is from the newer version
+    bool flip;
+    // Whether the item was found in the subtree
+    bool found;
+};
+
+// Report an item as added
+static void hdiff_added(struct hdiff *diff, const struct hentry *entry) {
+    diff->callback(HamtAdded, entry->key, NULL, entry->data, diff->context);
+}
+
+// Report an item as removed
+static void hdiff_removed(struct hdiff *diff, const struct hentry *entry) {
+    diff->callback(HamtRemoved, entry->key, entry->data, NULL, diff->context);
+}
+
+// Report a whole subtree as added or removed
+static void hdiff_all(
+    struct hdiff *diff, const struct hnode *node, enum hamt_change change
+) {
+    u32 nchild = hnode_nchild(node);
+    for (u32 i = 0; i < node->size - nchild; i++) {
+        if (change == HamtAdded)
+            hdiff_added(diff, &node->slots[i].entry);
+        else
+            hdiff_removed(diff, &node->slots[i].entry);
+    }
+    for (u32 i = node->size - nchild; i < node->size; i++)
+        hdiff_all(diff, node->slots[i].node, change);
+}
+
+// Compare two items at the same position
+static void hdiff_entries(
+    struct hdiff *diff, const struct hentry *prev, const struct hentry *next
+) {
+    if (prev->hash == next->hash && diff->cmp(prev->key, next->key)) {
+        if (prev->data != next->data)
+            diff->callback(
+                HamtChanged, next->key, prev->data, next->data, diff->context
+            );
+        return;
+    }
+    hdiff_removed(diff, prev);
+    hdiff_added(diff, next);
+}
+
+// Compare a single item against each item of a subtree
+static void hdiff_against(struct hdiff *diff, const struct hnode *node) {
+    u32 nchild = hnode_nchild(node);
+    for (u32 i = 0; i < node->size - nchild; i++) {
+        const struct hentry *e = &node->slots[i].entry;
+        if (!diff->found && e->hash == diff->entry->hash &&
+            diff->cmp(e->key, diff->entry->key)) {
+            // Compare the matching item
+            diff->found = true;
+            if (diff->flip)
+                hdiff_entries(diff, e, diff->entry);
+            else
+                hdiff_entries(diff, diff->entry, e);
+        } else if (diff->flip) {
+            hdiff_removed(diff, e);
+        } else {
+            hdiff_added(diff, e);
+        }
+    }
+    for (u32 i = node->size - nchild; i < node->size; i++)
+        hdiff_against(diff, node->slots[i].node);
+}
+
+// Compare an item with a subtree at the same position
+static void hdiff_entry_node(
+    struct hdiff *diff,
+    const struct hentry *entry,
+    const struct hnode *node,
+    bool flip
+) {
+    diff->entry = entry;
+    diff->flip = flip;
+    diff->found = false;
+    hdiff_against(diff, node);
+    if (!diff->found) {
+        // Report the unmatched item
+        if (flip)
+            hdiff_added(diff, entry);
+        else
+            hdiff_removed(diff, entry);
+    }
+}
+
+// Compare two subtrees at the same shift
+static void hdiff_nodes(
+    struct hdiff *diff,
+    const struct hnode *prev,
+    const struct hnode *next,
+    u32 shift
+) {
+    if (prev == next)
+        // Skip shared subtrees
+        return;
+    if (shift >= HASH_BITS) {
+        // Compare collision nodes item by item
+        for (u32 i = 0; i < prev->size; i++) {
+            const struct hentry *pe = &prev->slots[i].entry, *ne = NULL;
+            for (u32 j = 0; j < next->size && !ne; j++)
+                if (diff->cmp(pe->key, next->slots[j].entry.key))
+                    ne = &next->slots[j].entry;
+            if (ne)
+                hdiff_entries(diff, pe, ne);
+            else
+                hdiff_removed(diff, pe);
+        }
+        for (u32 j = 0; j < next->size; j++) {
+            const struct hentry *ne = &next->slots[j].entry;
+            bool found = false;
+            for (u32 i = 0; i < prev->size && !found; i++)
+                found = diff->cmp(prev->slots[i].entry.key, ne->key);
+            if (!found)
+                hdiff_added(diff, ne);
+        }
+        return;
+    }
+    for (u32 b = 0; b <= MASK; b++) {
+        u32 bit = (u32)1 << b;
+        const struct hentry *pe = NULL, *ne = NULL;
+        const struct hnode *pn = NULL, *nn = NULL;
+        if (prev->datamap & bit)
+            pe = &prev->slots[hnode_dindex(prev, bit)].entry;
+        else if (prev->nodemap & bit)
+            pn = prev->slots[hnode_nindex(prev, bit)].node;
+        if (next->datamap & bit)
+            ne = &next->slots[hnode_dindex(next, bit)].entry;
+        else if (next->nodemap & bit)
+            nn = next->slots[hnode_nindex(next, bit)].node;
+
+        if (pe && ne)
+            hdiff_entries(diff, pe, ne);
+        else if (pn && nn)
+            hdiff_nodes(diff, pn, nn, shift + BITS);
+        else if (pe && nn)
+            hdiff_entry_node(diff, pe, nn, false);
+        else if (pn && ne)
+            hdiff_entry_node(diff, ne, pn, true);
+        else if (pe)
+            hdiff_removed(diff, pe);
+        else if (ne)
+            hdiff_added(diff, ne);
+        else if (pn)
+            hdiff_all(diff, pn, HamtRemoved);
+        else if (nn)
+            hdiff_all(diff, nn, HamtAdded);
+    }
+}
+
+// Insert an item into a version in place
+static bool hamt_do_insert(struct hamt *map, const void *key, void *data) {
+    struct hentry entry = {
+        .key = key,
+        .data = data,
+        .hash = map->hash(key),
+    };
+    if (!map->root) {
+        // Create the root to hold the first item
+        map->root = hnode_new(hamt_bit(entry.hash, 0), 0, 1);
+        if (!map->root)
+            return false;
+        map->root->slots[0].entry = entry;
+        map->nitems++;
+        return true;
+    }
+    bool added = false;
+    if (!hnode_insert(map, &map->root, 0, entry, &added))
+        return false;
+    map->nitems += added;
+    return true;
+}
+
+// Remove an item from a version in place, storing its data, or `NULL` if the
+// key is not present
+static bool hamt_do_remove(struct hamt *map, const void *key, void **data) {
+    *data = NULL;
+    if (!hamt_find(map, key))
+        // Return early if the key is not present
+        return true;
+    if (!hnode_remove(map, &map->root, 0, map->hash(key), key, data))
+        // Return `false` if unable to copy the path to the item
+        return false;
+    map->nitems--;
+    return true;
+}
+
+/**
+ * Create a new persistent hash map.
+ *
+ * @param hash  Hash function for keys.
+ * @param cmp   Comparison function for keys.
+ * @return      Pointer to the newly-created persistent hash map, or `NULL` if
+ *              memory allocation failed.
+ */
+struct hamt *hamt_new(
+    u64 (*hash)(const void *key),
+    bool (*cmp)(const void *left, const void *right)
+) {
+    // Allocate memory for the persistent hash map
+    struct hamt *map = malloc(sizeof(struct hamt));
+    if (!map)
+        // Return `NULL` if memory allocation failed
+        return NULL;
+
+    // Initialize the persistent hash map to be empty
+    *map = (struct hamt){
+        .hash = hash,
+        .cmp = cmp,
+        .root = NULL,
+        .nitems = 0,
+        .transient = false,
+    };
+
+    // Return the newly-created persistent hash map
+    return map;
+}
+
+/**
+ * Delete a version of the persistent hash map.
+ *
+ * @param map  Pointer to the version to delete.
+ */
+void hamt_drop(struct hamt *map) {
+    if (!map)
+        // Return early if the persistent hash map is `NULL`
+        return;
+    // Release the structure referenced by this version
+    hnode_release(map->root);
+    free(map);
+}
+
+/**
+ * Take a snapshot of the persistent hash map.
+ *
+ * @param map  Pointer to the persistent hash map.
+ * @return     Pointer to the snapshot, or `NULL` if memory allocation failed.
+ */
+struct hamt *hamt_snapshot(const struct hamt *map) {
+    if (!map)
+        // Return `NULL` if the persistent hash map is `NULL`
+        return NULL;
+    // Allocate memory for the snapshot
+    struct hamt *snap = malloc(sizeof(struct hamt));
+    if (!snap)
+        return NULL;
+    // Share the structure of the persistent hash map
+    *snap = *map;
+    snap->transient = false;
+    if (snap->root)
+        atomic_fetch_add_explicit(&snap->root->refs, 1, memory_order_relaxed);
+    return snap;
+}
+
+/**
+ * Create a new version with an item inserted.
+ *
+ * @param map   Pointer to the persistent hash map.
+ * @param key   Key of the item to insert.
+ * @param data  Data of the item to insert.
+ * @return      Pointer to the new version, or `NULL` if the operation failed.
+ */
+struct hamt *hamt_insert(const struct hamt *map, const void *key, void *data) {
+    struct hamt *next = hamt_snapshot(map);
+    if (next && !hamt_do_insert(next, key, data)) {
+        // Clean up if the operation failed
+        hamt_drop(next);
+        return NULL;
+    }
+    return next;
+}
+
+/**
+ * Create a new version with the item with the given key removed.
+ *
+ * @param map  Pointer to the persistent hash map.
+ * @param key  Key of the item to remove.
+ * @return     Pointer to the new version, or `NULL` if the operation failed.
+ */
+struct hamt *hamt_remove(const struct hamt *map, const void *key) {
+    struct hamt *next = hamt_snapshot(map);
+    void *data;
+    if (next && !hamt_do_remove(next, key, &data)) {
+        // Clean up if the operation failed
+        hamt_drop(next);
+        return NULL;
+    }
+    return next;
+}
+
+/**
+ * Check if a key is in the persistent hash map.
+ *
+ * @param map  The persistent hash map to search.
+ * @param key  The key to search for.
+ * @return     `true` if the key exists in the map, `false` otherwise.
+ */
+bool hamt_contains(const struct hamt *map, const void *key) {
+    return hamt_find(map, key) != NULL;
+}
+
+/**
+ * Get the value associated with a key in the persistent hash map.
+ *
+ * @param map  Pointer to the persistent hash map.
+ * @param key  Key to look up.
+ * @return     Pointer to the value associated with the key, or `NULL` if the
+ *             item was not found.
+ */
+void *hamt_get(const struct hamt *map, const void *key) {
+    const struct hentry *entry = hamt_find(map, key);
+    return entry ? entry->data : NULL;
+}
+
+/**
+ * Get the number of items in the persistent hash map.
+ *
+ * @param map  Pointer to the persistent hash map.
+ * @return     Number of items in the persistent hash map, or 0 if the map is
+ *             `NULL`.
+ */
+usize hamt_len(const struct hamt *map) {
+    if (!map)
+        // Return 0 if the persistent hash map is `NULL`
+        return 0;
+    // Return the number of items in the persistent hash map
+    return map->nitems;
+}
+
+/**
+ * Iterate over the items in the persistent hash map.
+ *
+ * @param map       Pointer to the persistent hash map.
+ * @param callback  Callback function to call for each item.
+ * @param context   User-defined context to pass to the callback function.
+ */
+void hamt_iter(
+    const struct hamt *map,
+    void (*callback)(const void *key, void *data, void *context),
+    void *context
+) {
+    if (!map || !map->root || !callback)
+        // Return early if the persistent hash map or callback is `NULL`
+        return;
+    hnode_iter(map->root, callback, context);
+}
+
+/**
+ * Iterate over the differences between two versions.
+ *
+ * @param prev      Pointer to the older version.
+ * @param next      Pointer to the newer version.
+ * @param callback  Callback function to call for each difference.
+ * @param context   User-defined context to pass to the callback function.
+ */
+void hamt_diff(
+    const struct hamt *prev,
+    const struct hamt *next,
+    void (*callback)(
+        enum hamt_change change,
+        const void *key,
+        void *prev,
+        void *next,
+        void *context
+    ),
+    void *context
+) {
+    if (!prev || !next || !callback)
+        // Return early if either version or the callback is `NULL`
+        return;
+    struct hdiff diff = {
+        .cmp = next->cmp,
+        .callback = callback,
+        .context = context,
+    };
+    if (prev->root && next->root)
+        hdiff_nodes(&diff, prev->root, next->root, 0);
+    else if (prev->root)
+        hdiff_all(&diff, prev->root, HamtRemoved);
+    else if (next->root)
+        hdiff_all(&diff, next->root, HamtAdded);
+}
+
+/**
+ * Create a transient (mutable) version of the persistent hash map.
+ *
+ * @param map  Pointer to the persistent hash map.
+ * @return     Pointer to the transient version, or `NULL` if memory
+ *             allocation failed.
+ */
+struct hamt *hamt_transient(const struct hamt *map) {
+    struct hamt *tmap = hamt_snapshot(map);
+    if (tmap)
+        tmap->transient = true;
+    return tmap;
+}
+
+/**
+ * Freeze a transient version, making it persistent.
+ *
+ * @param map  Pointer to the transient version.
+ * @return     Pointer to the now-persistent version.
+ */
+struct hamt *hamt_persistent(struct hamt *map) {
+    if (map)
+        map->transient = false;
+    return map;
+}
+
+/**
+ * Insert an item into a transient version.
+ *
+ * @param map   Pointer to the transient version.
+ * @param key   Key of the item to insert.
+ * @param data  Data of the item to insert.
+ * @return      `true` if the operation was successful, `false` otherwise.
+ */
+bool hamt_transient_insert(struct hamt *map, const void *key, void *data) {
+    if (!map || !map->transient)
+        // Return `false` if the version is `NULL` or not transient
+        return false;
+    return hamt_do_insert(map, key, data);
+}
+
+/**
+ * Remove an item with the given key from a transient version.
+ *
+ * @param map  Pointer to the transient version.
+ * @param key  Key of the item to remove.
+ * @return     Pointer to the removed data, or `NULL` if the operation was
+ *             invalid.
+ */
+void *hamt_transient_remove(struct hamt *map, const void *key) {
+    if (!map || !map->transient)
+        // Return `NULL` if the version is `NULL` or not transient
+        return NULL;
+    void *data;
+    if (!hamt_do_remove(map, key, &data))
+        // Return `NULL` if unable to copy the path to the item
+        return NULL;
+    return data;
+}
@@ -5,10 +5,12 @@
 
 #include "zakc/hashmap.h"
 
-#include <stdlib.h> // for free, {c,m}alloc
-#include <string.h> // for strcmp
+#include <stdatomic.h> // for atomic_*
+#include <stdint.h>    // for uintptr_t
+#include <stdlib.h>    // for free, {c,m}alloc
+#include <string.h>    // for mem{cmp,cpy}, strcmp
 
-#include "zakc/types.h" // for u{8,64}, usize
+#include "zakc/types.h" // for i32, isize, u{8,32,64}, usize
 
 // Hash map structure
 struct hashmap {
@@ -16,12 +18,32 @@ struct hashmap {
     u64 (*hash)(const void *key);
     // Comparison function for keys
     bool (*cmp)(const void *left, const void *right);
+    // Whether keys are stored by value, using the built-in hash and `==`
+    bool byvalue;
+    // Destructor for keys, or `NULL` if keys are not owned by the map
+    void (*key_free)(void *key);
+    // Destructor for data, or `NULL` if data is not owned by the map
+    void (*value_free)(void *data);
     // Array of linked lists of items
     struct item **items;
     // Capacity of the array
     usize capacity;
     // Number of items in the hash map
     usize nitems;
+    // Block of items allocated at once by `hashmap_clone()`, or the pool of
+    // a fixed-capacity map
+    struct item *slab;
+    // Number of items in the block
+    usize nslab;
+    // Unused items of the pool, linked through their `next` pointers
+    struct item *spare;
+    // Table of the cuckoo engine, or `NULL` for the chained engine
+    _Atomic(struct ctable *) table;
+    // Whether lookups may run concurrently with a writer
+    bool concurrent;
+    // Whether the map lives in caller-provided memory, and takes every item
+    // from its pool
+    bool fixed;
 };
 
 // Item structure
@@ -32,8 +54,21 @@ struct item {
     void *data;
     // Pointer to the next item in the linked list
     struct item *next;
+    // Hash of the key, kept to avoid rehashing when resizing or merging
+    u64 hash;
 };
 
+// Check that `HASHMAP_SIZEOF()` leaves room for the map, one linked list and
+// the padding before the pool, and for each item
+_Static_assert(
+    sizeof(struct hashmap) + sizeof(void *) + _Alignof(struct item)
+        <= HASHMAP_SIZEOF(0),
+    "HASHMAP_SIZEOF is too small"
+);
+_Static_assert(
+    sizeof(struct item) <= 4 * sizeof(u64), "HASHMAP_SIZEOF is too small"
+);
+
 // Hash function for C-strings
 u64 str_hash(const void *key) {
     const char *str = (const char *)key;
@@ -71,6 +106,696 @@ bool bytes_cmp(const void *left, const void *right, usize len) {
     return !(bool)memcmp(datl, datr, len);
 }
 
+// Hash function for integers and pointers passed by value
+u64 u64_hash(const void *key) {
+    // Avalanche the bits of the key (the finalizer of SplitMix64)
+    u64 hash = (u64)(uintptr_t)key;
+    hash = (hash ^ (hash >> 30)) * 0xbf58476d1ce4e5b9ull;
+    hash = (hash ^ (hash >> 27)) * 0x94d049bb133111ebull;
+    return hash ^ (hash >> 31);
+}
+
+// Comparison function for integers and pointers passed by value
+bool u64_cmp(const void *left, const void *right) {
+    return left == right;
+}
+
+// Hash a key, calling the built-in hash directly for keys stored by value
+static inline u64 hashmap_hash(const struct hashmap *map, const void *key) {
+    return map->byvalue ? u64_hash(key) : map->hash(key);
+}
+
+// Map a hash to an index of the array of linked lists, using a multiply
+// rather than a division when the hash is known to be well mixed
+static inline usize hashmap_index(
+    const struct hashmap *map, u64 hash, usize capacity
+) {
+    if (map->byvalue)
+        return mulhi64(hash, capacity);
+    return hash % capacity;
+}
+
+// Compare two keys, comparing keys stored by value directly
+static inline bool hashmap_eq(
+    const struct hashmap *map, const void *left, const void *right
+) {
+    return map->byvalue ? left == right : map->cmp(left, right);
+}
+
+// Pass the key and data of an item to the destructors, if any
+static inline void hashmap_destroy(
+    const struct hashmap *map, const void *key, void *data
+) {
+    if (map->key_free)
+        map->key_free((void *)key);
+    if (map->value_free)
+        map->value_free(data);
+}
+
+// Pass whichever key and data were not kept to the destructors, after
+// inserting an item whose key was already present
+static inline void hashmap_discard(
+    const struct hashmap *map,
+    const void *stored,
+    const void *key,
+    void *kept,
+    void *lost
+) {
+    if (map->key_free && key != stored)
+        map->key_free((void *)key);
+    if (map->value_free && lost != kept)
+        map->value_free(lost);
+}
+
+/*
+ * Cuckoo Engine
+ */
+
+// Number of slots in each bucket
+#define SLOTS 8
+// Load factor beyond which the table is grown
+#define LOAD 0.95
+// Maximum number of buckets searched when making room for an item
+#define QUEUE 128
+// Maximum number of items displaced when making room for an item
+#define DEPTH 5
+// Maximum number of further doublings tried when the items do not fit a table
+#define GROWTH 2
+
+// Byte-wise constants for matching tags
+#define ONES 0x0101010101010101ull
+#define LOWS 0x7f7f7f7f7f7f7f7full
+
+// Bucket structure
+//
+// Each slot has a one-byte tag taken from the hash of its key, or zero if the
+// slot is empty, which are packed into a single word to be matched at once.
+// The version is odd while the bucket is being written, so that readers can
+// detect and retry torn reads. A bucket whose generation differs from its
+// table's is treated as empty, so that the table can be cleared at once.
+struct cbucket {
+    // Version of the bucket
+    atomic_uint version;
+    // Generation of the table in which the bucket was last written
+    atomic_uint gen;
+    // Tag of each slot
+    _Atomic(u64) tags;
+    // Key of each slot
+    _Atomic(const void *) keys[SLOTS];
+    // Data of each slot
+    _Atomic(void *) data[SLOTS];
+};
+
+// Cuckoo table structure
+struct ctable {
+    // Number of buckets minus one
+    usize mask;
+    // Generation of the table, advanced each time it is cleared
+    atomic_uint gen;
+    // Previous table, kept for concurrent readers
+    struct ctable *prev;
+    // Array of buckets
+    struct cbucket buckets[];
+};
+
+// Item to place into a cuckoo table
+struct citem {
+    // Mixed hash of the key
+    u64 hash;
+    // Key of the item
+    const void *key;
+    // Data of the item
+    void *data;
+};
+
+// Step of a search for an empty slot
+struct cstep {
+    // Bucket reached by the step
+    usize bucket;
+    // Index of the previous step, or -1 for a candidate bucket
+    i32 parent;
+    // Slot of the previous step's bucket whose item moves into this bucket
+    u8 slot;
+    // Number of steps from a candidate bucket
+    u8 depth;
+};
+
+#define load(x)     atomic_load_explicit(&(x), memory_order_relaxed)
+#define store(x, v) atomic_store_explicit(&(x), (v), memory_order_relaxed)
+
+// Mix the bits of a hash, since both ends of it are used
+static inline u64 cuckoo_mix(u64 hash) {
+    hash ^= hash >> 33;
+    hash *= 0xff51afd7ed558ccdull;
+    hash ^= hash >> 33;
+    hash *= 0xc4ceb9fe1a85ec53ull;
+    hash ^= hash >> 33;
+    return hash;
+}
+
+// Get the tag of a hash, which is never zero
+static inline u8 cuckoo_tag(u64 hash) {
+    u8 tag = hash >> 56;
+    return tag ? tag : 1;
+}
+
+// Get the other candidate bucket of an item from one bucket and its tag
+static inline usize cuckoo_alt(usize mask, usize bucket, u8 tag) {
+    return (bucket ^ ((usize)tag * 0x5bd1e995)) & mask;
+}
+
+// Match a tag against every slot of a bucket, setting the top bit of the
+// byte of each matching slot
+static inline u64 cuckoo_match(u64 tags, u8 tag) {
+    u64 x = tags ^ (ONES * tag);
+    return ~(((x & LOWS) + LOWS) | x | LOWS);
+}
+
+// Get the tag of a slot
+static inline u8 cuckoo_slot_tag(u64 tags, usize slot) {
+    return tags >> (slot * 8);
+}
+
+// Begin writing to a bucket
+static inline void cbucket_lock(struct cbucket *bucket) {
+    store(bucket->version, load(bucket->version) + 1);
+    atomic_thread_fence(memory_order_release);
+}
+
+// Finish writing to a bucket
+static inline void cbucket_unlock(struct cbucket *bucket) {
+    atomic_store_explicit(
+        &bucket->version, load(bucket->version) + 1, memory_order_release
+    );
+}
+
+// Get the tags of a bucket, all of which are empty if the bucket was last
+// written before the table was cleared
+static inline u64 cbucket_tags(
+    const struct ctable *table, const struct cbucket *bucket
+) {
+    if (load(bucket->gen) != load(table->gen))
+        return 0;
+    return load(bucket->tags);
+}
+
+// Fill a slot of a bucket
+static void cbucket_set(
+    struct ctable *table,
+    struct cbucket *bucket,
+    usize slot,
+    u8 tag,
+    const void *key,
+    void *data
+) {
+    cbucket_lock(bucket);
+    u64 tags = cbucket_tags(table, bucket) & ~(0xffull << (slot * 8));
+    store(bucket->gen, load(table->gen));
+    store(bucket->tags, tags | (u64)tag << (slot * 8));
+    store(bucket->keys[slot], key);
+    store(bucket->data[slot], data);
+    cbucket_unlock(bucket);
+}
+
+// Empty a slot of a bucket
+static void cbucket_clear(struct cbucket *bucket, usize slot) {
+    cbucket_lock(bucket);
+    store(bucket->tags, load(bucket->tags) & ~(0xffull << (slot * 8)));
+    store(bucket->keys[slot], NULL);
+    store(bucket->data[slot], NULL);
+    cbucket_unlock(bucket);
+}
+
+// Find the slot of a key in a bucket, or -1 if absent
+static inline int cbucket_find(
+    const struct hashmap *map,
+    const struct ctable *table,
+    const struct cbucket *bucket,
+    u8 tag,
+    const void *key
+) {
+    for (u64 match = cuckoo_match(cbucket_tags(table, bucket), tag); match;
+         match &= match - 1) {
+        int slot = __builtin_ctzll(match) / 8;
+        if (hashmap_eq(map, load(bucket->keys[slot]), key))
+            return slot;
+    }
+    return -1;
+}
+
+// Find an empty slot in a bucket, or -1 if full
+static inline int cbucket_empty(
+    const struct ctable *table, const struct cbucket *bucket
+) {
+    u64 match = cuckoo_match(cbucket_tags(table, bucket), 0);
+    return match ? __builtin_ctzll(match) / 8 : -1;
+}
+
+// Create a new empty table with the given number of buckets
+static struct ctable *ctable_new(usize nbuckets) {
+    struct ctable *table =
+        calloc(1, sizeof(struct ctable) + nbuckets * sizeof(struct cbucket));
+    if (table)
+        table->mask = nbuckets - 1;
+    return table;
+}
+
+// Free a table along with every previous table
+static void ctable_free(struct ctable *table) {
+    while (table) {
+        struct ctable *prev = table->prev;
+        free(table);
+        table = prev;
+    }
+}
+
+// Make room in one of two candidate buckets by displacing items along the
+// shortest path to an empty slot, returning the bucket with the freed slot
+static isize ctable_make_room(struct ctable *table, usize b1, usize b2) {
+    struct cstep queue[QUEUE];
+    usize len = 0;
+    queue[len++] = (struct cstep){.bucket = b1, .parent = -1};
+    queue[len++] = (struct cstep){.bucket = b2, .parent = -1};
+    for (usize head = 0; head < len; head++) {
+        struct cstep step = queue[head];
+        struct cbucket *bucket = &table->buckets[step.bucket];
+        u64 tags = cbucket_tags(table, bucket);
+        for (usize slot = 0; slot < SLOTS; slot++) {
+            u8 tag = cuckoo_slot_tag(tags, slot);
+            usize alt = cuckoo_alt(table->mask, step.bucket, tag);
+            int empty = cbucket_empty(table, &table->buckets[alt]);
+            if (empty < 0) {
+                // Search onwards from the other bucket, unless it is already
+                // on the path, as moving an item twice would misplace it
+                bool seen = false;
+                for (i32 i = head; i >= 0; i = queue[i].parent)
+                    seen |= queue[i].bucket == alt;
+                if (!seen && len < QUEUE && step.depth + 1 < DEPTH)
+                    queue[len++] = (struct cstep){
+                        .bucket = alt,
+                        .parent = head,
+                        .slot = slot,
+                        .depth = step.depth + 1,
+                    };
+                continue;
+            }
+            // Move each item along the path into the slot freed after it,
+            // copying before clearing so that items are never missing
+            usize dst = alt;
+            usize hole = empty;
+            for (i32 i = head;; i = queue[i].parent) {
+                struct cbucket *src = &table->buckets[queue[i].bucket];
+                cbucket_set(
+                    table,
+                    &table->buckets[dst],
+                    hole,
+                    cuckoo_slot_tag(cbucket_tags(table, src), slot),
+                    load(src->keys[slot]),
+                    load(src->data[slot])
+                );
+                cbucket_clear(src, slot);
+                dst = queue[i].bucket;
+                hole = slot;
+                if (queue[i].parent < 0)
+                    return dst;
+                slot = queue[i].slot;
+            }
+        }
+    }
+    return -1;
+}
+
+// Place an item which is known to be absent into a table
+static bool ctable_place(
+    struct ctable *table, u64 hash, const void *key, void *data
+) {
+    u8 tag = cuckoo_tag(hash);
+    usize b1 = hash & table->mask;
+    usize b2 = cuckoo_alt(table->mask, b1, tag);
+    isize bucket = b1;
+    int slot = cbucket_empty(table, &table->buckets[b1]);
+    if (slot < 0) {
+        bucket = b2;
+        slot = cbucket_empty(table, &table->buckets[b2]);
+    }
+    if (slot < 0) {
+        bucket = ctable_make_room(table, b1, b2);
+        if (bucket < 0)
+            return false;
+        slot = cbucket_empty(table, &table->buckets[bucket]);
+    }
+    cbucket_set(table, &table->buckets[bucket], slot, tag, key, data);
+    return true;
+}
+
+// Move every item, and optionally a new one, into a new table with at least
+// the given number of buckets
+//
+// The table is doubled a few times if the items do not fit, after which the
+// old table is kept.
+static bool cuckoo_rehash(
+    struct hashmap *map, usize nbuckets, const struct citem *item
+) {
+    struct ctable *old = load(map->table);
+    for (usize tries = 0; tries <= GROWTH; tries++, nbuckets *= 2) {
+        struct ctable *table = ctable_new(nbuckets);
+        if (!table)
+            return false;
+        // Insert every item into the new table
+        bool placed = !item
+                   || ctable_place(table, item->hash, item->key, item->data);
+        for (usize b = 0; placed && old && b <= old->mask; b++) {
+            struct cbucket *bucket = &old->buckets[b];
+            for (usize slot = 0; placed && slot < SLOTS; slot++) {
+                if (!cuckoo_slot_tag(cbucket_tags(old, bucket), slot))
+                    continue;
+                const void *key = load(bucket->keys[slot]);
+                void *data = load(bucket->data[slot]);
+                u64 hash = cuckoo_mix(hashmap_hash(map, key));
+                placed = ctable_place(table, hash, key, data);
+            }
+        }
+        if (!placed) {
+            // Try again with more buckets if an item did not fit
+            free(table);
+            continue;
+        }
+        // Publish the new table, keeping the old one for concurrent readers
+        if (map->concurrent)
+            table->prev = old;
+        else
+            free(old);
+        atomic_store_explicit(&map->table, table, memory_order_release);
+        return true;
+    }
+    // Return `false` if the items did not fit any of the tables
+    return false;
+}
+
+// Get the number of buckets needed to hold a number of items
+static usize cuckoo_nbuckets(usize nitems) {
+    usize nbuckets = 1;
+    while (nbuckets * SLOTS * LOAD < nitems)
+        nbuckets *= 2;
+    return nbuckets;
+}
+
+// Look up a key, retrying if a bucket was written concurrently
+static bool cuckoo_lookup(
+    const struct hashmap *map, const void *key, void **data
+) {
+    const struct ctable *table =
+        atomic_load_explicit(&map->table, memory_order_acquire);
+    u64 hash = cuckoo_mix(hashmap_hash(map, key));
+    u8 tag = cuckoo_tag(hash);
+    usize b1 = hash & table->mask;
+    usize b2 = cuckoo_alt(table->mask, b1, tag);
+    const struct cbucket *first = &table->buckets[b1];
+    const struct cbucket *second = &table->buckets[b2];
+    for (;;) {
+        u32 v1 = atomic_load_explicit(&first->version, memory_order_acquire);
+        u32 v2 = atomic_load_explicit(&second->version, memory_order_acquire);
+        if ((v1 | v2) & 1)
+            // Wait for the writer to finish
+            continue;
+        // Collect the items whose tags match, without comparing their keys,
+        // which the writer may clear until both versions are checked
+        const void *keys[2 * SLOTS];
+        void *values[2 * SLOTS];
+        usize n = 0;
+        for (usize i = 0; i < 2; i++) {
+            const struct cbucket *bucket = i ? second : first;
+            for (u64 match = cuckoo_match(cbucket_tags(table, bucket), tag);
+                 match; match &= match - 1) {
+                int slot = __builtin_ctzll(match) / 8;
+                const void *stored = load(bucket->keys[slot]);
+                if (!stored && !map->byvalue)
+                    continue;
+                keys[n] = stored;
+                values[n++] = load(bucket->data[slot]);
+            }
+        }
+        atomic_thread_fence(memory_order_acquire);
+        if (load(first->version) != v1 || load(second->version) != v2)
+            // Retry if either bucket was written meanwhile
+            continue;
+        // Compare the keys of a consistent view of both buckets
+        for (usize i = 0; i < n; i++) {
+            if (hashmap_eq(map, keys[i], key)) {
+                if (data)
+                    *data = values[i];
+                return true;
+            }
+        }
+        return false;
+    }
+}
+
+// Insert an item with a given key hash, replacing the data of an existing
+// item if requested
+static bool cuckoo_insert(
+    struct hashmap *map, u64 hash, const void *key, void *data, bool replace
+) {
+    hash = cuckoo_mix(hash);
+    u8 tag = cuckoo_tag(hash);
+    struct ctable *table = load(map->table);
+    usize b1 = hash & table->mask;
+    usize b2 = cuckoo_alt(table->mask, b1, tag);
+    // Replace the data of an existing item
+    for (usize i = 0; i < 2; i++) {
+        struct cbucket *bucket = &table->buckets[i ? b2 : b1];
+        int slot = cbucket_find(map, table, bucket, tag, key);
+        if (slot < 0)
+            continue;
+        const void *stored = load(bucket->keys[slot]);
+        void *old = load(bucket->data[slot]);
+        if (replace) {
+            cbucket_lock(bucket);
+            store(bucket->data[slot], data);
+            cbucket_unlock(bucket);
+            hashmap_discard(map, stored, key, data, old);
+        } else {
+            hashmap_discard(map, stored, key, old, data);
+        }
+        return true;
+    }
+    // Grow the table if it is too full, or if there is no room for the item
+    if (map->nitems + 1 > (table->mask + 1) * SLOTS * LOAD ||
+        !ctable_place(table, hash, key, data)) {
+        // Place the item while moving the others
+        struct citem item = {.hash = hash, .key = key, .data = data};
+        if (!cuckoo_rehash(map, (table->mask + 1) * 2, &item))
+            return false;
+    }
+    map->nitems++;
+    return true;
+}
+
+// Remove an item, returning its data
+static void *cuckoo_remove(struct hashmap *map, const void *key) {
+    u64 hash = cuckoo_mix(hashmap_hash(map, key));
+    u8 tag = cuckoo_tag(hash);
+    struct ctable *table = load(map->table);
+    usize b1 = hash & table->mask;
+    usize b2 = cuckoo_alt(table->mask, b1, tag);
+    for (usize i = 0; i < 2; i++) {
+        struct cbucket *bucket = &table->buckets[i ? b2 : b1];
+        int slot = cbucket_find(map, table, bucket, tag, key);
+        if (slot >= 0) {
+            const void *stored = load(bucket->keys[slot]);
+            void *data = load(bucket->data[slot]);
+            cbucket_clear(bucket, slot);
+            if (map->key_free)
+                map->key_free((void *)stored);
+            map->nitems--;
+            return data;
+        }
+    }
+    return NULL;
+}
+
+// Call a function on every item
+static void cuckoo_iter(
+    const struct hashmap *map,
+    void (*callback)(const void *key, void *data, void *context),
+    void *context
+) {
+    const struct ctable *table = load(map->table);
+    for (usize b = 0; b <= table->mask; b++) {
+        const struct cbucket *bucket = &table->buckets[b];
+        for (usize slot = 0; slot < SLOTS; slot++)
+            if (cuckoo_slot_tag(cbucket_tags(table, bucket), slot))
+                callback(
+                    load(bucket->keys[slot]), load(bucket->data[slot]), context
+                );
+    }
+}
+
+// Empty the table, leaving stale buckets to be overwritten as they are used
+static void cuckoo_clear(struct hashmap *map) {
+    struct ctable *table = load(map->table);
+    u32 gen = load(table->gen) + 1;
+    if (!gen) {
+        // Empty every bucket once the generation wraps around, so that no
+        // stale bucket can match a future generation
+        for (usize b = 0; b <= table->mask; b++) {
+            struct cbucket *bucket = &table->buckets[b];
+            cbucket_lock(bucket);
+            store(bucket->tags, 0);
+            store(bucket->gen, 0);
+            cbucket_unlock(bucket);
+        }
+    }
+    atomic_store_explicit(&table->gen, gen, memory_order_release);
+}
+
+/*
+ * Chained Engine
+ */
+
+// Load factor beyond which the array of linked lists is grown
+#define CHAIN_LOAD 0.8
+
+// Get the number of linked lists needed to hold a number of items
+static inline usize chain_capacity(usize nitems) {
+    return nitems / CHAIN_LOAD + 1;
+}
+
+// Find the link pointing to the item of a key, or to the end of its list
+static inline struct item **chain_find(
+    const struct hashmap *map, u64 hash, const void *key
+) {
+    struct item **link = &map->items[hashmap_index(map, hash, map->capacity)];
+    // Compare the stored hashes first to skip most calls to the comparison
+    for (struct item *item; (item = *link); link = &item->next)
+        if (item->hash == hash && hashmap_eq(map, item->key, key))
+            break;
+    return link;
+}
+
+// Allocate an item, taking it from the pool of a fixed-capacity map
+static inline struct item *chain_alloc(struct hashmap *map) {
+    if (!map->fixed)
+        return malloc(sizeof(struct item));
+    struct item *item = map->spare;
+    if (item)
+        map->spare = item->next;
+    return item;
+}
+
+// Free an item, unless it belongs to the block allocated by a clone, or
+// return it to the pool of a fixed-capacity map
+static inline void chain_free(struct hashmap *map, struct item *item) {
+    uintptr_t addr = (uintptr_t)item;
+    uintptr_t slab = (uintptr_t)map->slab;
+    if (addr - slab >= map->nslab * sizeof(struct item)) {
+        free(item);
+    } else if (map->fixed) {
+        item->next = map->spare;
+        map->spare = item;
+    }
+}
+
+// Get the number of linked lists of a fixed-capacity map of a number of
+// items, which keeps the same load as `chain_capacity()`
+static inline usize chain_fixed_capacity(usize nitems) {
+    return nitems + nitems / 4 + 1;
+}
+
+// Get the offset of the pool of a fixed-capacity map within its buffer
+static inline usize chain_fixed_offset(usize nitems) {
+    usize offset = sizeof(struct hashmap)
+                 + chain_fixed_capacity(nitems) * sizeof(struct item *);
+    usize align = _Alignof(struct item);
+    return (offset + align - 1) / align * align;
+}
+
+// Insert an item with a given key hash, replacing the data of an existing
+// item if requested
+static bool chain_insert(
+    struct hashmap *map, u64 hash, const void *key, void *data, bool replace
+) {
+    // Check if we need to resize the `items` array, which a fixed-capacity
+    // map sized for its pool never does
+    if (!map->fixed && map->nitems + 1 > map->capacity * CHAIN_LOAD) {
+        // Increase the capacity of the `items` array
+        if (!hashmap_reserve(map, map->capacity == 0 ? 1 : map->capacity * 2))
+            // Return `false` if unable to resize the `items` array
+            return false;
+    }
+
+    // Check if the key is already present in the hash map
+    struct item **link = chain_find(map, hash, key);
+    struct item *found = *link;
+    if (found) {
+        // Overwrite the data of the existing item if requested, then destroy
+        // whichever key and data were not kept
+        void *lost = replace ? found->data : data;
+        if (replace)
+            found->data = data;
+        hashmap_discard(map, found->key, key, found->data, lost);
+        return true;
+    }
+
+    // Allocate memory for the new item
+    struct item *item = chain_alloc(map);
+    if (!item)
+        // Return `false` if memory allocation failed or the pool is empty
+        return false;
+    // Initialize the new item at the end of its linked list
+    *item = (struct item){
+        .key = key,
+        .data = data,
+        .hash = hash,
+    };
+    *link = item;
+    // Increase the number of items in the hash map
+    map->nitems++;
+    return true;
+}
+
+// Insert an item with a given key hash into either engine
+static inline bool hashmap_put(
+    struct hashmap *map, u64 hash, const void *key, void *data, bool replace
+) {
+    if (load(map->table))
+        return cuckoo_insert(map, hash, key, data, replace);
+    return chain_insert(map, hash, key, data, replace);
+}
+
+// Free every item of the chained engine, passing every item of either
+// engine to the destructors, and leave the map empty
+static void hashmap_free_items(struct hashmap *map) {
+    const struct ctable *table = load(map->table);
+    if (table && (map->key_free || map->value_free)) {
+        for (usize b = 0; b <= table->mask; b++) {
+            const struct cbucket *bucket = &table->buckets[b];
+            for (usize slot = 0; slot < SLOTS; slot++)
+                if (cuckoo_slot_tag(cbucket_tags(table, bucket), slot))
+                    hashmap_destroy(
+                        map, load(bucket->keys[slot]), load(bucket->data[slot])
+                    );
+        }
+    }
+    for (usize i = 0; i < map->capacity; i++) {
+        struct item *item = map->items[i];
+        while (item) {
+            struct item *next = item->next;
+            hashmap_destroy(map, item->key, item->data);
+            chain_free(map, item);
+            item = next;
+        }
+        map->items[i] = NULL;
+    }
+    if (!map->fixed) {
+        // Free the block of items only once no item can be found within it
+        free(map->slab);
+        map->slab = NULL;
+        map->nslab = 0;
+    }
+    map->nitems = 0;
+}
+
 /**
  * Create a new hash map.
  *
@@ -104,6 +829,148 @@ struct hashmap *hashmap_new(
     return map;
 }
 
+/**
+ * Create a new fixed-capacity hash map in caller-provided memory.
+ *
+ * @param buf    Pointer to the buffer.
+ * @param bytes  Size of the buffer, in bytes.
+ * @param hash   Hash function for keys.
+ * @param cmp    Comparison function for keys.
+ * @return       Pointer to the hash map, which is at the start of the buffer,
+ *               or `NULL` if the buffer is `NULL`, misaligned or too small to
+ *               hold the map.
+ */
+struct hashmap *hashmap_init_in(
+    void *buf,
+    usize bytes,
+    u64 (*hash)(const void *key),
+    bool (*cmp)(const void *left, const void *right)
+) {
+    if (!buf || (uintptr_t)buf % _Alignof(struct hashmap)
+        || bytes < chain_fixed_offset(0))
+        // Return `NULL` if the buffer cannot hold a hash map
+        return NULL;
+    struct hashmap *map = buf;
+
+    // Find the largest pool that fits in the buffer
+    usize lo = 0;
+    usize hi = bytes / (sizeof(struct item) + sizeof(struct item *));
+    while (lo < hi) {
+        usize mid = hi - (hi - lo) / 2;
+        if (chain_fixed_offset(mid) + mid * sizeof(struct item) <= bytes)
+            lo = mid;
+        else
+            hi = mid - 1;
+    }
+
+    // Initialize the hash map, with its array of linked lists and pool of
+    // items in the rest of the buffer
+    usize capacity = chain_fixed_capacity(lo);
+    *map = (struct hashmap){
+        .hash = hash,
+        .cmp = cmp,
+        .items = (struct item **)(map + 1),
+        .capacity = capacity,
+        .nitems = 0,
+        .slab = lo ? (struct item *)((u8 *)buf + chain_fixed_offset(lo)) : NULL,
+        .nslab = lo,
+        .fixed = true,
+    };
+    for (usize i = 0; i < capacity; i++)
+        map->items[i] = NULL;
+    // Link every item of the pool as unused
+    for (usize i = lo; i > 0; i--)
+        chain_free(map, &map->slab[i - 1]);
+
+    // Return the hash map at the start of the buffer
+    return map;
+}
+
+/**
+ * Create a new hash map keyed by 64-bit integers.
+ *
+ * @return  Pointer to the newly-created hash map, or `NULL` if memory
+ *          allocation failed.
+ */
+struct hashmap *hashmap_new_u64(void) {
+    // Create a hash map with the built-in hash and comparison functions
+    struct hashmap *map = hashmap_new(u64_hash, u64_cmp);
+    if (!map)
+        // Return `NULL` if memory allocation failed
+        return NULL;
+    // Store keys by value
+    map->byvalue = true;
+    // Return the newly-created hash map
+    return map;
+}
+
+/**
+ * Create a new hash map keyed by pointer identity.
+ *
+ * @return  Pointer to the newly-created hash map, or `NULL` if memory
+ *          allocation failed.
+ */
+struct hashmap *hashmap_new_ptr(void) {
+    // Pointers are stored by value, just like integers
+    return hashmap_new_u64();
+}
+
+/**
+ * Create a new hash map backed by a bucketized cuckoo table.
+ *
+ * @param hash        Hash function for keys.
+ * @param cmp         Comparison function for keys.
+ * @param concurrent  Whether to allow lookups concurrently with a writer.
+ * @return            Pointer to the newly-created hash map, or `NULL` if
+ *                    memory allocation failed.
+ */
+struct hashmap *hashmap_new_cuckoo(
+    u64 (*hash)(const void *key),
+    bool (*cmp)(const void *left, const void *right),
+    bool concurrent
+) {
+    // Create a hash map without any chains
+    struct hashmap *map = hashmap_new(hash, cmp);
+    if (!map)
+        // Return `NULL` if memory allocation failed
+        return NULL;
+
+    // Allocate a table with a single bucket
+    struct ctable *table = ctable_new(1);
+    if (!table) {
+        // Return `NULL` if memory allocation failed
+        free(map);
+        return NULL;
+    }
+    atomic_init(&map->table, table);
+    map->concurrent = concurrent;
+
+    // Return the newly-created hash map
+    return map;
+}
+
+/**
+ * Set the destructors of the hash map's keys and data.
+ *
+ * Once set, the map owns the keys and data of its items.
+ *
+ * @param map         Pointer to the hash map.
+ * @param key_free    Destructor for keys, or `NULL` to not free keys.
+ * @param value_free  Destructor for data, or `NULL` to not free data.
+ */
+void hashmap_set_free(
+    struct hashmap *map,
+    void (*key_free)(void *key),
+    void (*value_free)(void *data)
+) {
+    if (!map)
+        // Return early if the hash map is `NULL`
+        return;
+    // Store the destructors
+    map->key_free = key_free;
+    map->value_free = value_free;
+}
+
 /**
  * Delete the hash map.
  *
@@ -113,25 +980,39 @@ void hashmap_drop(struct hashmap *map) {
     if (!map)
         // Return early if the hash map is `NULL`
         return;
-    // Free all items in the hash map
-    struct item *tmp, *item;
-    for (usize i = 0; i < map->capacity; i++) {
-        item = map->items[i];
-        while (item != NULL) {
-            tmp = item;
-            item = item->next;
-            free(tmp);
-        }
-    }
+    // Free all items in the hash map, along with their keys and data
+    hashmap_free_items(map);
+    if (map->fixed)
+        // Return early if the map lives in caller-provided memory
+        return;
+    // Free the tables of the cuckoo engine
+    ctable_free(load(map->table));
     free(map->items);
     free(map);
 }
 
+/**
+ * Remove every item from the hash map, keeping its capacity.
+ *
+ * @param map  Pointer to the hash map.
+ */
+void hashmap_clear(struct hashmap *map) {
+    if (!map)
+        // Return early if the hash map is `NULL`
+        return;
+    // Free all items in the hash map, along with their keys and data
+    hashmap_free_items(map);
+    if (load(map->table))
+        // Empty the cuckoo table without touching its buckets
+        cuckoo_clear(map);
+}
+
 /**
  * Insert a new item into the hash map.
  *
  * If the key is already present in the hash map, its associated data will be
- * overwritten with the new data.
+ * overwritten with the new data. If the hash map has destructors, the new key
+ * and the overwritten data are destroyed.
  *
  * The hash map will be resized if necessary to accommodate the new item.
  *
@@ -144,56 +1025,8 @@ bool hashmap_insert(struct hashmap *map, const void *key, void *data) {
     if (!map)
         // Return `false` if the hash map is `NULL`
         return false;
-
-    // Check if the `items` field is `NULL`
-    if (!map->items) {
-        // Reserve space for at least one item in the hash map
-        if (!hashmap_reserve(map, 1))
-            return false;
-    }
-
-    // Calculate the index of the item in the `items` array
-    u64 index = map->hash(key) % map->capacity;
-    // Get the pointer to the head of the linked list at the index
-    struct item *item = map->items[index];
-
-    // Check if the key is already present in the hash map
-    while (item && !map->cmp(item->key, key))
-        item = item->next;
-
-    // Check if we need to resize the `items` array
-    if (map->nitems + 1 > map->capacity * 0.8) {
-        // Increase the capacity of the `items` array
-        if (!hashmap_reserve(map, map->capacity == 0 ? 1 : map->capacity * 2))
-            // Return `false` if unable to resize the `items` array
-            return false;
-        // Update the index of the item after resizing the `items` array
-        index = map->hash(key) % map->capacity;
-    }
-
-    if (item) {
-        // Overwrite the data of the existing item
-        item->data = data;
-    } else {
-        // Allocate memory for the new item
-        item = malloc(sizeof(struct item));
-        if (!item)
-            // Return `false` if memory allocation failed
-            return false;
-        // Initialize the new item
-        *item = (struct item){
-            .key = key,
-            .data = data,
-            .next = map->items[index],
-        };
-        // Insert the new item into the linked list at the index
-        map->items[index] = item;
-        // Increase the number of items in the hash map
-        map->nitems++;
-    }
-
-    // Return `true` to indicate success
-    return true;
+    // Insert the item, replacing the data of an existing item
+    return hashmap_put(map, hashmap_hash(map, key), key, data, true);
 }
 
 /**
@@ -208,48 +1041,33 @@ bool hashmap_insert(struct hashmap *map, const void *key, void *data) {
  *              invalid.
  */
 void *hashmap_remove(struct hashmap *map, const void *key) {
+    if (map && load(map->table))
+        // Remove from the cuckoo table instead
+        return cuckoo_remove(map, key);
     if (!map || !map->items)
         // Return `NULL` if the hash map or `items` field is `NULL`
         return NULL;
 
-    // Calculate the index of the item in the `items` array
-    const u64 index = map->hash(key) % map->capacity;
-    // Get the pointer to the head of the linked list at the index
-    struct item *item = map->items[index];
-
-    if (item && map->cmp(item->key, key)) {
-        // Get the data of the removed item
-        void *data = item->data;
-        // Update the head of the linked list to point to the next item
-        map->items[index] = item->next;
-        // Free the removed item
-        free(item);
-        // Update the number of items in the hash map
-        map->nitems--;
-        // Return the data of the removed item
-        return data;
-    }
-
-    // Check if the key is present in the linked list
-    while (item && item->next) {
-        if (map->cmp(item->next->key, key)) {
-            // Get the data of the removed item
-            void *data = item->next->data;
-            // Update the next pointer of the current item to point to the
-            // next item in the linked list
-            item->next = item->next->next;
-            // Free the removed item
-            free(item->next);
-            // Update the number of items in the hash map
-            map->nitems--;
-            // Return the data of the removed item
-            return data;
-        }
-        item = item->next;
-    }
+    // Find the link pointing to the item in its linked list
+    struct item **link = chain_find(map, hashmap_hash(map, key), key);
+    struct item *item = *link;
+    if (!item)
+        // Return `NULL` if the key is not present in the hash map
+        return NULL;
 
-    // Return `NULL` if the key is not present in the hash map
-    return NULL;
+    // Get the data of the removed item
+    void *data = item->data;
+    // Unlink the item from its linked list
+    *link = item->next;
+    if (map->key_free)
+        // Free the key of the removed item
+        map->key_free((void *)item->key);
+    // Free the removed item
+    chain_free(map, item);
+    // Update the number of items in the hash map
+    map->nitems--;
+    // Return the data of the removed item
+    return data;
 }
 
 /**
@@ -260,25 +1078,15 @@ void *hashmap_remove(struct hashmap *map, const void *key) {
  * @return      `true` if the item is present, `false` otherwise.
  */
 bool hashmap_contains(const struct hashmap *map, const void *key) {
+    if (map && load(map->table))
+        // Look up the key in the cuckoo table instead
+        return cuckoo_lookup(map, key, NULL);
     if (!map || !map->items)
         // Return `false` if the hash map or `items` field is `NULL`
         return false;
 
-    // Calculate the index of the item in the `items` array
-    const u64 index = map->hash(key) % map->capacity;
-    // Get the pointer to the head of the linked list at the index
-    const struct item *item = map->items[index];
-
-    // Check if the key is present in the linked list
-    while (item) {
-        if (map->cmp(item->key, key))
-            // Return `true` if the key is found
-            return true;
-        item = item->next;
-    }
-
-    // Return `false` if the key is not present in the hash map
-    return false;
+    // Check if the key is present in its linked list
+    return *chain_find(map, hashmap_hash(map, key), key) != NULL;
 }
 
 /**
@@ -293,25 +1101,20 @@ bool hashmap_contains(const struct hashmap *map, const void *key) {
  *              invalid.
  */
 void *hashmap_get(const struct hashmap *map, const void *key) {
+    if (map && load(map->table)) {
+        // Look up the key in the cuckoo table instead
+        void *data = NULL;
+        cuckoo_lookup(map, key, &data);
+        return data;
+    }
     if (!map || !map->items)
         // Return `NULL` if the hash map or `items` field is `NULL`
         return NULL;
 
-    // Calculate the index of the item in the `items` array
-    const u64 index = map->hash(key) % map->capacity;
-    // Get the pointer to the head of the linked list at the index
-    const struct item *item = map->items[index];
-
-    // Check if the key is present in the linked list
-    while (item) {
-        if (map->cmp(item->key, key))
-            // Return the data of the item if the key is found
-            return item->data;
-        item = item->next;
-    }
-
-    // Return `NULL` if the key is not present in the hash map
-    return NULL;
+    // Find the item in its linked list
+    const struct item *item = *chain_find(map, hashmap_hash(map, key), key);
+    // Return the data of the item, or `NULL` if the key is not present
+    return item ? item->data : NULL;
 }
 
 /**
@@ -327,6 +1130,12 @@ usize hashmap_capacity(const struct hashmap *map) {
     if (!map)
         // Return 0 if the hash map is `NULL`
         return 0;
+    if (load(map->table))
+        // Return the number of slots in the cuckoo table
+        return (load(map->table)->mask + 1) * SLOTS;
+    if (map->fixed)
+        // Return the number of items in the pool of a fixed-capacity map
+        return map->nslab;
     // Return the capacity of the hash map
     return map->capacity;
 }
@@ -367,6 +1176,18 @@ bool hashmap_reserve(struct hashmap *map, usize capacity) {
     if (capacity < map->nitems)
         return true;
 
+    if (map->fixed)
+        // Never resize a fixed-capacity map, which can only hold its pool
+        return capacity <= map->nslab;
+
+    if (load(map->table)) {
+        // Grow the cuckoo table if it has too few buckets
+        usize nbuckets = cuckoo_nbuckets(capacity);
+        if (nbuckets <= load(map->table)->mask + 1)
+            return true;
+        return cuckoo_rehash(map, nbuckets, NULL);
+    }
+
     // Allocate memory for the new array of linked lists
     struct item **items = calloc(capacity, sizeof(struct item *));
     if (!items)
@@ -376,12 +1197,12 @@ bool hashmap_reserve(struct hashmap *map, usize capacity) {
     for (usize i = 0; i < map->capacity; i++) {
         struct item *tmp, *item = map->items[i];
         while (item != NULL) {
-            // Compute the new hash value for the item
-            u64 hash = map->hash(item->key) % capacity;
+            // Compute the new index of the item from its stored hash
+            usize index = hashmap_index(map, item->hash, capacity);
             // Insert the item into the new array of linked lists
             tmp = item->next;
-            item->next = items[hash];
-            items[hash] = item;
+            item->next = items[index];
+            items[index] = item;
             // Move to the next item in the old array of linked lists
             item = tmp;
         }
@@ -412,6 +1233,11 @@ void hashmap_iter(
     if (!map || !callback)
         // Return early if the hash map or callback is `NULL`
         return;
+    if (load(map->table)) {
+        // Iterate over the cuckoo table instead
+        cuckoo_iter(map, callback, context);
+        return;
+    }
     // Iterate over the array of linked lists
     for (usize i = 0; i < map->capacity; i++) {
         struct item *item = map->items[i];
@@ -422,3 +1248,151 @@ void hashmap_iter(
         }
     }
 }
+
+/**
+ * Create a copy of the hash map.
+ *
+ * The copy has the same capacity and layout as the original, so no keys are
+ * rehashed, and all of its items are allocated as a single block.
+ *
+ * @param map  Pointer to the hash map to copy.
+ * @return     Pointer to the newly-created copy, or `NULL` if the map is
+ *             `NULL` or memory allocation failed.
+ */
+struct hashmap *hashmap_clone(const struct hashmap *map) {
+    if (!map)
+        // Return `NULL` if the hash map is `NULL`
+        return NULL;
+
+    // Create an empty hash map with the same functions
+    struct hashmap *copy = hashmap_new(map->hash, map->cmp);
+    if (!copy)
+        // Return `NULL` if memory allocation failed
+        return NULL;
+    copy->byvalue = map->byvalue;
+    copy->concurrent = map->concurrent;
+
+    const struct ctable *table = load(map->table);
+    if (table) {
+        // Copy the buckets of the cuckoo table as they are
+        usize nbuckets = table->mask + 1;
+        struct ctable *dup = ctable_new(nbuckets);
+        if (!dup) {
+            // Return `NULL` if memory allocation failed
+            free(copy);
+            return NULL;
+        }
+        memcpy(dup->buckets, table->buckets, nbuckets * sizeof(struct cbucket));
+        store(dup->gen, load(table->gen));
+        atomic_init(&copy->table, dup);
+        copy->nitems = map->nitems;
+        return copy;
+    }
+    if (!map->capacity)
+        // Return early if there are no linked lists to copy
+        return copy;
+
+    // Allocate the array of linked lists, and a block for every item
+    copy->items = calloc(map->capacity, sizeof(struct item *));
+    if (map->nitems)
+        copy->slab = malloc(map->nitems * sizeof(struct item));
+    if (!copy->items || (map->nitems && !copy->slab)) {
+        // Return `NULL` if memory allocation failed
+        hashmap_drop(copy);
+        return NULL;
+    }
+    copy->capacity = map->capacity;
+    copy->nslab = map->nitems;
+    copy->nitems = map->nitems;
+
+    // Copy each linked list in order into consecutive items of the block
+    struct item *next = copy->slab;
+    for (usize i = 0; i < map->capacity; i++) {
+        struct item **link = &copy->items[i];
+        for (const struct item *item = map->items[i]; item;
+             item = item->next) {
+            *next = *item;
+            *link = next;
+            link = &next->next;
+            next++;
+        }
+        *link = NULL;
+    }
+
+    // Return the newly-created copy
+    return copy;
+}
+
+/**
+ * Merge the items of one hash map into another, leaving it empty.
+ *
+ * The destination is resized at most once, for the case where no keys are
+ * shared. If both maps use the same hash function, the hashes stored with
+ * the source's items are reused rather than recomputed.
+ *
+ * Each item is removed from the source as it is moved, so that its key and
+ * data are only ever owned by one map. If memory allocation fails, the items
+ * not yet moved remain in the source.
+ *
+ * @param dst     Pointer to the hash map to merge into.
+ * @param src     Pointer to the hash map to merge from.
+ * @param policy  Which data to keep for keys present in both maps.
+ * @return        `true` if the operation was successful, `false` otherwise.
+ */
+bool hashmap_merge(
+    struct hashmap *dst, struct hashmap *src, enum hashmap_policy policy
+) {
+    if (!dst || !src)
+        // Return `false` if either hash map is `NULL`
+        return false;
+    if (dst == src)
+        // Return early if merging a hash map into itself
+        return true;
+    bool replace = policy == HashmapReplace;
+
+    // Reserve space for every item at once
+    usize nitems = dst->nitems + src->nitems;
+    if (load(dst->table)) {
+        if (!hashmap_reserve(dst, nitems))
+            return false;
+    } else if (!dst->fixed && chain_capacity(nitems) > dst->capacity) {
+        if (!hashmap_reserve(dst, chain_capacity(nitems)))
+            return false;
+    }
+
+    struct ctable *table = load(src->table);
+    if (table) {
+        // Move every item of the cuckoo table, which stores no hashes
+        for (usize b = 0; b <= table->mask; b++) {
+            struct cbucket *bucket = &table->buckets[b];
+            for (usize slot = 0; slot < SLOTS; slot++) {
+                if (!cuckoo_slot_tag(cbucket_tags(table, bucket), slot))
+                    continue;
+                const void *key = load(bucket->keys[slot]);
+                void *data = load(bucket->data[slot]);
+                u64 hash = hashmap_hash(dst, key);
+                if (!hashmap_put(dst, hash, key, data, replace))
+                    return false;
+                cbucket_clear(bucket, slot);
+                src->nitems--;
+            }
+        }
+        return true;
+    }
+
+    // Move every item of the linked lists, reusing their hashes if valid
+    bool rehash = dst->hash != src->hash || dst->byvalue != src->byvalue;
+    for (usize i = 0; i < src->capacity; i++) {
+        for (struct item *item; (item = src->items[i]);) {
+            u64 hash = rehash ? hashmap_hash(dst, item->key) : item->hash;
+            if (!hashmap_put(dst, hash, item->key, item->data, replace))
+                return false;
+            src->items[i] = item->next;
+            chain_free(src, item);
+            src->nitems--;
+        }
+    }
+    // Free the source's block of items, which are no longer in use
+    hashmap_free_items(src);
+    return true;
+}
@@ -0,0 +1,552 @@
+// File:        hashset.c
+// Author:      Zakhary Kaplan <https://zakhary.dev>
+// Created:     17 Oct 2026
+// SPDX-License-Identifier: MIT
+
+#include "zakc/hashset.h"
+
+#include <stdlib.h> // for free, {c,m}alloc
+
+#include "zakc/hashmap.h" // for mulhi64, u64_{cmp,hash}
+#include "zakc/types.h"   // for u64, usize
+
+// Maximum ratio of keys to buckets before the set is resized
+#define LOAD 0.8
+
+// Hash set structure
+struct hashset {
+    // Hash function for keys
+    u64 (*hash)(const void *key);
+    // Comparison function for keys
+    bool (*cmp)(const void *left, const void *right);
+    // Whether keys are stored by value, using the built-in hash and `==`
+    bool byvalue;
+    // Destructor for keys, or `NULL` if keys are not owned by the set
+    void (*key_free)(void *key);
+    // Array of linked lists of entries
+    struct entry **entries;
+    // Number of buckets in the array
+    usize nbuckets;
+    // Number of keys in the hash set
+    usize nkeys;
+};
+
+// Entry structure
+//
+// Unlike an item of a hash map, an entry has no data, but it still stores
+// the hash of its key so that growing the set never calls the hash function.
+struct entry {
+    // Key of the entry
+    const void *key;
+    // Hash of the key
+    u64 hash;
+    // Pointer to the next entry in the linked list
+    struct entry *next;
+};
+
+// Hash a key, calling the built-in hash directly for keys stored by value
+static inline u64 hashset_hash(const struct hashset *set, const void *key) {
+    return set->byvalue ? u64_hash(key) : set->hash(key);
+}
+
+// Map a hash to a bucket, using a multiply rather than a division when the
+// hash is known to be well mixed
+static inline usize hashset_index(
+    const struct hashset *set, u64 hash, usize nbuckets
+) {
+    if (set->byvalue)
+        return mulhi64(hash, nbuckets);
+    return hash % nbuckets;
+}
+
+// Compare two keys, comparing keys stored by value directly
+static inline bool hashset_eq(
+    const struct hashset *set, const void *left, const void *right
+) {
+    return set->byvalue ? left == right : set->cmp(left, right);
+}
+
+// Find the link pointing to the entry of a key, or to the end of its bucket
+static inline struct entry **hashset_find(
+    const struct hashset *set, u64 hash, const void *key
+) {
+    struct entry **link =
+        &set->entries[hashset_index(set, hash, set->nbuckets)];
+    // Compare the stored hashes first to skip most calls to the comparison
+    for (struct entry *entry; (entry = *link); link = &entry->next)
+        if (entry->hash == hash && hashset_eq(set, entry->key, key))
+            break;
+    return link;
+}
+
+// Check if a key with a given hash is in the set
+static inline bool hashset_has(
+    const struct hashset *set, u64 hash, const void *key
+) {
+    return set->nbuckets && *hashset_find(set, hash, key);
+}
+
+// Add a key known not to be in the set, without searching for it first
+static bool hashset_push(struct hashset *set, u64 hash, const void *key) {
+    // Grow the set if it would exceed its maximum load
+    if (set->nkeys + 1 > set->nbuckets * LOAD) {
+        usize capacity = set->nkeys ? set->nkeys * 2 : 1;
+        if (!hashset_reserve(set, capacity))
+            // Return `false` if unable to grow the set
+            return false;
+    }
+    // Allocate memory for the new entry
+    struct entry *entry = malloc(sizeof(struct entry));
+    if (!entry)
+        // Return `false` if memory allocation failed
+        return false;
+    // Link the entry at the head of its bucket
+    struct entry **bucket =
+        &set->entries[hashset_index(set, hash, set->nbuckets)];
+    *entry = (struct entry){
+        .key = key,
+        .hash = hash,
+        .next = *bucket,
+    };
+    *bucket = entry;
+    set->nkeys++;
+    return true;
+}
+
+// Create an empty set sharing the functions of another, presized for a given
+// number of keys
+static struct hashset *hashset_like(const struct hashset *set, usize capacity) {
+    struct hashset *out = hashset_new(set->hash, set->cmp);
+    if (!out)
+        // Return `NULL` if memory allocation failed
+        return NULL;
+    out->byvalue = set->byvalue;
+    if (!hashset_reserve(out, capacity)) {
+        // Return `NULL` if memory allocation failed
+        hashset_drop(out);
+        return NULL;
+    }
+    return out;
+}
+
+/**
+ * Create a new hash set.
+ *
+ * @param hash  Hash function for keys.
+ * @param cmp   Comparison function for keys.
+ * @return      Pointer to the newly-created hash set, or `NULL` if memory
+ *              allocation failed.
+ */
+struct hashset *hashset_new(
+    u64 (*hash)(const void *key),
+    bool (*cmp)(const void *left, const void *right)
+) {
+    // Allocate memory for the hash set
+    struct hashset *set = malloc(sizeof(struct hashset));
+    if (!set)
+        // Return `NULL` if memory allocation failed
+        return NULL;
+
+    // Initialize an empty hash set without any buckets
+    *set = (struct hashset){
+        .hash = hash,
+        .cmp = cmp,
+    };
+
+    // Return the newly-created hash set
+    return set;
+}
+
+/**
+ * Create a new hash set of 64-bit integers.
+ *
+ * @return  Pointer to the newly-created hash set, or `NULL` if memory
+ *          allocation failed.
+ */
+struct hashset *hashset_new_u64(void) {
+    // Create a hash set with the built-in hash and comparison functions
+    struct hashset *set = hashset_new(u64_hash, u64_cmp);
+    if (!set)
+        // Return `NULL` if memory allocation failed
+        return NULL;
+    // Store keys by value
+    set->byvalue = true;
+    // Return the newly-created hash set
+    return set;
+}
+
+/**
+ * Create a new hash set of pointers, compared by address.
+ *
+ * @return  Pointer to the newly-created hash set, or `NULL` if memory
+ *          allocation failed.
+ */
+struct hashset *hashset_new_ptr(void) {
+    // Pointers are stored by value, just like integers
+    return hashset_new_u64();
+}
+
+/**
+ * Set the destructor of the hash set's keys.
+ *
+ * @param set       Pointer to the hash set.
+ * @param key_free  Destructor for keys, or `NULL` to not free keys.
+ */
+void hashset_set_free(struct hashset *set, void (*key_free)(void *key)) {
+    if (!set)
+        // Return early if the hash set is `NULL`
+        return;
+    // Store the destructor
+    set->key_free = key_free;
+}
+
+/**
+ * Delete the hash set.
+ *
+ * @param set  Pointer to the hash set to delete.
+ */
+void hashset_drop(struct hashset *set) {
+    if (!set)
+        // Return early if the hash set is `NULL`
+        return;
+    // Free all entries in the hash set, along with their keys
+    hashset_clear(set);
+    free(set->entries);
+    free(set);
+}
+
+/**
+ * Remove every key from the hash set, keeping its capacity.
+ *
+ * @param set  Pointer to the hash set.
+ */
+void hashset_clear(struct hashset *set) {
+    if (!set)
+        // Return early if the hash set is `NULL`
+        return;
+    // Free all entries in the hash set, passing their keys to the destructor
+    for (usize i = 0; i < set->nbuckets; i++) {
+        struct entry *tmp, *entry = set->entries[i];
+        while (entry) {
+            tmp = entry;
+            entry = entry->next;
+            if (set->key_free)
+                set->key_free((void *)tmp->key);
+            free(tmp);
+        }
+        set->entries[i] = NULL;
+    }
+    set->nkeys = 0;
+}
+
+/**
+ * Insert a key into the hash set.
+ *
+ * @param set  Pointer to the hash set.
+ * @param key  Key to insert.
+ * @return     `true` if the operation was successful, `false` otherwise.
+ */
+bool hashset_insert(struct hashset *set, const void *key) {
+    if (!set)
+        // Return `false` if the hash set is `NULL`
+        return false;
+    u64 hash = hashset_hash(set, key);
+    struct entry *found = set->nbuckets ? *hashset_find(set, hash, key) : NULL;
+    if (found) {
+        // Destroy the unused new key, leaving the set unchanged
+        if (set->key_free && found->key != key)
+            set->key_free((void *)key);
+        return true;
+    }
+    // Add the new key
+    return hashset_push(set, hash, key);
+}
+
+/**
+ * Remove a key from the hash set.
+ *
+ * @param set  Pointer to the hash set.
+ * @param key  Key to remove.
+ * @return     `true` if the key was removed, `false` if it was not found.
+ */
+bool hashset_remove(struct hashset *set, const void *key) {
+    if (!set || !set->nbuckets)
+        // Return `false` if the hash set is `NULL` or empty
+        return false;
+
+    // Find the link to the entry of the key
+    struct entry **link = hashset_find(set, hashset_hash(set, key), key);
+    struct entry *entry = *link;
+    if (!entry)
+        // Return `false` if the key is not in the set
+        return false;
+
+    // Unlink and free the entry, along with its key
+    *link = entry->next;
+    if (set->key_free)
+        set->key_free((void *)entry->key);
+    free(entry);
+    set->nkeys--;
+    return true;
+}
+
+/**
+ * Check if a key is in the hash set.
+ *
+ * @param set  Pointer to the hash set.
+ * @param key  Key to search for.
+ * @return     `true` if the key exists in the set, `false` otherwise.
+ */
+bool hashset_contains(const struct hashset *set, const void *key) {
+    if (!set)
+        // Return `false` if the hash set is `NULL`
+        return false;
+    return hashset_has(set, hashset_hash(set, key), key);
+}
+
+/**
+ * Get the capacity of the hash set.
+ *
+ * @param set  Pointer to the hash set.
+ * @return     Number of keys the set can hold before it needs to be resized.
+ */
+usize hashset_capacity(const struct hashset *set) {
+    if (!set)
+        // Return 0 if the hash set is `NULL`
+        return 0;
+    return set->nbuckets * LOAD;
+}
+
+/**
+ * Get the number of keys in the hash set.
+ *
+ * @param set  Pointer to the hash set.
+ * @return     Number of keys in the hash set, or 0 if the set is `NULL`.
+ */
+usize hashset_len(const struct hashset *set) {
+    if (!set)
+        // Return 0 if the hash set is `NULL`
+        return 0;
+    return set->nkeys;
+}
+
+/**
+ * Reserve space for a given number of keys in the hash set.
+ *
+ * @param set       Pointer to the hash set.
+ * @param capacity  Number of keys to reserve space for.
+ * @return          `true` if the operation was successful, `false` otherwise.
+ */
+bool hashset_reserve(struct hashset *set, usize capacity) {
+    if (!set)
+        // Return `false` if the hash set is `NULL`
+        return false;
+
+    // Return early if the set can already hold the given number of keys
+    usize nbuckets = capacity / LOAD + 1;
+    if (nbuckets <= set->nbuckets)
+        return true;
+
+    // Allocate memory for the new array of linked lists
+    struct entry **entries = calloc(nbuckets, sizeof(struct entry *));
+    if (!entries)
+        return false;
+
+    // Move all existing entries into the new array of linked lists, using
+    // their stored hashes
+    for (usize i = 0; i < set->nbuckets; i++) {
+        struct entry *tmp, *entry = set->entries[i];
+        while (entry) {
+            usize index = hashset_index(set, entry->hash, nbuckets);
+            tmp = entry->next;
+            entry->next = entries[index];
+            entries[index] = entry;
+            entry = tmp;
+        }
+    }
+
+    // Replace the old array of linked lists
+    free(set->entries);
+    set->entries = entries;
+    set->nbuckets = nbuckets;
+
+    return true;
+}
+
+/**
+ * Iterate over the keys in the hash set.
+ *
+ * @param set       Pointer to the hash set.
+ * @param callback  Callback function to call for each key.
+ * @param context   User-defined context to pass to the callback function.
+ */
+void hashset_iter(
+    const struct hashset *set,
+    void (*callback)(const void *key, void *context),
+    void *context
+) {
+    if (!set || !callback)
+        // Return early if the hash set or callback is `NULL`
+        return;
+    // Iterate over the array of linked lists
+    for (usize i = 0; i < set->nbuckets; i++) {
+        for (struct entry *entry = set->entries[i]; entry; entry = entry->next)
+            callback(entry->key, context);
+    }
+}
+
+/*
+ * Set Algebra
+ */
+
+/**
+ * Create the union of two hash sets.
+ *
+ * @param left   Pointer to the left hash set.
+ * @param right  Pointer to the right hash set.
+ * @return       Pointer to a new set of the keys in either set, or `NULL` if
+ *               memory allocation failed.
+ */
+struct hashset *hashset_union(
+    const struct hashset *left, const struct hashset *right
+) {
+    if (!left || !right)
+        // Return `NULL` if either hash set is `NULL`
+        return NULL;
+    // Order the operands by size
+    const struct hashset *big = left->nkeys >= right->nkeys ? left : right;
+    const struct hashset *small = big == left ? right : left;
+
+    // Presize the result for both sets to be disjoint
+    struct hashset *out = hashset_like(left, big->nkeys + small->nkeys);
+    if (!out)
+        return NULL;
+
+    // Copy the larger set, whose keys are known to be distinct
+    for (usize i = 0; i < big->nbuckets; i++) {
+        for (struct entry *entry = big->entries[i]; entry; entry = entry->next)
+            if (!hashset_push(out, entry->hash, entry->key))
+                goto fail;
+    }
+    // Add each key of the smaller set missing from the larger set
+    for (usize i = 0; i < small->nbuckets; i++) {
+        for (struct entry *entry = small->entries[i]; entry;
+             entry = entry->next) {
+            if (hashset_has(big, entry->hash, entry->key))
+                continue;
+            if (!hashset_push(out, entry->hash, entry->key))
+                goto fail;
+        }
+    }
+    return out;
+
+fail:
+    // Return `NULL` if memory allocation failed
+    hashset_drop(out);
+    return NULL;
+}
+
+/**
+ * Create the intersection of two hash sets.
+ *
+ * @param left   Pointer to the left hash set.
+ * @param right  Pointer to the right hash set.
+ * @return       Pointer to a new set of the keys in both sets, or `NULL` if
+ *               memory allocation failed.
+ */
+struct hashset *hashset_intersection(
+    const struct hashset *left, const struct hashset *right
+) {
+    if (!left || !right)
+        // Return `NULL` if either hash set is `NULL`
+        return NULL;
+    // Order the operands by size
+    const struct hashset *big = left->nkeys >= right->nkeys ? left : right;
+    const struct hashset *small = big == left ? right : left;
+
+    // Presize the result for the smaller set to be contained in the larger
+    struct hashset *out = hashset_like(left, small->nkeys);
+    if (!out)
+        return NULL;
+
+    // Keep each key of the smaller set also in the larger set
+    for (usize i = 0; i < small->nbuckets; i++) {
+        for (struct entry *entry = small->entries[i]; entry;
+             entry = entry->next) {
+            if (!hashset_has(big, entry->hash, entry->key))
+                continue;
+            if (!hashset_push(out, entry->hash, entry->key)) {
+                // Return `NULL` if memory allocation failed
+                hashset_drop(out);
+                return NULL;
+            }
+        }
+    }
+    return out;
+}
+
+/**
+ * Create the difference of two hash sets.
+ *
+ * @param left   Pointer to the left hash set.
+ * @param right  Pointer to the right hash set.
+ * @return       Pointer to a new set of the keys in the left set but not the
+ *               right set, or `NULL` if memory allocation failed.
+ */
+struct hashset *hashset_difference(
+    const struct hashset *left, const struct hashset *right
+) {
+    if (!left || !right)
+        // Return `NULL` if either hash set is `NULL`
+        return NULL;
+
+    // Presize the result for the sets to be disjoint
+    struct hashset *out = hashset_like(left, left->nkeys);
+    if (!out)
+        return NULL;
+
+    // Keep each key of the left set missing from the right set. Every key of
+    // the left set must be visited, whichever set is smaller.
+    for (usize i = 0; i < left->nbuckets; i++) {
+        for (struct entry *entry = left->entries[i]; entry;
+             entry = entry->next) {
+            if (hashset_has(right, entry->hash, entry->key))
+                continue;
+            if (!hashset_push(out, entry->hash, entry->key)) {
+                // Return `NULL` if memory allocation failed
+                hashset_drop(out);
+                return NULL;
+            }
+        }
+    }
+    return out;
+}
+
+/**
+ * Check if every key of one hash set is in another.
+ *
+ * @param left   Pointer to the candidate subset.
+ * @param right  Pointer to the candidate superset.
+ * @return       `true` if every key of the left set is in the right set,
+ *               `false` otherwise.
+ */
+bool hashset_is_subset(
+    const struct hashset *left, const struct hashset *right
+) {
+    if (!left || !right)
+        // Return `false` if either hash set is `NULL`
+        return false;
+    if (left->nkeys > right->nkeys)
+        // Return `false` if the left set is too large to be a subset
+        return false;
+
+    // Check each key of the left set, which is now the smaller set
+    for (usize i = 0; i < left->nbuckets; i++) {
+        for (struct entry *entry = left->entries[i]; entry;
+             entry = entry->next) {
+            if (!hashset_has(right, entry->hash, entry->key))
+                return false;
+        }
+    }
+    return true;
+}
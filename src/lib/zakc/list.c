@@ -5,9 +5,11 @@
 
 #include "zakc/list.h"
 
+#include <stdint.h> // for uintptr_t
 #include <stdlib.h> // for free, malloc
 
-#include "zakc/types.h" // for usize
+#include "zakc/types.h"  // for i32, usize
+#include "zakc/vector.h" // for vector, vector_{array,from_raw,len}
 
 // Linked list structure
 struct list {
@@ -17,6 +19,18 @@ struct list {
     struct node *tail;
     // Number of items in the list
     usize len;
+    // Destructor for data, or `NULL` if data is not owned by the list
+    void (*data_free)(void *data);
+    // Block of nodes allocated at once by `vector_to_list()`, or the pool of
+    // a fixed-capacity list
+    struct node *slab;
+    // Number of nodes in the block
+    usize nslab;
+    // Unused nodes of the pool, linked through their `next` pointers
+    struct node *spare;
+    // Whether the list lives in caller-provided memory, and takes every node
+    // from its pool
+    bool fixed;
 };
 
 // Linked list node structure
@@ -29,6 +43,35 @@ struct node {
     void *data;
 };
 
+_Static_assert(
+    sizeof(struct list) <= LIST_SIZEOF(0)
+        && sizeof(struct node) <= LIST_SIZEOF(1) - LIST_SIZEOF(0),
+    "LIST_SIZEOF is too small"
+);
+
+// Allocate a node, taking it from the pool of a fixed-capacity list
+static inline struct node *list_alloc_node(struct list *list) {
+    if (!list->fixed)
+        return malloc(sizeof(struct node));
+    struct node *node = list->spare;
+    if (node)
+        list->spare = node->next;
+    return node;
+}
+
+// Free a node, unless it belongs to the block allocated by a conversion, or
+// return it to the pool of a fixed-capacity list
+static inline void list_free_node(struct list *list, struct node *node) {
+    uintptr_t addr = (uintptr_t)node;
+    uintptr_t slab = (uintptr_t)list->slab;
+    if (addr - slab >= list->nslab * sizeof(struct node)) {
+        free(node);
+    } else if (list->fixed) {
+        node->next = list->spare;
+        list->spare = node;
+    }
+}
+
 /**
  * Create a new linked list.
  *
@@ -52,6 +95,53 @@ struct list *list_new(void) {
     return list;
 }
 
+/**
+ * Create a new fixed-capacity linked list in caller-provided memory.
+ *
+ * @param buf    Pointer to the buffer.
+ * @param bytes  Size of the buffer, in bytes.
+ * @return       Pointer to the linked list, which is at the start of the
+ *               buffer, or `NULL` if the buffer is `NULL`, misaligned or too
+ *               small to hold the list.
+ */
+struct list *list_init_in(void *buf, usize bytes) {
+    if (!buf || (uintptr_t)buf % _Alignof(struct list)
+        || bytes < sizeof(struct list))
+        // Return `NULL` if the buffer cannot hold a linked list
+        return NULL;
+    struct list *list = buf;
+
+    // Initialize the linked list, with the rest of the buffer as its pool
+    usize nslab = (bytes - sizeof(struct list)) / sizeof(struct node);
+    *list = (struct list){
+        .head = NULL,
+        .tail = NULL,
+        .len = 0,
+        .slab = nslab ? (struct node *)(list + 1) : NULL,
+        .nslab = nslab,
+        .fixed = true,
+    };
+    // Link every node of the pool as unused
+    for (usize i = nslab; i > 0; i--)
+        list_free_node(list, &list->slab[i - 1]);
+
+    return list;
+}
+
+/**
+ * Set the destructor of the linked list's data.
+ *
+ * @param list       Pointer to the linked list.
+ * @param data_free  Destructor for data, or `NULL` to not free data.
+ */
+void list_set_free(struct list *list, void (*data_free)(void *data)) {
+    if (!list)
+        // Return early if the list is `NULL`
+        return;
+    // Store the destructor
+    list->data_free = data_free;
+}
+
 /**
  * Delete the linked list.
  *
@@ -62,16 +152,45 @@ void list_drop(struct list *list) {
         // Return early if the list is `NULL`
         return;
 
-    // Iterate over the linked list and free each node
+    // Free each node, along with its data
+    list_clear(list);
+
+    // Free the linked list, unless it lives in caller-provided memory
+    if (!list->fixed)
+        free(list);
+}
+
+/**
+ * Remove every item from the linked list.
+ *
+ * @param list  Pointer to the linked list.
+ */
+void list_clear(struct list *list) {
+    if (!list)
+        // Return early if the list is `NULL`
+        return;
+
+    // Iterate over the linked list and free each node, passing its data to
+    // the destructor in the same pass
     struct node *curr = list->head;
     while (curr) {
         struct node *next = curr->next;
-        free(curr);
+        if (list->data_free)
+            list->data_free(curr->data);
+        list_free_node(list, curr);
         curr = next;
     }
+    if (!list->fixed) {
+        // Free the block of nodes only once no node can be found within it
+        free(list->slab);
+        list->slab = NULL;
+        list->nslab = 0;
+    }
 
-    // Free the linked list
-    free(list);
+    // Reset the linked list to be empty
+    list->head = NULL;
+    list->tail = NULL;
+    list->len = 0;
 }
 
 /**
@@ -87,7 +206,7 @@ bool list_append(struct list *list, void *data) {
         return false;
 
     // Create a new node for the data
-    struct node *node = malloc(sizeof(struct node));
+    struct node *node = list_alloc_node(list);
     if (!node)
         // Return `false` if unable to allocate another node
         return false;
@@ -125,7 +244,7 @@ bool list_prepend(struct list *list, void *data) {
         return false;
 
     // Create a new node for the data
-    struct node *node = malloc(sizeof(struct node));
+    struct node *node = list_alloc_node(list);
     if (!node)
         // Return `false` if unable to allocate another node
         return false;
@@ -175,7 +294,7 @@ void *list_pop(struct list *list) {
         list->head = NULL;
 
     // Free the node and update the length of the linked list
-    free(last);
+    list_free_node(list, last);
     list->len--;
 
     return data;
@@ -205,7 +324,7 @@ void *list_shift(struct list *list) {
         list->tail = NULL;
 
     // Free the node and update the length of the linked list
-    free(first);
+    list_free_node(list, first);
     list->len--;
 
     return data;
@@ -225,7 +344,7 @@ bool list_insert(struct list *list, usize index, void *data) {
         return false;
 
     // Create a new node for the data
-    struct node *node = malloc(sizeof(struct node));
+    struct node *node = list_alloc_node(list);
     if (!node)
         // Return `false` if unable to allocate another node
         return false;
@@ -297,12 +416,280 @@ void *list_remove(struct list *list, usize index) {
         list->tail = node->prev;
 
     // Free the node and update the length of the linked list
-    free(node);
+    list_free_node(list, node);
     list->len--;
 
     return data;
 }
 
+/**
+ * Keep only the items of the linked list which satisfy a predicate.
+ *
+ * @param list     Pointer to the linked list.
+ * @param pred     Predicate which returns `true` for items to keep.
+ * @param context  User-defined context to pass to the predicate.
+ * @return         `true` if the operation was successful, `false` otherwise.
+ */
+bool list_retain(
+    struct list *list, bool (*pred)(void *data, void *context), void *context
+) {
+    if (!list || !pred)
+        // Return `false` if the list or predicate is `NULL`
+        return false;
+
+    // Unlink and free each node which is not kept, in a single pass
+    struct node *node = list->head;
+    while (node) {
+        struct node *next = node->next;
+        if (!pred(node->data, context)) {
+            if (node->prev)
+                node->prev->next = next;
+            else
+                list->head = next;
+            if (next)
+                next->prev = node->prev;
+            else
+                list->tail = node->prev;
+            if (list->data_free)
+                list->data_free(node->data);
+            list_free_node(list, node);
+            list->len--;
+        }
+        node = next;
+    }
+
+    return true;
+}
+
+// Maximum number of pending runs of a sort, enough for 2^64 runs
+#define RUNS 64
+// Minimum length of a run, to which shorter runs are extended by insertion
+#define MIN_RUN 16
+
+// Merge two sorted chains of nodes linked only by `next`, taking nodes from
+// the left chain first when they compare equal
+static struct node *list_merge_chains(
+    struct node *left,
+    struct node *right,
+    i32 (*cmp)(const void *left, const void *right)
+) {
+    struct node head;
+    struct node *tail = &head;
+    while (left && right) {
+        if (cmp(right->data, left->data) < 0) {
+            tail->next = right;
+            right = right->next;
+        } else {
+            tail->next = left;
+            left = left->next;
+        }
+        tail = tail->next;
+    }
+    tail->next = left ? left : right;
+    return head.next;
+}
+
+// Restore the `prev` pointers and tail of a list relinked by `next` only
+static void list_relink(struct list *list, struct node *head) {
+    struct node *prev = NULL;
+    list->head = head;
+    for (struct node *node = head; node; node = node->next) {
+        node->prev = prev;
+        prev = node;
+    }
+    list->tail = prev;
+}
+
+/**
+ * Sort the linked list.
+ *
+ * @param list  Pointer to the linked list.
+ * @param cmp   Comparison function for data.
+ * @return      `true` if the operation was successful, `false` otherwise.
+ */
+bool list_sort(
+    struct list *list, i32 (*cmp)(const void *left, const void *right)
+) {
+    if (!list || !cmp)
+        // Return `false` if the list or comparison function is `NULL`
+        return false;
+
+    // Split the list into natural runs, merging them as in a binary counter,
+    // where slot `i` holds the merge of `2^i` runs (all earlier in the list
+    // than any run in a lower slot)
+    struct node *pending[RUNS] = {NULL};
+    struct node *node = list->head;
+    while (node) {
+        struct node *run = node;
+        struct node *next = node->next;
+        usize len = 1;
+        if (next && cmp(next->data, node->data) < 0) {
+            // Reverse a strictly descending run, which keeps the sort stable
+            node->next = NULL;
+            while (next && cmp(next->data, run->data) < 0) {
+                struct node *after = next->next;
+                next->next = run;
+                run = next;
+                next = after;
+                len++;
+            }
+        } else {
+            // Take an ascending run as it is
+            struct node *last = node;
+            while (next && cmp(next->data, last->data) >= 0) {
+                last = next;
+                next = next->next;
+                len++;
+            }
+            last->next = NULL;
+        }
+        // Extend a short run by inserting the following nodes into it, as
+        // each level of merging visits every node in a scattered order
+        for (; len < MIN_RUN && next; len++) {
+            struct node *after = next->next;
+            struct node **link = &run;
+            while (*link && cmp(next->data, (*link)->data) >= 0)
+                link = &(*link)->next;
+            next->next = *link;
+            *link = next;
+            next = after;
+        }
+        // Carry the run into the first empty slot
+        usize i = 0;
+        for (; pending[i]; i++) {
+            run = list_merge_chains(pending[i], run, cmp);
+            pending[i] = NULL;
+        }
+        pending[i] = run;
+        node = next;
+    }
+
+    // Merge the pending runs, from the latest to the earliest
+    struct node *head = NULL;
+    for (usize i = 0; i < RUNS; i++)
+        if (pending[i])
+            head = head ? list_merge_chains(pending[i], head, cmp) : pending[i];
+    list_relink(list, head);
+
+    return true;
+}
+
+// Replace the nodes of one linked list with copies allocated by another, so
+// that they can be linked into the other list, or leave both lists as they
+// are if allocation fails
+static bool list_take_nodes(struct list *dst, struct list *src) {
+    // Copy every node of the source
+    struct node *head = NULL;
+    struct node *tail = NULL;
+    for (const struct node *node = src->head; node; node = node->next) {
+        struct node *copy = list_alloc_node(dst);
+        if (!copy) {
+            // Give back the copies made so far
+            while (head) {
+                struct node *next = head->next;
+                list_free_node(dst, head);
+                head = next;
+            }
+            return false;
+        }
+        *copy = (struct node){
+            .prev = tail,
+            .next = NULL,
+            .data = node->data,
+        };
+        if (tail)
+            tail->next = copy;
+        else
+            head = copy;
+        tail = copy;
+    }
+
+    // Free the source's own nodes, keeping their data
+    struct node *node = src->head;
+    while (node) {
+        struct node *next = node->next;
+        list_free_node(src, node);
+        node = next;
+    }
+    if (!src->fixed)
+        // Free the source's block of nodes, which are no longer in use
+        free(src->slab);
+    src->head = head;
+    src->tail = tail;
+    return true;
+}
+
+/**
+ * Merge a sorted linked list into another, leaving it empty.
+ *
+ * @param dst  Pointer to the sorted linked list to merge into.
+ * @param src  Pointer to the sorted linked list to merge from.
+ * @param cmp  Comparison function for data.
+ * @return     `true` if the operation was successful, `false` otherwise.
+ */
+bool list_merge(
+    struct list *dst,
+    struct list *src,
+    i32 (*cmp)(const void *left, const void *right)
+) {
+    if (!dst || !src || !cmp)
+        // Return `false` if either list or the comparison function is `NULL`
+        return false;
+    if (dst == src || !src->head)
+        // Return early if there is nothing to merge
+        return true;
+
+    if (dst->fixed || src->fixed) {
+        // Copy the source's data into nodes of the destination, as neither
+        // list may keep nodes that belong to the other
+        if (!list_take_nodes(dst, src))
+            // Return `false` if the destination ran out of nodes
+            return false;
+    } else if (src->slab && dst->slab) {
+        // Move the nodes of the source's block into nodes of their own, as
+        // the destination can only keep track of one block
+        for (struct node *node = src->head; node; node = node->next) {
+            uintptr_t offset = (uintptr_t)node - (uintptr_t)src->slab;
+            if (offset >= src->nslab * sizeof(struct node))
+                continue;
+            struct node *copy = malloc(sizeof(struct node));
+            if (!copy)
+                // Return `false` if memory allocation failed
+                return false;
+            *copy = *node;
+            if (copy->prev)
+                copy->prev->next = copy;
+            else
+                src->head = copy;
+            if (copy->next)
+                copy->next->prev = copy;
+            else
+                src->tail = copy;
+            node = copy;
+        }
+        free(src->slab);
+    } else if (src->slab) {
+        // Hand the source's block over to the destination
+        dst->slab = src->slab;
+        dst->nslab = src->nslab;
+    }
+
+    // Relink the nodes of both lists into one
+    list_relink(dst, list_merge_chains(dst->head, src->head, cmp));
+    dst->len += src->len;
+
+    // Leave the source empty, keeping the pool of a fixed-capacity list
+    src->head = NULL;
+    src->tail = NULL;
+    src->len = 0;
+    if (!src->fixed) {
+        src->slab = NULL;
+        src->nslab = 0;
+    }
+
+    return true;
+}
+
 /**
  * Reverse the linked list.
  *
@@ -399,6 +786,9 @@ bool list_set(struct list *list, usize index, void *data) {
     for (usize i = 0; i < index; i++)
         node = node->next;
 
+    // Destroy the data being replaced, unless it is being set again
+    if (list->data_free && node->data != data)
+        list->data_free(node->data);
     // Update the data stored in the node
     node->data = data;
 
@@ -420,3 +810,80 @@ usize list_len(const struct list *list) {
     // Return the length of the linked list
     return list->len;
 }
+
+/**
+ * Create a vector holding the items of the linked list.
+ *
+ * @param list  Pointer to the linked list.
+ * @return      Pointer to the newly-created vector, or `NULL` if the list is
+ *              `NULL` or memory allocation failed.
+ */
+struct vector *list_to_vector(const struct list *list) {
+    if (!list)
+        // Return `NULL` if the list is `NULL`
+        return NULL;
+
+    // Copy the data of each node into an array of exactly the right size
+    usize len = list->len;
+    void **data = len ? malloc(len * sizeof(void *)) : NULL;
+    if (len && !data)
+        // Return `NULL` if memory allocation failed
+        return NULL;
+    usize i = 0;
+    for (const struct node *node = list->head; node; node = node->next)
+        data[i++] = node->data;
+
+    // Hand the array over to a new vector
+    struct vector *vec = vector_from_raw(data, len, len);
+    if (!vec)
+        // Free the array if memory allocation failed
+        free(data);
+    return vec;
+}
+
+/**
+ * Create a linked list holding the elements of a vector.
+ *
+ * @param vec  Pointer to the vector.
+ * @return     Pointer to the newly-created linked list, or `NULL` if the
+ *             vector is `NULL` or memory allocation failed.
+ */
+struct list *vector_to_list(const struct vector *vec) {
+    if (!vec)
+        // Return `NULL` if the vector is `NULL`
+        return NULL;
+
+    // Create an empty linked list
+    struct list *list = list_new();
+    if (!list)
+        // Return `NULL` if memory allocation failed
+        return NULL;
+    usize len = vector_len(vec);
+    if (!len)
+        // Return early if there are no elements to convert
+        return list;
+
+    // Allocate every node as a single block
+    struct node *nodes = malloc(len * sizeof(struct node));
+    if (!nodes) {
+        // Return `NULL` if memory allocation failed
+        free(list);
+        return NULL;
+    }
+
+    // Link the nodes in order, so that the list is contiguous in memory
+    void **data = vector_array(vec);
+    for (usize i = 0; i < len; i++)
+        nodes[i] = (struct node){
+            .prev = i ? &nodes[i - 1] : NULL,
+            .next = i + 1 < len ? &nodes[i + 1] : NULL,
+            .data = data[i],
+        };
+    list->head = &nodes[0];
+    list->tail = &nodes[len - 1];
+    list->len = len;
+    list->slab = nodes;
+    list->nslab = len;
+
+    return list;
+}
@@ -0,0 +1,70 @@
+// File:        phash.c
+// Author:      Zakhary Kaplan <https://zakhary.dev>
+// Created:     17 Oct 2026
+// SPDX-License-Identifier: MIT
+
+#include "zakc/phash.h"
+
+#include <string.h> // for strcmp
+
+#include "zakc/types.h" // for u32, u64, usize
+
+// Find the slot a key would occupy, returning the number of slots if the key
+// is not in the table
+static usize phash_find(const struct phash *table, const char *key) {
+    if (!table || !key || table->len == 0)
+        // Return the number of slots if there is nothing to find
+        return table ? table->len : 0;
+    // Hash the key once to find its bucket, then its slot
+    u64 hash = phash_hash(key);
+    u32 seed = table->seeds[phash_bucket(hash, table->nbuckets)];
+    usize slot = phash_slot(hash, seed, table->len);
+    // Compare the key against the only one it could be
+    return strcmp(table->keys[slot], key) == 0 ? slot : table->len;
+}
+
+/**
+ * Get the position of a key within the list the table was generated from.
+ *
+ * @param table  Pointer to the table.
+ * @param key    Key to look up.
+ * @return       Position of the key, or the number of keys in the table if
+ *               the table or key is `NULL` or the key was not found.
+ */
+usize phash_index(const struct phash *table, const char *key) {
+    usize slot = phash_find(table, key);
+    if (!table || slot == table->len)
+        // Return the number of keys if the key was not found
+        return slot;
+    // Return the position of the key in its slot
+    return table->ranks[slot];
+}
+
+/**
+ * Check if a key is in the table.
+ *
+ * @param table  Pointer to the table.
+ * @param key    Key to search for.
+ * @return       `true` if the key exists in the table, `false` otherwise.
+ */
+bool phash_contains(const struct phash *table, const char *key) {
+    return table && phash_find(table, key) != table->len;
+}
+
+/**
+ * Get the data associated with a key in the table.
+ *
+ * @param table  Pointer to the table.
+ * @param key    Key to look up.
+ * @return       Pointer to the data associated with the key, or `NULL` if the
+ *               table or key is `NULL`, the table has no data, or the key was
+ *               not found.
+ */
+void *phash_get(const struct phash *table, const char *key) {
+    if (!table || !table->values)
+        // Return `NULL` if the table is `NULL` or has no data
+        return NULL;
+    usize slot = phash_find(table, key);
+    // Return the data in the key's slot, if it was found
+    return slot == table->len ? NULL : table->values[slot];
+}
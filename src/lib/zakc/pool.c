@@ -0,0 +1,574 @@
+// File:        pool.c
+// Author:      Zakhary Kaplan <https://zakhary.dev>
+// Created:     17 Oct 2026
+// SPDX-License-Identifier: MIT
+
+#define _GNU_SOURCE // for CPU_*, pthread_setaffinity_np, sched_getaffinity
+
+#include "zakc/pool.h"
+
+#include <pthread.h>   // for pthread_*
+#include <sched.h>     // for cpu_set_t, sched_{getaffinity,yield}
+#include <stdatomic.h> // for atomic_*
+#include <stdlib.h>    // for aligned_alloc, calloc, free, malloc
+#include <string.h>    // for memset
+#include <unistd.h>    // for sysconf
+
+#include "zakc/list.h"  // for list
+#include "zakc/types.h" // for isize, u64, usize
+
+// Initial capacity of each deque
+#define DEQUE_CAPACITY 64
+// Number of failed steal attempts before a worker goes to sleep
+#define IDLE_SPINS 64
+
+// Task structure
+struct task {
+    // Function to run
+    void (*func)(void *arg);
+    // Argument to pass to the function
+    void *arg;
+    // Whether the task has finished
+    atomic_bool done;
+};
+
+// Circular buffer of a deque
+struct buffer {
+    // Capacity of the buffer, as a power of two
+    isize capacity;
+    // Previous (smaller) buffer, kept alive for concurrent thieves
+    struct buffer *prev;
+    // Slots of the buffer
+    _Atomic(struct task *) slots[];
+};
+
+// Work-stealing (Chase-Lev) deque structure
+struct deque {
+    // Index of the next task to steal
+    _Alignas(64) atomic_long top;
+    // Index one past the last task pushed
+    _Alignas(64) atomic_long bottom;
+    // Circular buffer of tasks
+    _Atomic(struct buffer *) buffer;
+};
+
+// Worker structure
+struct worker {
+    // Thread pool of the worker
+    struct pool *pool;
+    // Deque of tasks owned by the worker
+    struct deque deque;
+    // Thread running the worker
+    pthread_t thread;
+    // Index of the worker in the pool
+    usize id;
+    // State of the random number generator used to pick victims
+    u64 seed;
+};
+
+// Thread pool structure
+struct pool {
+    // Array of workers
+    struct worker *workers;
+    // Number of workers
+    usize nthreads;
+    // Queue of tasks spawned from outside the pool
+    struct list *inject;
+    // Number of tasks waiting to be run
+    atomic_size_t queued;
+    // Number of sleeping workers
+    atomic_size_t sleepers;
+    // Whether the pool is shutting down
+    atomic_bool shutdown;
+    // Lock protecting the shared queue and sleeping workers
+    pthread_mutex_t lock;
+    // Condition signalled when tasks are queued
+    pthread_cond_t wake;
+};
+
+// Worker running on the current thread, if any
+static _Thread_local struct worker *current = NULL;
+
+// Allocate a buffer with the given capacity
+static struct buffer *buffer_new(isize capacity, struct buffer *prev) {
+    struct buffer *buf =
+        malloc(sizeof(struct buffer) + capacity * sizeof(struct task *));
+    if (!buf)
+        return NULL;
+    buf->capacity = capacity;
+    buf->prev = prev;
+    return buf;
+}
+
+// Initialize an empty deque
+static bool deque_init(struct deque *deque) {
+    struct buffer *buf = buffer_new(DEQUE_CAPACITY, NULL);
+    if (!buf)
+        return false;
+    atomic_init(&deque->top, 0);
+    atomic_init(&deque->bottom, 0);
+    atomic_init(&deque->buffer, buf);
+    return true;
+}
+
+// Free the buffers of a deque
+static void deque_free(struct deque *deque) {
+    struct buffer *buf = atomic_load(&deque->buffer);
+    while (buf) {
+        struct buffer *prev = buf->prev;
+        free(buf);
+        buf = prev;
+    }
+}
+
+// Push a task onto the bottom of a deque (owner only)
+static bool deque_push(struct deque *deque, struct task *task) {
+    isize b = atomic_load_explicit(&deque->bottom, memory_order_relaxed);
+    isize t = atomic_load_explicit(&deque->top, memory_order_acquire);
+    struct buffer *buf =
+        atomic_load_explicit(&deque->buffer, memory_order_relaxed);
+    if (b - t > buf->capacity - 1) {
+        // Grow the buffer, keeping the old one alive for thieves
+        struct buffer *next = buffer_new(buf->capacity * 2, buf);
+        if (!next)
+            return false;
+        for (isize i = t; i < b; i++) {
+            struct task *tmp = atomic_load_explicit(
+                &buf->slots[i & (buf->capacity - 1)], memory_order_relaxed
+            );
+            atomic_store_explicit(
+                &next->slots[i & (next->capacity - 1)],
+                tmp,
+                memory_order_relaxed
+            );
+        }
+        atomic_store_explicit(&deque->buffer, next, memory_order_release);
+        buf = next;
+    }
+    atomic_store_explicit(
+        &buf->slots[b & (buf->capacity - 1)], task, memory_order_release
+    );
+    atomic_thread_fence(memory_order_release);
+    atomic_store_explicit(&deque->bottom, b + 1, memory_order_relaxed);
+    return true;
+}
+
+// Take a task from the bottom of a deque (owner only)
+static struct task *deque_take(struct deque *deque) {
+    isize b = atomic_load_explicit(&deque->bottom, memory_order_relaxed) - 1;
+    struct buffer *buf =
+        atomic_load_explicit(&deque->buffer, memory_order_relaxed);
+    atomic_store_explicit(&deque->bottom, b, memory_order_relaxed);
+    atomic_thread_fence(memory_order_seq_cst);
+    isize t = atomic_load_explicit(&deque->top, memory_order_relaxed);
+    if (t > b) {
+        // Restore the bottom if the deque was empty
+        atomic_store_explicit(&deque->bottom, b + 1, memory_order_relaxed);
+        return NULL;
+    }
+    struct task *task = atomic_load_explicit(
+        &buf->slots[b & (buf->capacity - 1)], memory_order_relaxed
+    );
+    if (t == b) {
+        // Race against thieves for the last task
+        if (!atomic_compare_exchange_strong_explicit(
+                &deque->top,
+                &t,
+                t + 1,
+                memory_order_seq_cst,
+                memory_order_relaxed
+            ))
+            task = NULL;
+        atomic_store_explicit(&deque->bottom, b + 1, memory_order_relaxed);
+    }
+    return task;
+}
+
+// Steal a task from the top of a deque (any thread)
+static struct task *deque_steal(struct deque *deque) {
+    isize t = atomic_load_explicit(&deque->top, memory_order_acquire);
+    atomic_thread_fence(memory_order_seq_cst);
+    isize b = atomic_load_explicit(&deque->bottom, memory_order_acquire);
+    if (t >= b)
+        // Return `NULL` if the deque is empty
+        return NULL;
+    struct buffer *buf =
+        atomic_load_explicit(&deque->buffer, memory_order_acquire);
+    struct task *task = atomic_load_explicit(
+        &buf->slots[t & (buf->capacity - 1)], memory_order_acquire
+    );
+    if (!atomic_compare_exchange_strong_explicit(
+            &deque->top, &t, t + 1, memory_order_seq_cst, memory_order_relaxed
+        ))
+        // Return `NULL` if another thread won the race
+        return NULL;
+    return task;
+}
+
+// Run a task, marking it as done
+static void task_run(struct pool *pool, struct task *task) {
+    atomic_fetch_sub_explicit(&pool->queued, 1, memory_order_relaxed);
+    task->func(task->arg);
+    atomic_store_explicit(&task->done, true, memory_order_release);
+}
+
+// Wake a sleeping worker if there are any
+static void pool_notify(struct pool *pool) {
+    if (atomic_load_explicit(&pool->sleepers, memory_order_seq_cst)) {
+        pthread_mutex_lock(&pool->lock);
+        pthread_cond_signal(&pool->wake);
+        pthread_mutex_unlock(&pool->lock);
+    }
+}
+
+// Find a task to run from the perspective of the given worker (or `NULL`)
+static struct task *pool_find(struct pool *pool, struct worker *self) {
+    struct task *task;
+    // Check the worker's own deque first
+    if (self && (task = deque_take(&self->deque)))
+        return task;
+    // Try to steal from a random victim, then each of the others
+    u64 seed = self ? self->seed : (u64)(usize)&task;
+    seed ^= seed << 13;
+    seed ^= seed >> 7;
+    seed ^= seed << 17;
+    if (self)
+        self->seed = seed;
+    for (usize i = 0; i < pool->nthreads; i++) {
+        struct worker *victim = &pool->workers[(seed + i) % pool->nthreads];
+        if (victim != self && (task = deque_steal(&victim->deque)))
+            return task;
+    }
+    // Check the shared queue
+    if (atomic_load_explicit(&pool->queued, memory_order_relaxed)) {
+        pthread_mutex_lock(&pool->lock);
+        task = list_shift(pool->inject);
+        pthread_mutex_unlock(&pool->lock);
+        return task;
+    }
+    return NULL;
+}
+
+// Main loop of a worker thread
+static void *worker_main(void *arg) {
+    struct worker *self = arg;
+    struct pool *pool = self->pool;
+    current = self;
+
+    usize idle = 0;
+    while (!atomic_load_explicit(&pool->shutdown, memory_order_acquire)) {
+        struct task *task = pool_find(pool, self);
+        if (task) {
+            task_run(pool, task);
+            idle = 0;
+            continue;
+        }
+        if (++idle < IDLE_SPINS) {
+            sched_yield();
+            continue;
+        }
+        // Sleep until more tasks are queued
+        pthread_mutex_lock(&pool->lock);
+        atomic_fetch_add_explicit(&pool->sleepers, 1, memory_order_seq_cst);
+        if (!atomic_load_explicit(&pool->queued, memory_order_seq_cst) &&
+            !atomic_load_explicit(&pool->shutdown, memory_order_seq_cst))
+            pthread_cond_wait(&pool->wake, &pool->lock);
+        atomic_fetch_sub_explicit(&pool->sleepers, 1, memory_order_seq_cst);
+        pthread_mutex_unlock(&pool->lock);
+        idle = 0;
+    }
+    return NULL;
+}
+
+#ifdef __linux__
+// Pin a worker to its own CPU, chosen by its index among the allowed CPUs
+static bool worker_pin(struct worker *worker, const cpu_set_t *allowed) {
+    usize nth = worker->id % (usize)CPU_COUNT(allowed);
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    for (usize cpu = 0; cpu < CPU_SETSIZE; cpu++) {
+        if (CPU_ISSET(cpu, allowed) && nth-- == 0) {
+            CPU_SET(cpu, &set);
+            break;
+        }
+    }
+    return !pthread_setaffinity_np(worker->thread, sizeof(set), &set);
+}
+#endif
+
+// Stop the first `started` workers, then free the thread pool
+static void pool_stop(struct pool *pool, usize started) {
+    // Wake and stop each of the started workers
+    pthread_mutex_lock(&pool->lock);
+    atomic_store(&pool->shutdown, true);
+    pthread_cond_broadcast(&pool->wake);
+    pthread_mutex_unlock(&pool->lock);
+    for (usize i = 0; i < started; i++)
+        pthread_join(pool->workers[i].thread, NULL);
+    // Free the deques of every worker
+    for (usize i = 0; i < pool->nthreads; i++)
+        deque_free(&pool->workers[i].deque);
+    // Free the thread pool
+    pthread_cond_destroy(&pool->wake);
+    pthread_mutex_destroy(&pool->lock);
+    list_drop(pool->inject);
+    free(pool->workers);
+    free(pool);
+}
+
+/**
+ * Create a new thread pool.
+ *
+ * @param nthreads  Number of worker threads, or 0 to use one per online CPU.
+ * @param pin       Whether to pin each worker thread to its own CPU, chosen
+ *                  among those the calling thread may run on.
+ * @return          Pointer to the newly-created thread pool, or `NULL` if
+ *                  memory allocation, thread creation, or pinning failed.
+ */
+struct pool *pool_new(usize nthreads, bool pin) {
+    if (nthreads == 0) {
+        // Use one worker per online CPU
+        long ncpus = sysconf(_SC_NPROCESSORS_ONLN);
+        nthreads = ncpus > 0 ? (usize)ncpus : 1;
+    }
+#ifdef __linux__
+    // Find the CPUs the workers may be pinned to
+    cpu_set_t allowed;
+    if (pin && sched_getaffinity(0, sizeof(allowed), &allowed))
+        // Return `NULL` if unable to get the allowed CPUs
+        return NULL;
+#endif
+
+    // Allocate memory for the thread pool and its workers
+    struct pool *pool = calloc(1, sizeof(struct pool));
+    if (!pool)
+        // Return `NULL` if memory allocation failed
+        return NULL;
+    pool->workers = aligned_alloc(
+        _Alignof(struct worker), nthreads * sizeof(struct worker)
+    );
+    pool->inject = list_new();
+    if (!pool->workers || !pool->inject) {
+        // Clean up if memory allocation failed
+        free(pool->workers);
+        list_drop(pool->inject);
+        free(pool);
+        return NULL;
+    }
+    memset(pool->workers, 0, nthreads * sizeof(struct worker));
+    atomic_init(&pool->queued, 0);
+    atomic_init(&pool->sleepers, 0);
+    atomic_init(&pool->shutdown, false);
+    pthread_mutex_init(&pool->lock, NULL);
+    pthread_cond_init(&pool->wake, NULL);
+
+    // Initialize each of the workers before any of them start stealing
+    pool->nthreads = nthreads;
+    for (usize i = 0; i < nthreads; i++) {
+        struct worker *worker = &pool->workers[i];
+        worker->pool = pool;
+        worker->id = i;
+        worker->seed = 0x9e3779b97f4a7c15 * (i + 1);
+        if (!deque_init(&worker->deque)) {
+            // Clean up if memory allocation failed
+            pool_stop(pool, 0);
+            return NULL;
+        }
+    }
+
+    // Start each of the workers
+    for (usize i = 0; i < nthreads; i++) {
+        struct worker *worker = &pool->workers[i];
+        if (pthread_create(&worker->thread, NULL, worker_main, worker)) {
+            // Stop the workers started so far
+            pool_stop(pool, i);
+            return NULL;
+        }
+#ifdef __linux__
+        if (pin && !worker_pin(worker, &allowed)) {
+            // Stop the workers started so far, including this one
+            pool_stop(pool, i + 1);
+            return NULL;
+        }
+#endif
+    }
+
+    // Return the newly-created thread pool
+    return pool;
+}
+
+/**
+ * Delete the thread pool.
+ *
+ * @param pool  Pointer to the thread pool to delete.
+ */
+void pool_drop(struct pool *pool) {
+    if (!pool)
+        // Return early if the thread pool is `NULL`
+        return;
+    // Stop each of the workers
+    pool_stop(pool, pool->nthreads);
+}
+
+/**
+ * Get the number of worker threads in the thread pool.
+ *
+ * @param pool  Pointer to the thread pool.
+ * @return      The number of worker threads, or 0 if the pool is `NULL`.
+ */
+usize pool_nthreads(const struct pool *pool) {
+    if (!pool)
+        // Return 0 if the thread pool is `NULL`
+        return 0;
+    // Return the number of workers
+    return pool->nthreads;
+}
+
+/**
+ * Spawn (fork) a task on the thread pool.
+ *
+ * @param pool  Pointer to the thread pool.
+ * @param func  Function to run.
+ * @param arg   Argument to pass to the function.
+ * @return      Pointer to the spawned task, or `NULL` if memory allocation
+ *              failed.
+ */
+struct task *pool_spawn(struct pool *pool, void (*func)(void *arg), void *arg) {
+    if (!pool || !func)
+        // Return `NULL` if the thread pool or function is `NULL`
+        return NULL;
+
+    // Allocate memory for the task
+    struct task *task = malloc(sizeof(struct task));
+    if (!task)
+        return NULL;
+    task->func = func;
+    task->arg = arg;
+    atomic_init(&task->done, false);
+
+    // Push the task onto the current worker's deque, or the shared queue
+    atomic_fetch_add_explicit(&pool->queued, 1, memory_order_seq_cst);
+    bool ok;
+    if (current && current->pool == pool) {
+        ok = deque_push(&current->deque, task);
+    } else {
+        pthread_mutex_lock(&pool->lock);
+        ok = list_append(pool->inject, task);
+        pthread_mutex_unlock(&pool->lock);
+    }
+    if (!ok) {
+        // Clean up if unable to queue the task
+        atomic_fetch_sub_explicit(&pool->queued, 1, memory_order_relaxed);
+        free(task);
+        return NULL;
+    }
+    pool_notify(pool);
+
+    // Return the spawned task
+    return task;
+}
+
+/**
+ * Wait for (join) a spawned task to finish, then delete it.
+ *
+ * @param pool  Pointer to the thread pool.
+ * @param task  Pointer to the task to join.
+ */
+void pool_join(struct pool *pool, struct task *task) {
+    if (!pool || !task)
+        // Return early if the thread pool or task is `NULL`
+        return;
+    struct worker *self = current && current->pool == pool ? current : NULL;
+    // Run other tasks until the joined task has finished
+    while (!atomic_load_explicit(&task->done, memory_order_acquire)) {
+        struct task *other = pool_find(pool, self);
+        if (other)
+            task_run(pool, other);
+        else
+            sched_yield();
+    }
+    free(task);
+}
+
+// Range of a parallel loop
+struct range {
+    // Thread pool running the loop
+    struct pool *pool;
+    // First index of the range
+    usize start;
+    // One past the last index of the range
+    usize end;
+    // Maximum number of indices per chunk
+    usize grain;
+    // Function to call for each chunk of indices
+    void (*body)(usize start, usize end, void *context);
+    // User-defined context to pass to the function
+    void *context;
+};
+
+// Run a range, splitting off its upper half while it is too large
+static void range_run(void *arg) {
+    struct range *range = arg;
+    if (range->end - range->start <= range->grain) {
+        range->body(range->start, range->end, range->context);
+        return;
+    }
+    // Split the range in two, exposing the upper half to thieves
+    usize mid = range->start + (range->end - range->start) / 2;
+    struct range upper = *range, lower = *range;
+    upper.start = mid;
+    lower.end = mid;
+    struct task *task = pool_spawn(range->pool, range_run, &upper);
+    if (!task) {
+        // Run the upper half inline if unable to spawn it
+        range_run(&lower);
+        range_run(&upper);
+        return;
+    }
+    range_run(&lower);
+    pool_join(range->pool, task);
+}
+
+/**
+ * Run a function over a range of indices in parallel.
+ *
+ * @param pool     Pointer to the thread pool.
+ * @param start    First index of the range.
+ * @param end      One past the last index of the range.
+ * @param grain    Maximum number of indices per chunk, or 0 to choose one
+ *                 based on the size of the range and the number of workers.
+ * @param body     Function to call for each chunk of indices.
+ * @param context  User-defined context to pass to the function.
+ */
+void pool_parallel_for(
+    struct pool *pool,
+    usize start,
+    usize end,
+    usize grain,
+    void (*body)(usize start, usize end, void *context),
+    void *context
+) {
+    if (!body || start >= end)
+        // Return early if there is nothing to run
+        return;
+    if (!pool) {
+        // Run the whole range on the calling thread without a pool
+        body(start, end, context);
+        return;
+    }
+    if (grain == 0) {
+        // Aim for several chunks per worker to balance the load
+        grain = (end - start) / (8 * pool->nthreads);
+        if (grain == 0)
+            grain = 1;
+    }
+    struct range range = {
+        .pool = pool,
+        .start = start,
+        .end = end,
+        .grain = grain,
+        .body = body,
+        .context = context,
+    };
+    range_run(&range);
+}
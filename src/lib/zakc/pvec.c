@@ -0,0 +1,559 @@
+// File:        pvec.c
+// Author:      Zakhary Kaplan <https://zakhary.dev>
+// Created:     17 Oct 2026
+// SPDX-License-Identifier: MIT
+
+#include "zakc/pvec.h"
+
+#include <stdatomic.h> // for atomic_*
+#include <stdlib.h>    // for calloc, free, malloc
+#include <string.h>    // for memcpy
+
+#include "zakc/types.h"  // for u32, usize
+#include "zakc/vector.h" // for vector_{array,len}
+
+// Number of index bits consumed by each level of the trie
+#define BITS  5
+#define WIDTH (1 << BITS)
+#define MASK  (WIDTH - 1)
+
+// Persistent vector structure
+struct pvec {
+    // Root of the trie, or `NULL` if all elements fit in the tail
+    struct pnode *root;
+    // Leaf holding the last (up to `WIDTH`) elements, or `NULL` if empty
+    struct pnode *tail;
+    // Number of elements in the vector
+    usize len;
+    // Number of index bits above the leaves of the trie
+    u32 shift;
+    // Whether the version may be updated in place
+    bool transient;
+};
+
+// Trie node structure
+struct pnode {
+    // Number of parents and versions referencing the node
+    atomic_size_t refs;
+    // Child nodes, or elements if the node is a leaf
+    void *slots[WIDTH];
+};
+
+// Allocate a new empty node
+static struct pnode *pnode_new(void) {
+    struct pnode *node = calloc(1, sizeof(struct pnode));
+    if (node)
+        atomic_init(&node->refs, 1);
+    return node;
+}
+
+// Add a reference to a node
+static void pnode_retain(struct pnode *node) {
+    if (node)
+        atomic_fetch_add_explicit(&node->refs, 1, memory_order_relaxed);
+}
+
+// Remove a reference to a node at the given level, freeing it if unused
+static void pnode_release(struct pnode *node, u32 level) {
+    if (!node)
+        return;
+    if (atomic_fetch_sub_explicit(&node->refs, 1, memory_order_acq_rel) != 1)
+        // Return early if the node is still referenced
+        return;
+    // Release the children of internal nodes
+    if (level > 0)
+        for (usize i = 0; i < WIDTH; i++)
+            pnode_release(node->slots[i], level - BITS);
+    free(node);
+}
+
+// Ensure the node in a slot is referenced only once, copying it if shared
+static struct pnode *pnode_own(struct pnode **slot, u32 level) {
+    struct pnode *node = *slot;
+    if (atomic_load_explicit(&node->refs, memory_order_acquire) == 1)
+        // Return the node if it is already unique
+        return node;
+    // Copy the shared node
+    struct pnode *copy = malloc(sizeof(struct pnode));
+    if (!copy)
+        return NULL;
+    atomic_init(&copy->refs, 1);
+    memcpy(copy->slots, node->slots, sizeof(node->slots));
+    // Reference the children of internal nodes from the copy
+    if (level > 0)
+        for (usize i = 0; i < WIDTH; i++)
+            pnode_retain(copy->slots[i]);
+    // Replace the shared node with its copy
+    pnode_release(node, level);
+    *slot = copy;
+    return copy;
+}
+
+// Get the index of the first element stored in the tail
+static usize pvec_tailoff(const struct pvec *vec) {
+    return vec->len < WIDTH ? 0 : ((vec->len - 1) >> BITS) << BITS;
+}
+
+// Get the leaf containing the element at the given index
+static struct pnode *pvec_leaf(const struct pvec *vec, usize index) {
+    if (index >= pvec_tailoff(vec))
+        return vec->tail;
+    struct pnode *node = vec->root;
+    for (u32 level = vec->shift; level > 0; level -= BITS)
+        node = node->slots[(index >> level) & MASK];
+    return node;
+}
+
+// Create a path of nodes from the given level down to a leaf
+static struct pnode *pvec_new_path(u32 level, struct pnode *leaf) {
+    if (level == 0)
+        return leaf;
+    struct pnode *node = pnode_new();
+    if (!node)
+        return NULL;
+    node->slots[0] = pvec_new_path(level - BITS, leaf);
+    if (!node->slots[0]) {
+        free(node);
+        return NULL;
+    }
+    return node;
+}
+
+// Push a full tail into the (owned) node at the given level
+static bool pvec_push_tail(
+    struct pvec *vec, struct pnode *node, u32 level, struct pnode *tail
+) {
+    usize subidx = ((vec->len - 1) >> level) & MASK;
+    if (level == BITS) {
+        // Insert the tail as a leaf
+        node->slots[subidx] = tail;
+        return true;
+    }
+    if (!node->slots[subidx]) {
+        // Create a new path down to the tail
+        node->slots[subidx] = pvec_new_path(level - BITS, tail);
+        return node->slots[subidx] != NULL;
+    }
+    // Descend into the existing child
+    struct pnode *child =
+        pnode_own((struct pnode **)&node->slots[subidx], level - BITS);
+    return child && pvec_push_tail(vec, child, level - BITS, tail);
+}
+
+// Remove the last leaf from the (owned) node at the given level, returning
+// `true` if the node is left empty
+static bool pvec_pop_tail(struct pvec *vec, struct pnode *node, u32 level) {
+    usize subidx = ((vec->len - 2) >> level) & MASK;
+    if (level > BITS) {
+        struct pnode **slot = (struct pnode **)&node->slots[subidx];
+        struct pnode *child = pnode_own(slot, level - BITS);
+        if (!child)
+            return false;
+        if (pvec_pop_tail(vec, child, level - BITS)) {
+            // Remove the now-empty child
+            pnode_release(child, level - BITS);
+            *slot = NULL;
+            return subidx == 0;
+        }
+        return false;
+    }
+    // Remove the leaf, which is now referenced by the tail
+    pnode_release(node->slots[subidx], 0);
+    node->slots[subidx] = NULL;
+    return subidx == 0;
+}
+
+// Append an element to a version in place
+static bool pvec_do_append(struct pvec *vec, void *data) {
+    usize cnt = vec->len - pvec_tailoff(vec);
+    if (!vec->tail || cnt < WIDTH) {
+        // Store the element in the tail
+        struct pnode *tail = vec->tail ? pnode_own(&vec->tail, 0) : pnode_new();
+        if (!tail)
+            return false;
+        tail->slots[cnt] = data;
+        vec->tail = tail;
+        vec->len++;
+        return true;
+    }
+
+    // Allocate the next tail before modifying the trie
+    struct pnode *next = pnode_new();
+    if (!next)
+        return false;
+    if (!vec->root) {
+        // Create the root to hold the first leaf
+        vec->root = pnode_new();
+        vec->shift = BITS;
+        if (!vec->root)
+            goto fail;
+    }
+    if ((vec->len >> BITS) > ((usize)1 << vec->shift)) {
+        // Grow the trie by one level when the root overflows
+        struct pnode *root = pnode_new();
+        if (!root)
+            goto fail;
+        root->slots[0] = vec->root;
+        root->slots[1] = pvec_new_path(vec->shift, vec->tail);
+        if (!root->slots[1]) {
+            free(root);
+            goto fail;
+        }
+        vec->root = root;
+        vec->shift += BITS;
+    } else {
+        // Push the full tail into the trie
+        struct pnode *root = pnode_own(&vec->root, vec->shift);
+        if (!root || !pvec_push_tail(vec, root, vec->shift, vec->tail))
+            goto fail;
+    }
+
+    // Start the next tail with the new element
+    next->slots[0] = data;
+    vec->tail = next;
+    vec->len++;
+    return true;
+
+fail:
+    free(next);
+    return false;
+}
+
+// Set an element of a version in place
+static bool pvec_do_set(struct pvec *vec, usize index, void *data) {
+    if (index >= vec->len)
+        // Return `false` if the index is out of bounds
+        return false;
+    struct pnode *node;
+    if (index >= pvec_tailoff(vec)) {
+        // Set the element in the tail
+        node = pnode_own(&vec->tail, 0);
+    } else {
+        // Copy the path from the root to the leaf
+        node = pnode_own(&vec->root, vec->shift);
+        for (u32 level = vec->shift; node && level > 0; level -= BITS) {
+            struct pnode **slot =
+                (struct pnode **)&node->slots[(index >> level) & MASK];
+            node = pnode_own(slot, level - BITS);
+        }
+    }
+    if (!node)
+        return false;
+    node->slots[index & MASK] = data;
+    return true;
+}
+
+// Remove the last element of a version in place
+static bool pvec_do_pop(struct pvec *vec, void **data) {
+    if (vec->len == 0)
+        // Return `false` if the vector is empty
+        return false;
+    if (vec->len == 1) {
+        // Release the tail of the last element
+        *data = vec->tail->slots[0];
+        pnode_release(vec->tail, 0);
+        vec->tail = NULL;
+        vec->len = 0;
+        return true;
+    }
+    usize cnt = vec->len - pvec_tailoff(vec);
+    if (cnt > 1) {
+        // Remove the element from the tail
+        struct pnode *tail = pnode_own(&vec->tail, 0);
+        if (!tail)
+            return false;
+        *data = tail->slots[cnt - 1];
+        tail->slots[cnt - 1] = NULL;
+        vec->len--;
+        return true;
+    }
+
+    // Promote the last leaf of the trie to be the new tail
+    struct pnode *root = pnode_own(&vec->root, vec->shift);
+    if (!root)
+        return false;
+    struct pnode *tail = pvec_leaf(vec, vec->len - 2);
+    pnode_retain(tail);
+    *data = vec->tail->slots[0];
+    if (pvec_pop_tail(vec, root, vec->shift)) {
+        // Remove the now-empty root
+        pnode_release(root, vec->shift);
+        vec->root = NULL;
+        vec->shift = 0;
+    } else if (vec->shift > BITS && !root->slots[1]) {
+        // Remove a level from the trie if the root has a single child
+        vec->root = root->slots[0];
+        pnode_retain(vec->root);
+        pnode_release(root, vec->shift);
+        vec->shift -= BITS;
+    }
+    pnode_release(vec->tail, 0);
+    vec->tail = tail;
+    vec->len--;
+    return true;
+}
+
+/**
+ * Create a new persistent vector.
+ *
+ * @return  Pointer to the newly-created persistent vector, or `NULL` if
+ *          memory allocation failed.
+ */
+struct pvec *pvec_new(void) {
+    // Allocate memory for the persistent vector
+    struct pvec *vec = malloc(sizeof(struct pvec));
+    if (!vec)
+        // Return `NULL` if memory allocation failed
+        return NULL;
+
+    // Initialize the persistent vector to be empty
+    *vec = (struct pvec){
+        .root = NULL,
+        .tail = NULL,
+        .len = 0,
+        .shift = 0,
+        .transient = false,
+    };
+
+    // Return the newly-created persistent vector
+    return vec;
+}
+
+/**
+ * Create a new persistent vector from the elements of a vector.
+ *
+ * @param vec  Pointer to the vector whose elements will be copied.
+ * @return     Pointer to the newly-created persistent vector, or `NULL` if
+ *             memory allocation failed.
+ */
+struct pvec *pvec_from_vector(const struct vector *vec) {
+    // Build the persistent vector in place
+    struct pvec *pvec = pvec_new();
+    if (!pvec)
+        return NULL;
+    void **data = vector_array(vec);
+    for (usize i = 0; i < vector_len(vec); i++) {
+        if (!pvec_do_append(pvec, data[i])) {
+            // Clean up if unable to append an element
+            pvec_drop(pvec);
+            return NULL;
+        }
+    }
+    return pvec;
+}
+
+/**
+ * Delete a version of the persistent vector.
+ *
+ * @param vec  Pointer to the version to delete.
+ */
+void pvec_drop(struct pvec *vec) {
+    if (!vec)
+        // Return early if the persistent vector is `NULL`
+        return;
+    // Release the structure referenced by this version
+    pnode_release(vec->root, vec->shift);
+    pnode_release(vec->tail, 0);
+    free(vec);
+}
+
+/**
+ * Take a snapshot of the persistent vector.
+ *
+ * @param vec  Pointer to the persistent vector.
+ * @return     Pointer to the snapshot, or `NULL` if memory allocation failed.
+ */
+struct pvec *pvec_snapshot(const struct pvec *vec) {
+    if (!vec)
+        // Return `NULL` if the persistent vector is `NULL`
+        return NULL;
+    // Allocate memory for the snapshot
+    struct pvec *snap = malloc(sizeof(struct pvec));
+    if (!snap)
+        return NULL;
+    // Share the structure of the persistent vector
+    *snap = *vec;
+    snap->transient = false;
+    pnode_retain(snap->root);
+    pnode_retain(snap->tail);
+    return snap;
+}
+
+/**
+ * Create a new version with an element appended to the end.
+ *
+ * @param vec   Pointer to the persistent vector.
+ * @param data  Pointer to the element to append.
+ * @return      Pointer to the new version, or `NULL` if the operation failed.
+ */
+struct pvec *pvec_append(const struct pvec *vec, void *data) {
+    struct pvec *next = pvec_snapshot(vec);
+    if (next && !pvec_do_append(next, data)) {
+        // Clean up if the operation failed
+        pvec_drop(next);
+        return NULL;
+    }
+    return next;
+}
+
+/**
+ * Create a new version with the element at a given index replaced.
+ *
+ * @param vec    Pointer to the persistent vector.
+ * @param index  Index of the element to set.
+ * @param data   Pointer to the element to set.
+ * @return       Pointer to the new version, or `NULL` if the operation failed.
+ */
+struct pvec *pvec_set(const struct pvec *vec, usize index, void *data) {
+    struct pvec *next = pvec_snapshot(vec);
+    if (next && !pvec_do_set(next, index, data)) {
+        // Clean up if the operation failed
+        pvec_drop(next);
+        return NULL;
+    }
+    return next;
+}
+
+/**
+ * Create a new version with the last element removed.
+ *
+ * @param vec  Pointer to the persistent vector.
+ * @return     Pointer to the new version, or `NULL` if the vector is empty or
+ *             the operation failed.
+ */
+struct pvec *pvec_pop(const struct pvec *vec) {
+    void *data;
+    struct pvec *next = pvec_snapshot(vec);
+    if (next && !pvec_do_pop(next, &data)) {
+        // Clean up if the operation failed
+        pvec_drop(next);
+        return NULL;
+    }
+    return next;
+}
+
+/**
+ * Get the element at a given index in the persistent vector.
+ *
+ * @param vec    Pointer to the persistent vector.
+ * @param index  Index of the element to get.
+ * @return       Pointer to the element at the given index, or `NULL` if the
+ *               index is out of bounds.
+ */
+void *pvec_get(const struct pvec *vec, usize index) {
+    if (!vec || index >= vec->len)
+        // Return `NULL` if the persistent vector is `NULL` or the index is out
+        // of bounds
+        return NULL;
+    // Return the element from its leaf
+    return pvec_leaf(vec, index)->slots[index & MASK];
+}
+
+/**
+ * Get the number of elements in the persistent vector.
+ *
+ * @param vec  Pointer to the persistent vector.
+ * @return     The number of elements in the persistent vector.
+ */
+usize pvec_len(const struct pvec *vec) {
+    if (!vec)
+        // Return zero if the persistent vector is `NULL`
+        return 0;
+    // Return the number of elements in the persistent vector
+    return vec->len;
+}
+
+/**
+ * Iterate over the elements in the persistent vector.
+ *
+ * @param vec       Pointer to the persistent vector.
+ * @param callback  Callback function to call for each element.
+ * @param context   User-defined context to pass to the callback function.
+ */
+void pvec_iter(
+    const struct pvec *vec,
+    void (*callback)(void *data, void *context),
+    void *context
+) {
+    if (!vec || !callback)
+        // Return early if the persistent vector or callback is `NULL`
+        return;
+    // Visit the elements one leaf at a time
+    for (usize i = 0; i < vec->len; i += WIDTH) {
+        struct pnode *leaf = pvec_leaf(vec, i);
+        usize end = vec->len - i < WIDTH ? vec->len - i : WIDTH;
+        for (usize j = 0; j < end; j++)
+            callback(leaf->slots[j], context);
+    }
+}
+
+/**
+ * Create a transient (mutable) version of the persistent vector.
+ *
+ * @param vec  Pointer to the persistent vector.
+ * @return     Pointer to the transient version, or `NULL` if memory
+ *             allocation failed.
+ */
+struct pvec *pvec_transient(const struct pvec *vec) {
+    struct pvec *tvec = pvec_snapshot(vec);
+    if (tvec)
+        tvec->transient = true;
+    return tvec;
+}
+
+/**
+ * Freeze a transient version, making it persistent.
+ *
+ * @param vec  Pointer to the transient version.
+ * @return     Pointer to the now-persistent version.
+ */
+struct pvec *pvec_persistent(struct pvec *vec) {
+    if (vec)
+        vec->transient = false;
+    return vec;
+}
+
+/**
+ * Append an element to the end of a transient version.
+ *
+ * @param vec   Pointer to the transient version.
+ * @param data  Pointer to the element to append.
+ * @return      `true` if the operation was successful, `false` otherwise.
+ */
+bool pvec_transient_append(struct pvec *vec, void *data) {
+    if (!vec || !vec->transient)
+        // Return `false` if the version is `NULL` or not transient
+        return false;
+    return pvec_do_append(vec, data);
+}
+
+/**
+ * Set the element at a given index in a transient version.
+ *
+ * @param vec    Pointer to the transient version.
+ * @param index  Index of the element to set.
+ * @param data   Pointer to the element to set.
+ * @return       `true` if the operation was successful, `false` otherwise.
+ */
+bool pvec_transient_set(struct pvec *vec, usize index, void *data) {
+    if (!vec || !vec->transient)
+        // Return `false` if the version is `NULL` or not transient
+        return false;
+    return pvec_do_set(vec, index, data);
+}
+
+/**
+ * Remove the last element from a transient version.
+ *
+ * @param vec  Pointer to the transient version.
+ * @return     Pointer to the removed element, or `NULL` if the operation was
+ *             invalid.
+ */
+void *pvec_transient_pop(struct pvec *vec) {
+    void *data = NULL;
+    if (!vec || !vec->transient)
+        // Return `NULL` if the version is `NULL` or not transient
+        return NULL;
+    pvec_do_pop(vec, &data);
+    return data;
+}
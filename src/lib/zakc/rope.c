@@ -0,0 +1,858 @@
+// File:        rope.c
+// Author:      Zakhary Kaplan <https://zakhary.dev>
+// Created:     17 Oct 2026
+// SPDX-License-Identifier: MIT
+
+#include "zakc/rope.h"
+
+#include <stdlib.h> // for free, malloc
+#include <string.h> // for memmove
+
+#include "zakc/types.h" // for u32, usize
+
+// Maximum number of items in a leaf
+#define LEAF 64
+// Maximum number of children of a branch
+#define FANOUT 32
+// Maximum height of the tree
+//
+// Adjacent siblings always hold at least a full node's worth of entries
+// between them, so a tree this tall could not fit in memory.
+#define DEPTH 32
+
+// Rope structure
+struct rope {
+    // Root of the tree, or `NULL` if the rope is empty
+    struct rnode *root;
+    // Number of items in the rope
+    usize len;
+    // Number of levels of branches above the leaves
+    u32 height;
+    // Destructor for data, or `NULL` if data is not owned by the rope
+    void (*data_free)(void *data);
+};
+
+// Tree node structure
+//
+// Leaves and branches are the same size, so either can be allocated
+// wherever a node is needed.
+struct rnode {
+    // Number of items or children in the node
+    u32 len;
+    union {
+        // Items of a leaf
+        void *items[LEAF];
+        // Children of a branch
+        struct {
+            // Number of items below each child
+            usize sizes[FANOUT];
+            // Pointers to each child
+            struct rnode *children[FANOUT];
+        };
+    };
+};
+
+// Allocate a new empty node
+static struct rnode *rnode_new(void) {
+    struct rnode *node = malloc(sizeof(struct rnode));
+    if (node)
+        node->len = 0;
+    return node;
+}
+
+// Free a node at the given height, along with its descendants and their data
+static void rnode_free(
+    struct rnode *node, u32 height, void (*data_free)(void *data)
+) {
+    if (height > 0)
+        for (usize i = 0; i < node->len; i++)
+            rnode_free(node->children[i], height - 1, data_free);
+    else if (data_free)
+        for (usize i = 0; i < node->len; i++)
+            data_free(node->items[i]);
+    free(node);
+}
+
+// Get the maximum number of entries of a node at the given height
+static inline usize rnode_cap(u32 height) {
+    return height ? FANOUT : LEAF;
+}
+
+// Get the number of items below the entries of a node in a given range
+static usize rnode_sum(
+    const struct rnode *node, u32 height, usize from, usize to
+) {
+    if (height == 0)
+        return to - from;
+    usize sum = 0;
+    for (usize i = from; i < to; i++)
+        sum += node->sizes[i];
+    return sum;
+}
+
+// Move entries between nodes at the given height, which may be the same node
+static void rnode_move(
+    struct rnode *dst,
+    usize to,
+    const struct rnode *src,
+    usize from,
+    usize n,
+    u32 height
+) {
+    if (height == 0) {
+        memmove(&dst->items[to], &src->items[from], n * sizeof(void *));
+        return;
+    }
+    memmove(&dst->sizes[to], &src->sizes[from], n * sizeof(usize));
+    memmove(
+        &dst->children[to], &src->children[from], n * sizeof(struct rnode *)
+    );
+}
+
+// Insert an entry, either an item or a child of the given size, into a node
+static void rnode_put(
+    struct rnode *node, u32 height, usize pos, void *entry, usize size
+) {
+    rnode_move(node, pos + 1, node, pos, node->len - pos, height);
+    if (height == 0) {
+        node->items[pos] = entry;
+    } else {
+        node->sizes[pos] = size;
+        node->children[pos] = entry;
+    }
+    node->len++;
+}
+
+// Find the child of a branch holding a position, making the position relative
+// to the child
+//
+// When `end` is set, a position at the end of a child is found within it,
+// rather than at the start of the next child.
+static usize rnode_find(const struct rnode *node, usize *pos, bool end) {
+    usize i = 0;
+    while (i + 1 < node->len && *pos >= node->sizes[i] + end)
+        *pos -= node->sizes[i++];
+    return i;
+}
+
+static void rnode_mend(struct rnode *node, usize i, u32 height);
+
+// Merge a child of a branch into the child before it
+static void rnode_join(struct rnode *parent, usize i, u32 height) {
+    struct rnode *left = parent->children[i];
+    struct rnode *right = parent->children[i + 1];
+    usize seam = left->len;
+    rnode_move(left, left->len, right, 0, right->len, height);
+    left->len += right->len;
+    parent->sizes[i] += parent->sizes[i + 1];
+    free(right);
+    rnode_move(parent, i + 1, parent, i + 2, parent->len - i - 2, height + 1);
+    parent->len--;
+    // The children on either side of the seam are now siblings
+    rnode_mend(left, seam, height);
+}
+
+// Merge the children of a node at the given height on either side of a seam,
+// if they have just become siblings and fit together
+static void rnode_mend(struct rnode *node, usize i, u32 height) {
+    if (height == 0 || i == 0 || i >= node->len)
+        return;
+    usize cap = rnode_cap(height - 1);
+    if (node->children[i - 1]->len + node->children[i]->len <= cap)
+        rnode_join(node, i - 1, height - 1);
+}
+
+// Repair a child of a branch which has shrunk, freeing it if empty, or
+// merging it with a neighbour if both fit in a single node
+static void rnode_fix(struct rnode *parent, usize i, u32 height) {
+    struct rnode *child = parent->children[i];
+    if (child->len == 0) {
+        // Remove the empty child
+        free(child);
+        rnode_move(parent, i, parent, i + 1, parent->len - i - 1, height + 1);
+        parent->len--;
+        return;
+    }
+    usize cap = rnode_cap(height);
+    if (i + 1 < parent->len && child->len + parent->children[i + 1]->len <= cap)
+        rnode_join(parent, i, height);
+    if (i > 0 && parent->children[i - 1]->len + child->len <= cap)
+        rnode_join(parent, i - 1, height);
+}
+
+// Find a neighbour of a child of a branch with room for another entry,
+// returning the index of the child itself if there is none
+static usize rnode_roomy(const struct rnode *parent, usize i, u32 height) {
+    usize cap = rnode_cap(height);
+    if (i + 1 < parent->len && parent->children[i + 1]->len < cap)
+        return i + 1;
+    if (i > 0 && parent->children[i - 1]->len < cap)
+        return i - 1;
+    return i;
+}
+
+// Insert an entry into a full node, passing its first or last entry on to a
+// neighbour with room, and return the size of the entry passed on
+static usize rnode_spill(
+    struct rnode *node,
+    struct rnode *next,
+    u32 height,
+    usize pos,
+    void *entry,
+    usize size,
+    bool right
+) {
+    if (right) {
+        if (pos == node->len) {
+            // Pass the new entry on itself
+            rnode_put(next, height, 0, entry, size);
+            return size;
+        }
+        // Pass the last entry to the front of the neighbour
+        usize moved = rnode_sum(node, height, node->len - 1, node->len);
+        rnode_move(next, 1, next, 0, next->len, height);
+        rnode_move(next, 0, node, node->len - 1, 1, height);
+        next->len++;
+        node->len--;
+        rnode_put(node, height, pos, entry, size);
+        return moved;
+    }
+    if (pos == 0) {
+        // Pass the new entry on itself
+        rnode_put(next, height, next->len, entry, size);
+        return size;
+    }
+    // Pass the first entry to the back of the neighbour
+    usize moved = rnode_sum(node, height, 0, 1);
+    rnode_move(next, next->len, node, 0, 1, height);
+    next->len++;
+    rnode_move(node, 0, node, 1, node->len - 1, height);
+    node->len--;
+    rnode_put(node, height, pos - 1, entry, size);
+    return moved;
+}
+
+// Insert an entry into a full node by splitting it, and return the size of
+// the new sibling, which belongs before the node if the entry was inserted at
+// its front and after it otherwise
+static usize rnode_split(
+    struct rnode *node,
+    struct rnode *sib,
+    u32 height,
+    usize pos,
+    void *entry,
+    usize size
+) {
+    if (pos == 0 || pos == node->len) {
+        // Give an entry at either end a sibling of its own, so that appending
+        // or prepending in order leaves full nodes behind
+        rnode_put(sib, height, 0, entry, size);
+        return size;
+    }
+    // Move the upper half of the node into the sibling
+    usize keep = node->len / 2;
+    rnode_move(sib, 0, node, keep, node->len - keep, height);
+    sib->len = node->len - keep;
+    node->len = keep;
+    usize moved = rnode_sum(sib, height, 0, sib->len);
+    if (pos <= keep) {
+        rnode_put(node, height, pos, entry, size);
+        return moved;
+    }
+    rnode_put(sib, height, pos - keep, entry, size);
+    return moved + size;
+}
+
+// Insert an entry holding `add` items into the last node of a path, which is
+// at the given depth, splitting full nodes on the way back up
+//
+// A full node first tries to pass an entry on to a neighbour. Every node a
+// split needs is allocated before the tree is changed, so the rope is left
+// unchanged if allocation fails.
+static bool rope_put(
+    struct rope *rope,
+    struct rnode **path,
+    const usize *idx,
+    u32 depth,
+    usize pos,
+    void *entry,
+    usize add
+) {
+    // Count the nodes needed to split each full node on the path
+    usize need = 0;
+    for (u32 d = depth;; d--) {
+        u32 height = rope->height - d;
+        if (path[d]->len < rnode_cap(height))
+            break;
+        if (d == 0) {
+            // Split the root beneath a new root
+            need += 2;
+            break;
+        }
+        if (rnode_roomy(path[d - 1], idx[d - 1], height) != idx[d - 1])
+            break;
+        need++;
+    }
+    struct rnode *spare[DEPTH + 2];
+    for (usize i = 0; i < need; i++) {
+        spare[i] = rnode_new();
+        if (!spare[i]) {
+            // Clean up if unable to allocate every node
+            while (i-- > 0)
+                free(spare[i]);
+            return false;
+        }
+    }
+
+    // Insert the entry, moving up the path while nodes are split
+    usize size = add;
+    u32 top = 0;
+    for (u32 d = depth;; d--) {
+        struct rnode *node = path[d];
+        u32 height = rope->height - d;
+        if (node->len < rnode_cap(height)) {
+            // Insert the entry into a node with room
+            rnode_put(node, height, pos, entry, size);
+            top = d;
+            break;
+        }
+        if (d == 0) {
+            // Split the root, and grow the tree by one level
+            struct rnode *sib = spare[--need];
+            struct rnode *root = spare[--need];
+            bool front = pos == 0;
+            usize moved = rnode_split(node, sib, height, pos, entry, size);
+            root->len = 2;
+            root->sizes[front] = rope->len + add - moved;
+            root->sizes[!front] = moved;
+            root->children[front] = node;
+            root->children[!front] = sib;
+            rope->root = root;
+            rope->height++;
+            break;
+        }
+        struct rnode *parent = path[d - 1];
+        usize i = idx[d - 1];
+        usize j = rnode_roomy(parent, i, height);
+        if (j != i) {
+            // Pass an entry on to the neighbour, and merge it with the
+            // neighbour's entry it now sits beside, if they fit together
+            struct rnode *next = parent->children[j];
+            usize moved =
+                rnode_spill(node, next, height, pos, entry, size, j > i);
+            parent->sizes[i] += add - moved;
+            parent->sizes[j] += moved;
+            rnode_mend(next, j > i ? 1 : next->len - 1, height);
+            top = d - 1;
+            break;
+        }
+        // Split the node, then insert its new sibling into the parent
+        struct rnode *sib = spare[--need];
+        bool front = pos == 0;
+        usize moved = rnode_split(node, sib, height, pos, entry, size);
+        parent->sizes[i] += add - moved;
+        entry = sib;
+        size = moved;
+        pos = front ? i : i + 1;
+    }
+
+    // Count the new items in each ancestor of the updated node
+    for (u32 d = 0; d < top; d++)
+        path[d]->sizes[idx[d]] += add;
+    rope->len += add;
+    return true;
+}
+
+// Remove the root while it has only a single child, or no items
+static void rope_trim(struct rope *rope) {
+    while (rope->height > 0 && rope->root->len == 1) {
+        struct rnode *root = rope->root;
+        rope->root = root->children[0];
+        rope->height--;
+        free(root);
+    }
+    if (rope->root && rope->root->len == 0) {
+        free(rope->root);
+        rope->root = NULL;
+        rope->height = 0;
+    }
+}
+
+// Graft a tree of the given height, holding `len` items, onto the front or
+// back of a rope at least as tall
+static bool rope_graft(
+    struct rope *rope, struct rnode *sub, u32 height, usize len, bool front
+) {
+    // Descend along the spine to the node at the same height as the tree
+    struct rnode *path[DEPTH + 1];
+    usize idx[DEPTH];
+    u32 depth = rope->height - height;
+    struct rnode *node = rope->root;
+    for (u32 d = 0; d < depth; d++) {
+        path[d] = node;
+        idx[d] = front ? 0 : node->len - 1;
+        node = node->children[idx[d]];
+    }
+
+    if (node->len + sub->len <= rnode_cap(height)) {
+        // Merge the tree's root into the spine node if they fit together
+        usize seam = front ? sub->len : node->len;
+        if (front) {
+            rnode_move(node, sub->len, node, 0, node->len, height);
+            rnode_move(node, 0, sub, 0, sub->len, height);
+        } else {
+            rnode_move(node, node->len, sub, 0, sub->len, height);
+        }
+        node->len += sub->len;
+        free(sub);
+        rnode_mend(node, seam, height);
+        for (u32 d = 0; d < depth; d++)
+            path[d]->sizes[idx[d]] += len;
+        rope->len += len;
+        return true;
+    }
+
+    if (depth == 0) {
+        // Place both trees beneath a new root
+        struct rnode *root = rnode_new();
+        if (!root)
+            return false;
+        root->len = 2;
+        root->sizes[front] = rope->len;
+        root->sizes[!front] = len;
+        root->children[front] = node;
+        root->children[!front] = sub;
+        rope->root = root;
+        rope->height++;
+        rope->len += len;
+        return true;
+    }
+
+    // Insert the tree's root beside the spine node
+    struct rnode *parent = path[depth - 1];
+    usize pos = front ? 0 : parent->len;
+    return rope_put(rope, path, idx, depth - 1, pos, sub, len);
+}
+
+// Call a function on each item below a node at the given height
+static void rnode_iter(
+    const struct rnode *node,
+    u32 height,
+    void (*callback)(void *data, void *context),
+    void *context
+) {
+    if (height > 0)
+        for (usize i = 0; i < node->len; i++)
+            rnode_iter(node->children[i], height - 1, callback, context);
+    else
+        for (usize i = 0; i < node->len; i++)
+            callback(node->items[i], context);
+}
+
+/**
+ * Create a new rope.
+ *
+ * @return  Pointer to the newly-created rope, or `NULL` if memory allocation
+ *          failed.
+ */
+struct rope *rope_new(void) {
+    // Allocate memory for the rope
+    struct rope *rope = malloc(sizeof(struct rope));
+    if (!rope)
+        // Return `NULL` if memory allocation failed
+        return NULL;
+
+    // Initialize the rope to be empty
+    *rope = (struct rope){
+        .root = NULL,
+        .len = 0,
+        .height = 0,
+        .data_free = NULL,
+    };
+
+    return rope;
+}
+
+/**
+ * Set the destructor of the rope's data.
+ *
+ * @param rope       Pointer to the rope.
+ * @param data_free  Destructor for data, or `NULL` to not free data.
+ */
+void rope_set_free(struct rope *rope, void (*data_free)(void *data)) {
+    if (!rope)
+        // Return early if the rope is `NULL`
+        return;
+    // Store the destructor
+    rope->data_free = data_free;
+}
+
+/**
+ * Delete the rope.
+ *
+ * @param rope  Pointer to the rope to delete.
+ */
+void rope_drop(struct rope *rope) {
+    if (!rope)
+        // Return early if the rope is `NULL`
+        return;
+
+    // Free each node, along with its data
+    rope_clear(rope);
+
+    // Free the rope
+    free(rope);
+}
+
+/**
+ * Remove every item from the rope.
+ *
+ * @param rope  Pointer to the rope.
+ */
+void rope_clear(struct rope *rope) {
+    if (!rope || !rope->root)
+        // Return early if the rope is `NULL` or empty
+        return;
+
+    // Free the tree, passing each item's data to the destructor
+    rnode_free(rope->root, rope->height, rope->data_free);
+
+    // Reset the rope to be empty
+    rope->root = NULL;
+    rope->len = 0;
+    rope->height = 0;
+}
+
+/**
+ * Append an item to the end of the rope.
+ *
+ * @param rope  Pointer to the rope.
+ * @param data  Data of the item to append.
+ * @return      `true` if the operation was successful, `false` otherwise.
+ */
+bool rope_append(struct rope *rope, void *data) {
+    return rope && rope_insert(rope, rope->len, data);
+}
+
+/**
+ * Prepend an item to the beginning of the rope.
+ *
+ * @param rope  Pointer to the rope.
+ * @param data  Data of the item to prepend.
+ * @return      `true` if the operation was successful, `false` otherwise.
+ */
+bool rope_prepend(struct rope *rope, void *data) {
+    return rope_insert(rope, 0, data);
+}
+
+/**
+ * Remove the last item from the rope.
+ *
+ * @param rope  Pointer to the rope.
+ * @return      Pointer to the removed element, or `NULL` if the operation was
+ *              invalid.
+ */
+void *rope_pop(struct rope *rope) {
+    if (!rope || rope->len == 0)
+        // Return `NULL` if the rope is `NULL` or empty
+        return NULL;
+    return rope_remove(rope, rope->len - 1);
+}
+
+/**
+ * Remove the first item from the rope.
+ *
+ * @param rope  Pointer to the rope.
+ * @return      Pointer to the removed element, or `NULL` if the operation was
+ *              invalid.
+ */
+void *rope_shift(struct rope *rope) {
+    return rope_remove(rope, 0);
+}
+
+/**
+ * Insert an item at the given index in the rope.
+ *
+ * @param rope  Pointer to the rope.
+ * @param index Index at which to insert the item.
+ * @param data  Data of the item to insert.
+ * @return      `true` if the operation was successful, `false` otherwise.
+ */
+bool rope_insert(struct rope *rope, usize index, void *data) {
+    if (!rope || index > rope->len)
+        // Return `false` if the rope is `NULL` or the index is out of bounds
+        return false;
+
+    if (!rope->root) {
+        // Create the first leaf of an empty rope
+        rope->root = rnode_new();
+        if (!rope->root)
+            // Return `false` if unable to allocate the leaf
+            return false;
+    }
+
+    // Find the leaf to insert the item into, recording the path to it
+    struct rnode *path[DEPTH + 1];
+    usize idx[DEPTH];
+    struct rnode *node = rope->root;
+    for (u32 d = 0; d < rope->height; d++) {
+        path[d] = node;
+        idx[d] = rnode_find(node, &index, true);
+        node = node->children[idx[d]];
+    }
+    path[rope->height] = node;
+
+    // Insert the item into the leaf
+    return rope_put(rope, path, idx, rope->height, index, data, 1);
+}
+
+/**
+ * Remove the item at the given index from the rope.
+ *
+ * @param rope  Pointer to the rope.
+ * @param index Index of the item to remove.
+ * @return      Pointer to the removed element, or `NULL` if the operation was
+ *              invalid.
+ */
+void *rope_remove(struct rope *rope, usize index) {
+    if (!rope || index >= rope->len)
+        // Return `NULL` if the rope is `NULL` or the index is out of bounds
+        return NULL;
+
+    // Find the leaf holding the item, recording the path to it
+    struct rnode *path[DEPTH];
+    usize idx[DEPTH];
+    struct rnode *node = rope->root;
+    for (u32 d = 0; d < rope->height; d++) {
+        path[d] = node;
+        idx[d] = rnode_find(node, &index, false);
+        node = node->children[idx[d]];
+    }
+
+    // Remove the item from the leaf
+    void *data = node->items[index];
+    rnode_move(node, index, node, index + 1, node->len - index - 1, 0);
+    node->len--;
+
+    // Repair each node on the way back up, merging those which have shrunk
+    // enough to fit alongside a neighbour
+    for (u32 d = rope->height; d-- > 0;) {
+        path[d]->sizes[idx[d]]--;
+        rnode_fix(path[d], idx[d], rope->height - d - 1);
+    }
+    rope->len--;
+    rope_trim(rope);
+
+    return data;
+}
+
+/**
+ * Get the item at the given index in the rope.
+ *
+ * @param rope  Pointer to the rope.
+ * @param index Index of the item to get.
+ * @return      Pointer to the item at the given index, or `NULL` if the index
+ *              is out of bounds or the rope is `NULL`.
+ */
+void *rope_get(const struct rope *rope, usize index) {
+    if (!rope || index >= rope->len)
+        // Return `NULL` if the rope is `NULL` or the index is out of bounds
+        return NULL;
+
+    // Descend to the leaf holding the item
+    const struct rnode *node = rope->root;
+    for (u32 d = 0; d < rope->height; d++)
+        node = node->children[rnode_find(node, &index, false)];
+
+    // Return the data stored in the leaf
+    return node->items[index];
+}
+
+/**
+ * Set the item at the given index in the rope.
+ *
+ * @param rope  Pointer to the rope.
+ * @param index Index of the item to set.
+ * @param data  Data of the item to set.
+ * @return      `true` if the operation was successful, `false` otherwise.
+ */
+bool rope_set(struct rope *rope, usize index, void *data) {
+    if (!rope || index >= rope->len)
+        // Return `false` if the rope is `NULL` or the index is out of bounds
+        return false;
+
+    // Descend to the leaf holding the item
+    struct rnode *node = rope->root;
+    for (u32 d = 0; d < rope->height; d++)
+        node = node->children[rnode_find(node, &index, false)];
+
+    // Destroy the data being replaced, unless it is being set again
+    if (rope->data_free && node->items[index] != data)
+        rope->data_free(node->items[index]);
+    // Update the data stored in the leaf
+    node->items[index] = data;
+
+    return true;
+}
+
+/**
+ * Get the length of the rope.
+ *
+ * @param rope  Pointer to the rope.
+ * @return      The number of items in the rope, or 0 if the rope is `NULL`.
+ */
+usize rope_len(const struct rope *rope) {
+    if (!rope)
+        // Return 0 if the rope is `NULL`
+        return 0;
+
+    // Return the length of the rope
+    return rope->len;
+}
+
+/**
+ * Iterate over the items in the rope, in order.
+ *
+ * @param rope      Pointer to the rope.
+ * @param callback  Callback function to call for each item.
+ * @param context   User-defined context to pass to the callback function.
+ */
+void rope_iter(
+    const struct rope *rope,
+    void (*callback)(void *data, void *context),
+    void *context
+) {
+    if (!rope || !rope->root || !callback)
+        // Return early if the rope is `NULL` or empty, or the callback is
+        // `NULL`
+        return;
+    // Visit the items one leaf at a time
+    rnode_iter(rope->root, rope->height, callback, context);
+}
+
+/**
+ * Split the rope in two at the given index.
+ *
+ * @param rope   Pointer to the rope.
+ * @param index  Index of the first item to move.
+ * @return       Pointer to the newly-created rope, or `NULL` if the index is
+ *               out of bounds or memory allocation failed.
+ */
+struct rope *rope_split(struct rope *rope, usize index) {
+    if (!rope || index > rope->len)
+        // Return `NULL` if the rope is `NULL` or the index is out of bounds
+        return NULL;
+
+    // Create the rope to hold the items after the index
+    struct rope *rest = rope_new();
+    if (!rest)
+        return NULL;
+    rest->data_free = rope->data_free;
+    if (index == rope->len)
+        // Return the empty rope if there is nothing to move
+        return rest;
+    if (index == 0) {
+        // Move the whole tree if every item is to be moved
+        rest->root = rope->root;
+        rest->len = rope->len;
+        rest->height = rope->height;
+        rope->root = NULL;
+        rope->len = 0;
+        rope->height = 0;
+        return rest;
+    }
+
+    // Allocate a node for the right-hand side of each level of the tree
+    struct rnode *left[DEPTH + 1];
+    struct rnode *right[DEPTH + 1];
+    for (u32 d = 0; d <= rope->height; d++) {
+        right[d] = rnode_new();
+        if (!right[d]) {
+            // Clean up if unable to allocate every node
+            while (d-- > 0)
+                free(right[d]);
+            free(rest);
+            return NULL;
+        }
+    }
+
+    // Cut each node along the path to the index, moving the entries after
+    // the cut into the right-hand node
+    struct rnode *node = rope->root;
+    usize pos = index;
+    for (u32 d = 0; d < rope->height; d++) {
+        u32 height = rope->height - d;
+        usize i = rnode_find(node, &pos, false);
+        usize n = node->len - i - 1;
+        rnode_move(right[d], 1, node, i + 1, n, height);
+        right[d]->len = n + 1;
+        right[d]->sizes[0] = node->sizes[i] - pos;
+        right[d]->children[0] = right[d + 1];
+        node->len = i + 1;
+        node->sizes[i] = pos;
+        left[d] = node;
+        node = node->children[i];
+    }
+    u32 leaf = rope->height;
+    rnode_move(right[leaf], 0, node, pos, node->len - pos, 0);
+    right[leaf]->len = node->len - pos;
+    node->len = pos;
+
+    // Repair the nodes on either side of the cut, from the leaves up
+    for (u32 d = rope->height; d-- > 0;) {
+        u32 height = rope->height - d - 1;
+        rnode_fix(left[d], left[d]->len - 1, height);
+        rnode_fix(right[d], 0, height);
+    }
+
+    // Divide the items between the two ropes
+    rest->root = right[0];
+    rest->len = rope->len - index;
+    rest->height = rope->height;
+    rope->len = index;
+    rope_trim(rope);
+    rope_trim(rest);
+
+    return rest;
+}
+
+/**
+ * Concatenate a rope onto the end of another, leaving it empty.
+ *
+ * @param dst  Pointer to the rope to append to.
+ * @param src  Pointer to the rope whose items are appended.
+ * @return     `true` if the operation was successful, `false` otherwise.
+ */
+bool rope_concat(struct rope *dst, struct rope *src) {
+    if (!dst || !src || dst == src)
+        // Return `false` if either rope is `NULL`, or they are the same
+        return false;
+    if (!src->root)
+        // Return early if there is nothing to append
+        return true;
+
+    if (!dst->root) {
+        // Move the tree if the destination is empty
+        dst->root = src->root;
+        dst->len = src->len;
+        dst->height = src->height;
+    } else if (dst->height >= src->height) {
+        // Graft the source onto the back of the destination
+        if (!rope_graft(dst, src->root, src->height, src->len, false))
+            return false;
+    } else {
+        // Graft the destination onto the front of the source, then move the
+        // combined tree into the destination
+        if (!rope_graft(src, dst->root, dst->height, dst->len, true))
+            return false;
+        dst->root = src->root;
+        dst->len = src->len;
+        dst->height = src->height;
+    }
+
+    // Leave the source empty
+    src->root = NULL;
+    src->len = 0;
+    src->height = 0;
+    return true;
+}
@@ -0,0 +1,520 @@
+// File:        shardmap.c
+// Author:      Zakhary Kaplan <https://zakhary.dev>
+// Created:     17 Oct 2026
+// SPDX-License-Identifier: MIT
+
+#define _GNU_SOURCE // for CPU_*, sched_setaffinity, syscall
+
+#include "zakc/shardmap.h"
+
+#include <pthread.h> // for pthread_*
+#include <sched.h>   // for cpu_set_t, sched_setaffinity
+#include <stdint.h>  // for uintptr_t
+#include <stdio.h>   // for FILE, f{close,open,scanf}, snprintf
+#include <stdlib.h>  // for aligned_alloc, free, realloc
+#include <string.h>  // for memset
+#include <unistd.h>  // for syscall
+
+#ifdef __linux__
+#include <linux/mempolicy.h> // for MPOL_PREFERRED
+#include <sys/syscall.h>     // for SYS_set_mempolicy
+#endif
+
+#include "zakc/hashmap.h" // for hashmap, mulhi64, u64_hash
+#include "zakc/types.h"   // for u64, usize
+
+// Maximum number of NUMA nodes supported
+#define MAX_NODES 64
+// Initial capacity of each shard's queue of work
+#define QUEUE_CAPACITY 64
+
+// Work submitted to a shard
+struct job {
+    // Function to call with the shard's hash map
+    void (*func)(struct hashmap *shard, const void *key, void *context);
+    // Key whose shard runs the work
+    const void *key;
+    // User-defined context to pass to the function
+    void *context;
+};
+
+// Shard structure
+//
+// Shards are aligned to cache lines, so that the locks of neighbouring shards
+// are not falsely shared.
+struct shard {
+    // Lock protecting the hash map
+    _Alignas(64) pthread_rwlock_t lock;
+    // Hash map of the shard's items
+    struct hashmap *map;
+    // NUMA node of the shard
+    usize node;
+    // Sharded hash map of the shard
+    struct shardmap *owner;
+    // Thread owning the shard
+    pthread_t thread;
+    // Lock protecting the queue of work
+    pthread_mutex_t mutex;
+    // Condition signalled when work is queued
+    pthread_cond_t wake;
+    // Condition signalled when the shard is ready or has no work left
+    pthread_cond_t idle;
+    // Queue of submitted work
+    struct job *jobs;
+    // Number of jobs in the queue
+    usize njobs;
+    // Capacity of the queue
+    usize capacity;
+    // Spare queue, swapped in while the owner runs a batch
+    struct job *spare;
+    // Capacity of the spare queue
+    usize nspare;
+    // Whether the owner is running a batch of work
+    bool busy;
+    // Whether the owner has started, successfully or not
+    bool ready;
+    // Whether the owner should stop once the queue is empty
+    bool shutdown;
+};
+
+// Sharded hash map structure
+struct shardmap {
+    // Hash function for keys
+    u64 (*hash)(const void *key);
+    // Comparison function for keys
+    bool (*cmp)(const void *left, const void *right);
+    // Array of shards
+    struct shard *shards;
+    // Number of shards
+    usize nshards;
+};
+
+// Parse a list of ranges (e.g. "0-3,8,10-11") from a file into an array of
+// flags, returning the number of flags set
+static usize parse_list(const char *path, bool *flags, usize nflags) {
+    FILE *file = fopen(path, "r");
+    if (!file)
+        // Return 0 if the file could not be opened
+        return 0;
+    usize count = 0;
+    unsigned lo, hi;
+    for (int n; (n = fscanf(file, "%u-%u", &lo, &hi)) > 0;) {
+        if (n == 1)
+            hi = lo;
+        for (usize i = lo; i <= hi && i < nflags; i++) {
+            count += !flags[i];
+            flags[i] = true;
+        }
+        if (fgetc(file) != ',')
+            break;
+    }
+    fclose(file);
+    return count;
+}
+
+// Bind the calling thread to the CPUs and memory of a NUMA node
+static void node_bind(usize node) {
+#ifdef __linux__
+    // Pin the thread to the CPUs of the node
+    char path[64];
+    const char *fmt = "/sys/devices/system/node/node%zu/cpulist";
+    snprintf(path, sizeof(path), fmt, node);
+    bool cpus[CPU_SETSIZE] = {false};
+    if (parse_list(path, cpus, CPU_SETSIZE)) {
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        for (usize cpu = 0; cpu < CPU_SETSIZE; cpu++)
+            if (cpus[cpu])
+                CPU_SET(cpu, &set);
+        sched_setaffinity(0, sizeof(set), &set);
+    }
+    // Prefer to allocate memory from the node, falling back to others if
+    // it runs out
+    unsigned long mask = 1ul << node;
+    syscall(SYS_set_mempolicy, MPOL_PREFERRED, &mask, MAX_NODES + 1);
+#else
+    (void)node;
+#endif
+}
+
+// Main loop of a shard's owner thread
+static void *shard_main(void *arg) {
+    struct shard *shard = arg;
+    struct shardmap *owner = shard->owner;
+    node_bind(shard->node);
+
+    // Create the hash map on the owner, so that it is allocated on its node
+    struct hashmap *map = hashmap_new(owner->hash, owner->cmp);
+    pthread_mutex_lock(&shard->mutex);
+    shard->map = map;
+    shard->ready = true;
+    pthread_cond_broadcast(&shard->idle);
+
+    while (map) {
+        // Wait for work to be queued
+        while (!shard->njobs && !shard->shutdown)
+            pthread_cond_wait(&shard->wake, &shard->mutex);
+        if (!shard->njobs)
+            // Stop once shut down with no work left
+            break;
+        // Take the whole queue, leaving the spare queue for submitters
+        struct job *jobs = shard->jobs;
+        usize njobs = shard->njobs;
+        usize capacity = shard->capacity;
+        shard->jobs = shard->spare;
+        shard->capacity = shard->nspare;
+        shard->njobs = 0;
+        shard->busy = true;
+        pthread_mutex_unlock(&shard->mutex);
+
+        // Run the batch with exclusive access to the hash map
+        pthread_rwlock_wrlock(&shard->lock);
+        for (usize i = 0; i < njobs; i++)
+            jobs[i].func(map, jobs[i].key, jobs[i].context);
+        pthread_rwlock_unlock(&shard->lock);
+
+        // Keep the drained queue as the next spare queue
+        pthread_mutex_lock(&shard->mutex);
+        shard->spare = jobs;
+        shard->nspare = capacity;
+        shard->busy = false;
+        if (!shard->njobs)
+            pthread_cond_broadcast(&shard->idle);
+    }
+    pthread_mutex_unlock(&shard->mutex);
+    return NULL;
+}
+
+// Stop the first `started` owner threads, then free the sharded hash map
+static void shardmap_stop(struct shardmap *map, usize started) {
+    for (usize i = 0; i < started; i++) {
+        // Wake and stop the owner
+        struct shard *shard = &map->shards[i];
+        pthread_mutex_lock(&shard->mutex);
+        shard->shutdown = true;
+        pthread_cond_signal(&shard->wake);
+        pthread_mutex_unlock(&shard->mutex);
+        pthread_join(shard->thread, NULL);
+    }
+    for (usize i = 0; i < map->nshards; i++) {
+        // Free the shard
+        struct shard *shard = &map->shards[i];
+        hashmap_drop(shard->map);
+        free(shard->jobs);
+        free(shard->spare);
+        pthread_cond_destroy(&shard->idle);
+        pthread_cond_destroy(&shard->wake);
+        pthread_mutex_destroy(&shard->mutex);
+        pthread_rwlock_destroy(&shard->lock);
+    }
+    free(map->shards);
+    free(map);
+}
+
+// Get the shard of a key
+static inline struct shard *shardmap_find(
+    const struct shardmap *map, const void *key
+) {
+    return &map->shards[shardmap_shard(map, key)];
+}
+
+/**
+ * Create a new sharded hash map.
+ *
+ * @param hash     Hash function for keys.
+ * @param cmp      Comparison function for keys.
+ * @param nshards  Number of shards, or 0 to use one per NUMA node.
+ * @return         Pointer to the newly-created sharded hash map, or `NULL` if
+ *                 memory allocation or thread creation failed.
+ */
+struct shardmap *shardmap_new(
+    u64 (*hash)(const void *key),
+    bool (*cmp)(const void *left, const void *right),
+    usize nshards
+) {
+    // Find the online NUMA nodes, assuming a single node if unknown
+    bool online[MAX_NODES] = {false};
+    usize nnodes =
+        parse_list("/sys/devices/system/node/online", online, MAX_NODES);
+    if (!nnodes) {
+        online[0] = true;
+        nnodes = 1;
+    }
+    if (nshards == 0)
+        // Use one shard per node
+        nshards = nnodes;
+
+    // Allocate memory for the sharded hash map and its shards
+    struct shardmap *map = malloc(sizeof(struct shardmap));
+    if (!map)
+        // Return `NULL` if memory allocation failed
+        return NULL;
+    *map = (struct shardmap){
+        .hash = hash,
+        .cmp = cmp,
+        .shards = aligned_alloc(
+            _Alignof(struct shard), nshards * sizeof(struct shard)
+        ),
+    };
+    if (!map->shards) {
+        // Return `NULL` if memory allocation failed
+        free(map);
+        return NULL;
+    }
+    memset(map->shards, 0, nshards * sizeof(struct shard));
+
+    // Initialize each shard, assigning nodes round-robin
+    map->nshards = nshards;
+    usize node = 0;
+    for (usize i = 0; i < nshards; i++, node++) {
+        struct shard *shard = &map->shards[i];
+        while (!online[node % MAX_NODES])
+            node++;
+        shard->node = node % MAX_NODES;
+        shard->owner = map;
+        pthread_rwlock_init(&shard->lock, NULL);
+        pthread_mutex_init(&shard->mutex, NULL);
+        pthread_cond_init(&shard->wake, NULL);
+        pthread_cond_init(&shard->idle, NULL);
+    }
+
+    // Start the owner of each shard
+    for (usize i = 0; i < nshards; i++) {
+        struct shard *shard = &map->shards[i];
+        if (pthread_create(&shard->thread, NULL, shard_main, shard)) {
+            // Stop the owners started so far
+            shardmap_stop(map, i);
+            return NULL;
+        }
+    }
+
+    // Wait for each owner to create its hash map
+    bool ok = true;
+    for (usize i = 0; i < nshards; i++) {
+        struct shard *shard = &map->shards[i];
+        pthread_mutex_lock(&shard->mutex);
+        while (!shard->ready)
+            pthread_cond_wait(&shard->idle, &shard->mutex);
+        ok &= shard->map != NULL;
+        pthread_mutex_unlock(&shard->mutex);
+    }
+    if (!ok) {
+        // Return `NULL` if memory allocation failed
+        shardmap_stop(map, nshards);
+        return NULL;
+    }
+
+    // Return the newly-created sharded hash map
+    return map;
+}
+
+/**
+ * Delete the sharded hash map.
+ *
+ * @param map  Pointer to the sharded hash map to delete.
+ */
+void shardmap_drop(struct shardmap *map) {
+    if (!map)
+        // Return early if the sharded hash map is `NULL`
+        return;
+    // Stop each of the owners, after they finish their work
+    shardmap_stop(map, map->nshards);
+}
+
+/**
+ * Get the number of shards in the sharded hash map.
+ *
+ * @param map  Pointer to the sharded hash map.
+ * @return     Number of shards, or 0 if the map is `NULL`.
+ */
+usize shardmap_nshards(const struct shardmap *map) {
+    if (!map)
+        // Return 0 if the sharded hash map is `NULL`
+        return 0;
+    return map->nshards;
+}
+
+/**
+ * Get the shard owning a key.
+ *
+ * @param map  Pointer to the sharded hash map.
+ * @param key  Key to look up.
+ * @return     Index of the shard owning the key.
+ */
+usize shardmap_shard(const struct shardmap *map, const void *key) {
+    // Remix the hash, so that the shard is independent of the bits used by
+    // the shard's own hash map, then take its high bits
+    u64 hash = u64_hash((const void *)(uintptr_t)map->hash(key));
+    return mulhi64(hash, map->nshards);
+}
+
+/**
+ * Get the NUMA node on which a shard is placed.
+ *
+ * @param map    Pointer to the sharded hash map.
+ * @param shard  Index of the shard.
+ * @return       Index of the NUMA node of the shard.
+ */
+usize shardmap_node(const struct shardmap *map, usize shard) {
+    return map->shards[shard].node;
+}
+
+/**
+ * Insert an item into the sharded hash map from the calling thread.
+ *
+ * @param map   Pointer to the sharded hash map.
+ * @param key   Key of the item to insert.
+ * @param data  Data of the item to insert.
+ * @return      `true` if the operation was successful, `false` otherwise.
+ */
+bool shardmap_insert(struct shardmap *map, const void *key, void *data) {
+    if (!map)
+        // Return `false` if the sharded hash map is `NULL`
+        return false;
+    struct shard *shard = shardmap_find(map, key);
+    pthread_rwlock_wrlock(&shard->lock);
+    bool ok = hashmap_insert(shard->map, key, data);
+    pthread_rwlock_unlock(&shard->lock);
+    return ok;
+}
+
+/**
+ * Remove an item with the given key from the sharded hash map.
+ *
+ * @param map  Pointer to the sharded hash map.
+ * @param key  Key of the item to remove.
+ * @return     Pointer to the removed data, or `NULL` if the key was not
+ *             found.
+ */
+void *shardmap_remove(struct shardmap *map, const void *key) {
+    if (!map)
+        // Return `NULL` if the sharded hash map is `NULL`
+        return NULL;
+    struct shard *shard = shardmap_find(map, key);
+    pthread_rwlock_wrlock(&shard->lock);
+    void *data = hashmap_remove(shard->map, key);
+    pthread_rwlock_unlock(&shard->lock);
+    return data;
+}
+
+/**
+ * Check if a key is in the sharded hash map.
+ *
+ * @param map  Pointer to the sharded hash map.
+ * @param key  Key to search for.
+ * @return     `true` if the key exists in the map, `false` otherwise.
+ */
+bool shardmap_contains(const struct shardmap *map, const void *key) {
+    if (!map)
+        // Return `false` if the sharded hash map is `NULL`
+        return false;
+    struct shard *shard = shardmap_find(map, key);
+    pthread_rwlock_rdlock(&shard->lock);
+    bool found = hashmap_contains(shard->map, key);
+    pthread_rwlock_unlock(&shard->lock);
+    return found;
+}
+
+/**
+ * Get the data associated with a key in the sharded hash map.
+ *
+ * @param map  Pointer to the sharded hash map.
+ * @param key  Key to look up.
+ * @return     Pointer to the data associated with the key, or `NULL` if the
+ *             key was not found.
+ */
+void *shardmap_get(const struct shardmap *map, const void *key) {
+    if (!map)
+        // Return `NULL` if the sharded hash map is `NULL`
+        return NULL;
+    struct shard *shard = shardmap_find(map, key);
+    pthread_rwlock_rdlock(&shard->lock);
+    void *data = hashmap_get(shard->map, key);
+    pthread_rwlock_unlock(&shard->lock);
+    return data;
+}
+
+/**
+ * Get the number of items in the sharded hash map.
+ *
+ * @param map  Pointer to the sharded hash map.
+ * @return     Number of items in the map, or 0 if the map is `NULL`.
+ */
+usize shardmap_len(const struct shardmap *map) {
+    if (!map)
+        // Return 0 if the sharded hash map is `NULL`
+        return 0;
+    // Sum the number of items in each shard
+    usize len = 0;
+    for (usize i = 0; i < map->nshards; i++) {
+        struct shard *shard = &map->shards[i];
+        pthread_rwlock_rdlock(&shard->lock);
+        len += hashmap_len(shard->map);
+        pthread_rwlock_unlock(&shard->lock);
+    }
+    return len;
+}
+
+/**
+ * Submit work on a key to the owner thread of its shard.
+ *
+ * @param map      Pointer to the sharded hash map.
+ * @param key      Key whose shard should run the work.
+ * @param func     Function to call with the shard's hash map.
+ * @param context  User-defined context to pass to the function.
+ * @return         `true` if the work was submitted, `false` if memory
+ *                 allocation failed.
+ */
+bool shardmap_submit(
+    struct shardmap *map,
+    const void *key,
+    void (*func)(struct hashmap *shard, const void *key, void *context),
+    void *context
+) {
+    if (!map || !func)
+        // Return `false` if the sharded hash map or function is `NULL`
+        return false;
+    struct shard *shard = shardmap_find(map, key);
+    pthread_mutex_lock(&shard->mutex);
+    if (shard->njobs == shard->capacity) {
+        // Grow the queue
+        usize capacity = shard->capacity ? shard->capacity * 2 : QUEUE_CAPACITY;
+        struct job *jobs = realloc(shard->jobs, capacity * sizeof(struct job));
+        if (!jobs) {
+            // Return `false` if memory allocation failed
+            pthread_mutex_unlock(&shard->mutex);
+            return false;
+        }
+        shard->jobs = jobs;
+        shard->capacity = capacity;
+    }
+    shard->jobs[shard->njobs++] = (struct job){
+        .func = func,
+        .key = key,
+        .context = context,
+    };
+    // Wake the owner if it may be waiting for work
+    if (shard->njobs == 1)
+        pthread_cond_signal(&shard->wake);
+    pthread_mutex_unlock(&shard->mutex);
+    return true;
+}
+
+/**
+ * Wait for all submitted work to finish.
+ *
+ * @param map  Pointer to the sharded hash map.
+ */
+void shardmap_wait(struct shardmap *map) {
+    if (!map)
+        // Return early if the sharded hash map is `NULL`
+        return;
+    for (usize i = 0; i < map->nshards; i++) {
+        // Wait for the owner to drain its queue
+        struct shard *shard = &map->shards[i];
+        pthread_mutex_lock(&shard->mutex);
+        while (shard->njobs || shard->busy)
+            pthread_cond_wait(&shard->idle, &shard->mutex);
+        pthread_mutex_unlock(&shard->mutex);
+    }
+}
@@ -0,0 +1,676 @@
+// File:        sketch.c
+// Author:      Zakhary Kaplan <https://zakhary.dev>
+// Created:     17 Oct 2026
+// SPDX-License-Identifier: MIT
+
+#include "zakc/sketch.h"
+
+#include <math.h>   // for log
+#include <stdint.h> // for UINT32_MAX
+#include <stdlib.h> // for free, {c,m,re}alloc
+#include <string.h> // for mem{cpy,move,set}
+
+#ifdef __SSE2__
+#include <emmintrin.h> // for _mm_*
+#endif
+
+#include "zakc/types.h" // for f64, u8, u32, u64, usize
+
+// Smallest and largest precision of a HyperLogLog
+#define HLL_MIN 4
+#define HLL_MAX 18
+// Size of the header of every serialized sketch
+#define HEADER 8
+
+// HyperLogLog structure
+struct hll {
+    // Number of bits of each hash selecting its register
+    u8 precision;
+    // Array of registers, or `NULL` while the HyperLogLog is sparse
+    u8 *regs;
+    // Sorted list of the registers which are set, each holding the index of
+    // the register above its 8-bit value
+    u32 *sparse;
+    // Number of registers in the list
+    usize nsparse;
+    // Capacity of the list
+    usize capacity;
+};
+
+// Count-Min sketch structure
+struct cms {
+    // Number of counters in each row, which is a power of 2
+    usize width;
+    // Number of rows
+    usize depth;
+    // Whether counters are updated conservatively
+    bool conservative;
+    // Total number of occurrences added
+    u64 total;
+    // Counters of each row, one row after another
+    u32 counters[];
+};
+
+// Mix the bits of a hash, so that weak hashes select registers and counters
+// evenly
+static inline u64 sketch_mix(u64 hash) {
+    hash ^= hash >> 33;
+    hash *= 0xff51afd7ed558ccdull;
+    hash ^= hash >> 33;
+    hash *= 0xc4ceb9fe1a85ec53ull;
+    hash ^= hash >> 33;
+    return hash;
+}
+
+// Write an integer in little-endian byte order
+static inline void sketch_put(u8 *buf, u64 value, usize size) {
+    for (usize i = 0; i < size; i++)
+        buf[i] = value >> (i * 8);
+}
+
+// Read an integer in little-endian byte order
+static inline u64 sketch_get(const u8 *buf, usize size) {
+    u64 value = 0;
+    for (usize i = 0; i < size; i++)
+        value |= (u64)buf[i] << (i * 8);
+    return value;
+}
+
+/*
+ * HyperLogLog
+ */
+
+// Form of a serialized HyperLogLog
+enum hll_form {
+    HllSparse,
+    HllDense,
+};
+
+// Get the number of registers of a HyperLogLog
+static inline usize hll_nregs(const struct hll *hll) {
+    return (usize)1 << hll->precision;
+}
+
+// Get the largest value a register of a given precision can hold
+static inline u8 hll_max_rank(u8 precision) {
+    return 64 - precision + 1;
+}
+
+// Replace the sparse list of a HyperLogLog with an array of every register
+static bool hll_densify(struct hll *hll) {
+    u8 *regs = calloc(hll_nregs(hll), sizeof(u8));
+    if (!regs)
+        // Return `false` if memory allocation failed
+        return false;
+    for (usize i = 0; i < hll->nsparse; i++)
+        regs[hll->sparse[i] >> 8] = (u8)hll->sparse[i];
+    free(hll->sparse);
+    hll->regs = regs;
+    hll->sparse = NULL;
+    hll->nsparse = 0;
+    hll->capacity = 0;
+    return true;
+}
+
+// Raise a register of a HyperLogLog to at least a given value
+static bool hll_set(struct hll *hll, u32 index, u8 rank) {
+    if (hll->regs) {
+        // Raise the register in place
+        if (rank > hll->regs[index])
+            hll->regs[index] = rank;
+        return true;
+    }
+
+    // Find the register in the sparse list
+    usize lo = 0;
+    usize hi = hll->nsparse;
+    while (lo < hi) {
+        usize mid = lo + (hi - lo) / 2;
+        if (hll->sparse[mid] >> 8 < index)
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+    if (lo < hll->nsparse && hll->sparse[lo] >> 8 == index) {
+        // Raise the register if it is already in the list
+        if (rank > (u8)hll->sparse[lo])
+            hll->sparse[lo] = index << 8 | rank;
+        return true;
+    }
+
+    if ((hll->nsparse + 1) * sizeof(u32) > hll_nregs(hll)) {
+        // Switch to the dense form once the list would outgrow it
+        if (!hll_densify(hll))
+            return false;
+        hll->regs[index] = rank;
+        return true;
+    }
+    if (hll->nsparse == hll->capacity) {
+        // Grow the list, never past the size of the dense form
+        usize capacity = hll->capacity ? hll->capacity * 2 : 4;
+        if (capacity > hll_nregs(hll) / sizeof(u32))
+            capacity = hll_nregs(hll) / sizeof(u32);
+        u32 *sparse = realloc(hll->sparse, capacity * sizeof(u32));
+        if (!sparse)
+            // Return `false` if memory allocation failed
+            return false;
+        hll->sparse = sparse;
+        hll->capacity = capacity;
+    }
+    // Insert the register into the list in order
+    memmove(
+        &hll->sparse[lo + 1],
+        &hll->sparse[lo],
+        (hll->nsparse - lo) * sizeof(u32)
+    );
+    hll->sparse[lo] = index << 8 | rank;
+    hll->nsparse++;
+    return true;
+}
+
+/**
+ * Create a new HyperLogLog.
+ *
+ * @param precision  Number of bits of each hash selecting its register,
+ *                   between 4 and 18.
+ * @return           Pointer to the newly-created HyperLogLog, or `NULL` if the
+ *                   precision is out of range or memory allocation failed.
+ */
+struct hll *hll_new(u8 precision) {
+    if (precision < HLL_MIN || precision > HLL_MAX)
+        // Return `NULL` if the precision is out of range
+        return NULL;
+    // Allocate memory for the HyperLogLog
+    struct hll *hll = malloc(sizeof(struct hll));
+    if (!hll)
+        // Return `NULL` if memory allocation failed
+        return NULL;
+
+    // Initialize the HyperLogLog to be empty and sparse
+    *hll = (struct hll){
+        .precision = precision,
+        .regs = NULL,
+        .sparse = NULL,
+        .nsparse = 0,
+        .capacity = 0,
+    };
+
+    // Return the newly-created HyperLogLog
+    return hll;
+}
+
+/**
+ * Delete the HyperLogLog.
+ *
+ * @param hll  Pointer to the HyperLogLog to delete.
+ */
+void hll_drop(struct hll *hll) {
+    if (!hll)
+        // Return early if the HyperLogLog is `NULL`
+        return;
+    // Free the registers, then the HyperLogLog
+    free(hll->regs);
+    free(hll->sparse);
+    free(hll);
+}
+
+/**
+ * Remove every key from the HyperLogLog, returning it to its sparse form.
+ *
+ * @param hll  Pointer to the HyperLogLog.
+ */
+void hll_clear(struct hll *hll) {
+    if (!hll)
+        // Return early if the HyperLogLog is `NULL`
+        return;
+    // Free the registers, leaving an empty sparse list
+    free(hll->regs);
+    free(hll->sparse);
+    *hll = (struct hll){.precision = hll->precision};
+}
+
+/**
+ * Add a key to the HyperLogLog.
+ *
+ * @param hll   Pointer to the HyperLogLog.
+ * @param hash  Hash of the key.
+ * @return      `true` if the operation was successful, `false` if memory
+ *              allocation failed.
+ */
+bool hll_add(struct hll *hll, u64 hash) {
+    if (!hll)
+        // Return `false` if the HyperLogLog is `NULL`
+        return false;
+    // Select a register with the top bits of the hash, then count the leading
+    // zeros of the rest, stopping at a guard bit
+    u8 p = hll->precision;
+    hash = sketch_mix(hash);
+    u32 index = hash >> (64 - p);
+    u8 rank = __builtin_clzll(hash << p | 1ull << (p - 1)) + 1;
+    return hll_set(hll, index, rank);
+}
+
+/**
+ * Estimate the number of distinct keys added to the HyperLogLog.
+ *
+ * @param hll  Pointer to the HyperLogLog.
+ * @return     Estimated number of distinct keys, or 0 if the HyperLogLog is
+ *             `NULL`.
+ */
+u64 hll_count(const struct hll *hll) {
+    if (!hll)
+        // Return zero if the HyperLogLog is `NULL`
+        return 0;
+
+    // Sum the harmonic terms of every register, counting those never set
+    usize m = hll_nregs(hll);
+    usize zeros = 0;
+    f64 sum = 0;
+    if (hll->regs) {
+        for (usize i = 0; i < m; i++) {
+            zeros += !hll->regs[i];
+            sum += 1.0 / (f64)(1ull << hll->regs[i]);
+        }
+    } else {
+        zeros = m - hll->nsparse;
+        sum = zeros;
+        for (usize i = 0; i < hll->nsparse; i++)
+            sum += 1.0 / (f64)(1ull << (u8)hll->sparse[i]);
+    }
+
+    // Take the bias-corrected harmonic mean of the registers
+    f64 alpha = m == 16   ? 0.673
+              : m == 32   ? 0.697
+              : m == 64   ? 0.709
+                          : 0.7213 / (1 + 1.079 / m);
+    f64 estimate = alpha * m * m / sum;
+    if (estimate <= 2.5 * m && zeros)
+        // Count the registers never set instead while most of them are
+        estimate = m * log((f64)m / zeros);
+    return (u64)(estimate + 0.5);
+}
+
+/**
+ * Merge the keys of one HyperLogLog into another.
+ *
+ * @param dst  Pointer to the HyperLogLog to merge into.
+ * @param src  Pointer to the HyperLogLog to merge from.
+ * @return     `true` if the operation was successful, `false` if the
+ *             HyperLogLogs differ in precision or memory allocation failed.
+ */
+bool hll_merge(struct hll *dst, const struct hll *src) {
+    if (!dst || !src || dst->precision != src->precision)
+        // Return `false` if the HyperLogLogs cannot be merged
+        return false;
+    if (dst == src)
+        // Return early if merging a HyperLogLog into itself
+        return true;
+
+    if (!src->regs) {
+        // Raise each register in the source's sparse list
+        for (usize i = 0; i < src->nsparse; i++)
+            if (!hll_set(dst, src->sparse[i] >> 8, (u8)src->sparse[i]))
+                return false;
+        return true;
+    }
+    if (!dst->regs && !hll_densify(dst))
+        // Return `false` if memory allocation failed
+        return false;
+
+    // Take the larger of each pair of registers, of which there are always a
+    // multiple of 16
+    usize m = hll_nregs(dst);
+#ifdef __SSE2__
+    for (usize i = 0; i < m; i += 16) {
+        __m128i a = _mm_loadu_si128((const __m128i *)&dst->regs[i]);
+        __m128i b = _mm_loadu_si128((const __m128i *)&src->regs[i]);
+        _mm_storeu_si128((__m128i *)&dst->regs[i], _mm_max_epu8(a, b));
+    }
+#else
+    for (usize i = 0; i < m; i++)
+        if (src->regs[i] > dst->regs[i])
+            dst->regs[i] = src->regs[i];
+#endif
+    return true;
+}
+
+/**
+ * Serialize the HyperLogLog into a buffer.
+ *
+ * @param hll  Pointer to the HyperLogLog.
+ * @param buf  Buffer to write to, or `NULL`.
+ * @param len  Size of the buffer, in bytes.
+ * @return     Size of the serialized form, in bytes, or 0 if the HyperLogLog
+ *             is `NULL`.
+ */
+usize hll_serialize(const struct hll *hll, u8 *buf, usize len) {
+    if (!hll)
+        // Return zero if the HyperLogLog is `NULL`
+        return 0;
+    // Store the registers as they are, or the sparse list after its length
+    usize size = hll->regs ? HEADER + hll_nregs(hll)
+                           : HEADER + sizeof(u32) * (1 + hll->nsparse);
+    if (!buf || len < size)
+        // Return the size needed if the buffer is too small
+        return size;
+
+    // Write the header, then the registers
+    memcpy(buf, "HLL", 3);
+    buf[3] = hll->precision;
+    sketch_put(&buf[4], hll->regs ? HllDense : HllSparse, 4);
+    if (hll->regs) {
+        memcpy(&buf[HEADER], hll->regs, hll_nregs(hll));
+    } else {
+        sketch_put(&buf[HEADER], hll->nsparse, sizeof(u32));
+        for (usize i = 0; i < hll->nsparse; i++)
+            sketch_put(
+                &buf[HEADER + sizeof(u32) * (1 + i)],
+                hll->sparse[i],
+                sizeof(u32)
+            );
+    }
+    return size;
+}
+
+/**
+ * Create a HyperLogLog from its serialized form.
+ *
+ * @param buf  Buffer to read from.
+ * @param len  Size of the buffer, in bytes.
+ * @return     Pointer to the newly-created HyperLogLog, or `NULL` if the
+ *             buffer does not hold a serialized HyperLogLog or memory
+ *             allocation failed.
+ */
+struct hll *hll_deserialize(const u8 *buf, usize len) {
+    if (!buf || len < HEADER || memcmp(buf, "HLL", 3))
+        // Return `NULL` if the buffer does not hold a HyperLogLog
+        return NULL;
+    struct hll *hll = hll_new(buf[3]);
+    if (!hll)
+        // Return `NULL` if the precision is invalid or memory allocation
+        // failed
+        return NULL;
+    usize m = hll_nregs(hll);
+    u8 max = hll_max_rank(hll->precision);
+
+    u64 form = sketch_get(&buf[4], 4);
+    if (form == HllDense && len == HEADER + m) {
+        // Copy the registers, checking that each is in range
+        if (!hll_densify(hll))
+            goto fail;
+        memcpy(hll->regs, &buf[HEADER], m);
+        for (usize i = 0; i < m; i++)
+            if (hll->regs[i] > max)
+                goto fail;
+        return hll;
+    }
+    if (form != HllSparse || len < HEADER + sizeof(u32))
+        goto fail;
+
+    // Read the sparse list, checking that it is sorted and in range
+    u64 nsparse = sketch_get(&buf[HEADER], sizeof(u32));
+    if (nsparse > m / sizeof(u32)
+        || len != HEADER + sizeof(u32) * (1 + nsparse))
+        goto fail;
+    if (nsparse) {
+        hll->sparse = malloc(nsparse * sizeof(u32));
+        if (!hll->sparse)
+            goto fail;
+        hll->capacity = nsparse;
+    }
+    for (usize i = 0; i < nsparse; i++) {
+        u32 entry = sketch_get(&buf[HEADER + sizeof(u32) * (1 + i)], 4);
+        u8 rank = entry;
+        if ((entry >> 8) >= m || !rank || rank > max
+            || (i && entry >> 8 <= hll->sparse[i - 1] >> 8))
+            goto fail;
+        hll->sparse[hll->nsparse++] = entry;
+    }
+    return hll;
+
+fail:
+    // Return `NULL` if the buffer is invalid or memory allocation failed
+    hll_drop(hll);
+    return NULL;
+}
+
+/*
+ * Count-Min Sketch
+ */
+
+// Add two counts, saturating rather than overflowing
+static inline u32 cms_sum(u32 left, u32 right) {
+    u32 sum = left + right;
+    return sum < left ? UINT32_MAX : sum;
+}
+
+// Get the counter of a key in a row of the sketch, given the two halves of
+// the key's hash from which the counters of every row are derived
+static inline usize cms_index(
+    const struct cms *cms, u64 h1, u64 h2, usize row
+) {
+    return row * cms->width + ((h1 + row * h2) & (cms->width - 1));
+}
+
+/**
+ * Create a new Count-Min sketch.
+ *
+ * @param width         Number of counters in each row, rounded up to a power
+ *                      of 2.
+ * @param depth         Number of rows.
+ * @param conservative  Whether to update counters conservatively.
+ * @return              Pointer to the newly-created sketch, or `NULL` if the
+ *                      width or depth is 0 or memory allocation failed.
+ */
+struct cms *cms_new(usize width, usize depth, bool conservative) {
+    if (!width || !depth || width > ((usize)-1 >> 1) + 1)
+        // Return `NULL` if the dimensions are invalid
+        return NULL;
+    // Round the width up to a power of 2
+    usize pow = 1;
+    while (pow < width)
+        pow <<= 1;
+    if (pow > ((usize)-1 - sizeof(struct cms)) / sizeof(u32) / depth)
+        // Return `NULL` if the sketch could never fit in memory
+        return NULL;
+
+    // Allocate memory for the sketch and its counters, all zero
+    struct cms *cms = calloc(1, sizeof(struct cms) + pow * depth * sizeof(u32));
+    if (!cms)
+        // Return `NULL` if memory allocation failed
+        return NULL;
+    cms->width = pow;
+    cms->depth = depth;
+    cms->conservative = conservative;
+
+    // Return the newly-created sketch
+    return cms;
+}
+
+/**
+ * Delete the Count-Min sketch.
+ *
+ * @param cms  Pointer to the sketch to delete.
+ */
+void cms_drop(struct cms *cms) {
+    // Free the sketch along with its counters
+    free(cms);
+}
+
+/**
+ * Reset every counter of the Count-Min sketch to zero.
+ *
+ * @param cms  Pointer to the sketch.
+ */
+void cms_clear(struct cms *cms) {
+    if (!cms)
+        // Return early if the sketch is `NULL`
+        return;
+    // Zero every counter and the total
+    memset(cms->counters, 0, cms->width * cms->depth * sizeof(u32));
+    cms->total = 0;
+}
+
+/**
+ * Add a number of occurrences of a key to the Count-Min sketch.
+ *
+ * @param cms    Pointer to the sketch.
+ * @param hash   Hash of the key.
+ * @param count  Number of occurrences to add.
+ */
+void cms_add(struct cms *cms, u64 hash, u32 count) {
+    if (!cms || !count)
+        // Return early if the sketch is `NULL` or there is nothing to add
+        return;
+    cms->total += count;
+    u64 h1 = sketch_mix(hash);
+    u64 h2 = sketch_mix(h1) | 1;
+
+    if (!cms->conservative) {
+        // Add the count to the key's counter in every row
+        for (usize row = 0; row < cms->depth; row++) {
+            u32 *counter = &cms->counters[cms_index(cms, h1, h2, row)];
+            *counter = cms_sum(*counter, count);
+        }
+        return;
+    }
+
+    // Raise only those of the key's counters which are below its new
+    // estimate, as the others already account for its occurrences
+    u32 estimate = UINT32_MAX;
+    for (usize row = 0; row < cms->depth; row++) {
+        u32 counter = cms->counters[cms_index(cms, h1, h2, row)];
+        if (counter < estimate)
+            estimate = counter;
+    }
+    estimate = cms_sum(estimate, count);
+    for (usize row = 0; row < cms->depth; row++) {
+        u32 *counter = &cms->counters[cms_index(cms, h1, h2, row)];
+        if (*counter < estimate)
+            *counter = estimate;
+    }
+}
+
+/**
+ * Estimate the number of occurrences of a key in the Count-Min sketch.
+ *
+ * @param cms   Pointer to the sketch.
+ * @param hash  Hash of the key.
+ * @return      Estimated number of occurrences, which is never less than the
+ *              true number, or 0 if the sketch is `NULL`.
+ */
+u32 cms_estimate(const struct cms *cms, u64 hash) {
+    if (!cms)
+        // Return zero if the sketch is `NULL`
+        return 0;
+    // Take the least of the key's counters, which has the fewest collisions
+    u64 h1 = sketch_mix(hash);
+    u64 h2 = sketch_mix(h1) | 1;
+    u32 estimate = UINT32_MAX;
+    for (usize row = 0; row < cms->depth; row++) {
+        u32 counter = cms->counters[cms_index(cms, h1, h2, row)];
+        if (counter < estimate)
+            estimate = counter;
+    }
+    return estimate;
+}
+
+/**
+ * Get the total number of occurrences added to the Count-Min sketch.
+ *
+ * @param cms  Pointer to the sketch.
+ * @return     Total number of occurrences, or 0 if the sketch is `NULL`.
+ */
+u64 cms_total(const struct cms *cms) {
+    if (!cms)
+        // Return zero if the sketch is `NULL`
+        return 0;
+    // Return the total number of occurrences
+    return cms->total;
+}
+
+/**
+ * Merge the counts of one Count-Min sketch into another.
+ *
+ * @param dst  Pointer to the sketch to merge into.
+ * @param src  Pointer to the sketch to merge from.
+ * @return     `true` if the operation was successful, `false` if the
+ *             sketches differ in width or depth.
+ */
+bool cms_merge(struct cms *dst, const struct cms *src) {
+    if (!dst || !src || dst->width != src->width || dst->depth != src->depth)
+        // Return `false` if the sketches cannot be merged
+        return false;
+    // Add the counters pairwise, in a loop simple enough to be vectorized
+    usize n = dst->width * dst->depth;
+    for (usize i = 0; i < n; i++)
+        dst->counters[i] = cms_sum(dst->counters[i], src->counters[i]);
+    dst->total += src->total;
+    return true;
+}
+
+/**
+ * Serialize the Count-Min sketch into a buffer.
+ *
+ * @param cms  Pointer to the sketch.
+ * @param buf  Buffer to write to, or `NULL`.
+ * @param len  Size of the buffer, in bytes.
+ * @return     Size of the serialized form, in bytes, or 0 if the sketch is
+ *             `NULL`.
+ */
+usize cms_serialize(const struct cms *cms, u8 *buf, usize len) {
+    if (!cms)
+        // Return zero if the sketch is `NULL`
+        return 0;
+    // Store the dimensions and total, then every counter
+    usize n = cms->width * cms->depth;
+    usize size = HEADER + 3 * sizeof(u64) + n * sizeof(u32);
+    if (!buf || len < size)
+        // Return the size needed if the buffer is too small
+        return size;
+
+    // Write the header, then the counters
+    memcpy(buf, "CMS", 3);
+    buf[3] = cms->conservative;
+    sketch_put(&buf[4], 0, 4);
+    sketch_put(&buf[HEADER], cms->width, sizeof(u64));
+    sketch_put(&buf[HEADER + 8], cms->depth, sizeof(u64));
+    sketch_put(&buf[HEADER + 16], cms->total, sizeof(u64));
+    u8 *counters = &buf[HEADER + 3 * sizeof(u64)];
+    for (usize i = 0; i < n; i++)
+        sketch_put(&counters[i * sizeof(u32)], cms->counters[i], sizeof(u32));
+    return size;
+}
+
+/**
+ * Create a Count-Min sketch from its serialized form.
+ *
+ * @param buf  Buffer to read from.
+ * @param len  Size of the buffer, in bytes.
+ * @return     Pointer to the newly-created sketch, or `NULL` if the buffer
+ *             does not hold a serialized sketch or memory allocation failed.
+ */
+struct cms *cms_deserialize(const u8 *buf, usize len) {
+    usize head = HEADER + 3 * sizeof(u64);
+    if (!buf || len < head || memcmp(buf, "CMS", 3) || buf[3] > 1)
+        // Return `NULL` if the buffer does not hold a sketch
+        return NULL;
+    u64 width = sketch_get(&buf[HEADER], sizeof(u64));
+    u64 depth = sketch_get(&buf[HEADER + 8], sizeof(u64));
+    if (!width || !depth || width & (width - 1)
+        || width > (len - head) / sizeof(u32) / depth
+        || len != head + width * depth * sizeof(u32))
+        // Return `NULL` if the dimensions do not match the buffer
+        return NULL;
+
+    // Create a sketch of the same dimensions, then read its counters
+    struct cms *cms = cms_new(width, depth, buf[3]);
+    if (!cms)
+        // Return `NULL` if memory allocation failed
+        return NULL;
+    cms->total = sketch_get(&buf[HEADER + 16], sizeof(u64));
+    const u8 *counters = &buf[head];
+    for (usize i = 0; i < width * depth; i++)
+        cms->counters[i] = sketch_get(&counters[i * sizeof(u32)], sizeof(u32));
+    return cms;
+}
@@ -0,0 +1,487 @@
+// File:        skiplist.c
+// Author:      Zakhary Kaplan <https://zakhary.dev>
+// Created:     17 Oct 2026
+// SPDX-License-Identifier: MIT
+
+#include "zakc/skiplist.h"
+
+#include <stdatomic.h> // for atomic_*
+#include <stdint.h>    // for uintptr_t
+#include <stdlib.h>    // for free, malloc
+
+#include "zakc/ebr.h"   // for ebr
+#include "zakc/types.h" // for i32, u{32,64}, usize
+
+// Maximum height of a node
+#define HEIGHT 32
+
+// Mark bit of a next pointer, set once its node is being removed
+#define MARK ((uintptr_t)1)
+#define ptr(next)    ((struct snode *)((next) & ~MARK))
+#define marked(next) ((next) & MARK)
+
+// Sentinel data of an item which has been logically removed
+static char tombstone;
+#define TOMBSTONE ((void *)&tombstone)
+
+// Skip list node structure
+struct snode {
+    // Key of the item
+    const void *key;
+    // Data of the item, or `TOMBSTONE` once removed
+    _Atomic(void *) data;
+    // Number of outstanding owners (the inserter and the list)
+    atomic_uint refs;
+    // Number of levels the node is linked into
+    u32 height;
+    // Next node at each level, with the mark bit
+    _Atomic(uintptr_t) next[];
+};
+
+// Skip list structure
+struct skiplist {
+    // Comparison function for keys
+    i32 (*cmp)(const void *left, const void *right);
+    // Sentinel node before the first item
+    struct snode *head;
+    // Number of items in the list
+    atomic_size_t len;
+    // Reclamation domain of removed nodes
+    struct ebr *ebr;
+};
+
+// State of the current thread's random number generator
+static _Thread_local u64 seed;
+
+/*
+ * Nodes
+ */
+
+// Choose the height of a new node, with each level half as likely as the last
+static u32 snode_height(void) {
+    if (!seed)
+        // Seed the generator from the address of the thread's own state
+        seed = (u64)(uintptr_t)&seed * 0x9e3779b97f4a7c15 | 1;
+    seed ^= seed << 13;
+    seed ^= seed >> 7;
+    seed ^= seed << 17;
+    return __builtin_ctzll(seed | (u64)1 << (HEIGHT - 1)) + 1;
+}
+
+// Create a new node
+static struct snode *snode_new(const void *key, void *data, u32 height) {
+    struct snode *node =
+        malloc(sizeof(struct snode) + height * sizeof(uintptr_t));
+    if (!node)
+        return NULL;
+    node->key = key;
+    atomic_init(&node->data, data);
+    atomic_init(&node->refs, 2);
+    node->height = height;
+    for (u32 i = 0; i < height; i++)
+        atomic_init(&node->next[i], 0);
+    return node;
+}
+
+// Mark every level of a node, from the top down, so that it can be unlinked
+static void snode_mark(struct snode *node) {
+    for (u32 i = node->height; i-- > 0;)
+        atomic_fetch_or(&node->next[i], MARK);
+}
+
+// Release one owner of a node, retiring it once both owners are done
+static void snode_release(struct skiplist *list, struct snode *node) {
+    // A node which cannot be retired for lack of memory is leaked
+    if (atomic_fetch_sub(&node->refs, 1) == 1)
+        ebr_retire(list->ebr, node, free);
+}
+
+/*
+ * Searching
+ */
+
+// Find the predecessors and successors of a key at every level, unlinking any
+// marked nodes along the way
+static bool skiplist_find(
+    struct skiplist *list,
+    const void *key,
+    struct snode **preds,
+    struct snode **succs
+) {
+retry:;
+    struct snode *pred = list->head;
+    struct snode *curr = NULL;
+    for (u32 level = HEIGHT; level-- > 0;) {
+        curr = ptr(atomic_load(&pred->next[level]));
+        while (curr) {
+            uintptr_t next = atomic_load(&curr->next[level]);
+            // Unlink marked nodes
+            while (marked(next)) {
+                uintptr_t expected = (uintptr_t)curr;
+                if (!atomic_compare_exchange_strong(
+                        &pred->next[level], &expected, (uintptr_t)ptr(next)
+                    ))
+                    // Start over if the predecessor changed or was marked
+                    goto retry;
+                curr = ptr(next);
+                if (!curr)
+                    break;
+                next = atomic_load(&curr->next[level]);
+            }
+            if (!curr || list->cmp(curr->key, key) >= 0)
+                break;
+            pred = curr;
+            curr = ptr(next);
+        }
+        preds[level] = pred;
+        succs[level] = curr;
+    }
+    return curr && list->cmp(curr->key, key) == 0;
+}
+
+// Find the first present node whose key is not less than a given key, without
+// unlinking any nodes
+static struct snode *skiplist_seek(
+    const struct skiplist *list, const void *key
+) {
+    struct snode *pred = list->head;
+    struct snode *curr = ptr(atomic_load(&pred->next[0]));
+    for (u32 level = HEIGHT; key && level-- > 0;) {
+        curr = ptr(atomic_load(&pred->next[level]));
+        while (curr && list->cmp(curr->key, key) < 0) {
+            pred = curr;
+            curr = ptr(atomic_load(&curr->next[level]));
+        }
+    }
+    // Skip over nodes which are being removed
+    while (curr && (marked(atomic_load(&curr->next[0])) ||
+                    atomic_load(&curr->data) == TOMBSTONE))
+        curr = ptr(atomic_load(&curr->next[0]));
+    return curr;
+}
+
+// Get the next present node at the bottom level
+static struct snode *skiplist_next(struct snode *node) {
+    do
+        node = ptr(atomic_load(&node->next[0]));
+    while (node && (marked(atomic_load(&node->next[0])) ||
+                    atomic_load(&node->data) == TOMBSTONE));
+    return node;
+}
+
+/**
+ * Create a new skip list.
+ *
+ * @param cmp  Comparison function for keys.
+ * @return     Pointer to the newly-created skip list, or `NULL` if memory
+ *             allocation failed.
+ */
+struct skiplist *skiplist_new(i32 (*cmp)(const void *left, const void *right)) {
+    // Allocate memory for the skip list
+    struct skiplist *list = malloc(sizeof(struct skiplist));
+    if (!list)
+        // Return `NULL` if memory allocation failed
+        return NULL;
+    // Allocate the sentinel node at full height, and the reclamation domain
+    struct snode *head = snode_new(NULL, NULL, HEIGHT);
+    struct ebr *ebr = ebr_new(EbrEpoch);
+    if (!head || !ebr) {
+        // Return `NULL` if memory allocation failed
+        free(head);
+        ebr_drop(ebr);
+        free(list);
+        return NULL;
+    }
+    // Initialize the skip list
+    *list = (struct skiplist){
+        .cmp = cmp,
+        .head = head,
+        .ebr = ebr,
+    };
+    atomic_init(&list->len, 0);
+    // Return the newly-created skip list
+    return list;
+}
+
+/**
+ * Delete the skip list.
+ *
+ * @param list  Pointer to the skip list to delete.
+ */
+void skiplist_drop(struct skiplist *list) {
+    if (!list)
+        // Return early if the skip list is `NULL`
+        return;
+    // Free every node still in the list
+    struct snode *node = list->head;
+    while (node) {
+        struct snode *next = ptr(atomic_load(&node->next[0]));
+        free(node);
+        node = next;
+    }
+    // Free every retired node
+    ebr_drop(list->ebr);
+    // Free the skip list
+    free(list);
+}
+
+/**
+ * Insert an item into the skip list.
+ *
+ * @param list  Pointer to the skip list.
+ * @param key   Key of the item to insert.
+ * @param data  Data of the item to insert.
+ * @return      `true` if the operation was successful, `false` otherwise.
+ */
+bool skiplist_insert(struct skiplist *list, const void *key, void *data) {
+    if (!list)
+        // Return `false` if the skip list is `NULL`
+        return false;
+    if (!ebr_enter(list->ebr))
+        // Return `false` if unable to register the thread
+        return false;
+    struct snode *preds[HEIGHT], *succs[HEIGHT];
+    struct snode *node = NULL;
+    for (;;) {
+        if (skiplist_find(list, key, preds, succs)) {
+            // Replace the data of an existing item
+            struct snode *curr = succs[0];
+            void *old = atomic_load(&curr->data);
+            if (old == TOMBSTONE) {
+                // Help finish removing the item, then try again
+                snode_mark(curr);
+                continue;
+            }
+            if (!atomic_compare_exchange_strong(&curr->data, &old, data))
+                continue;
+            free(node);
+            ebr_exit(list->ebr);
+            return true;
+        }
+        // Create the node once it is known to be needed
+        if (!node && !(node = snode_new(key, data, snode_height()))) {
+            // Return `false` if memory allocation failed
+            ebr_exit(list->ebr);
+            return false;
+        }
+        for (u32 i = 0; i < node->height; i++)
+            atomic_store_explicit(
+                &node->next[i], (uintptr_t)succs[i], memory_order_relaxed
+            );
+        // Link the node into the bottom level, which inserts the item
+        uintptr_t expected = (uintptr_t)succs[0];
+        if (atomic_compare_exchange_strong(
+                &preds[0]->next[0], &expected, (uintptr_t)node
+            ))
+            break;
+    }
+    atomic_fetch_add(&list->len, 1);
+    // Link the node into each higher level, unless it is already being removed
+    for (u32 i = 1; i < node->height; i++) {
+        for (;;) {
+            uintptr_t next = atomic_load(&node->next[i]);
+            if (marked(next))
+                goto linked;
+            if (ptr(next) != succs[i] &&
+                !atomic_compare_exchange_strong(
+                    &node->next[i], &next, (uintptr_t)succs[i]
+                ))
+                goto linked;
+            uintptr_t expected = (uintptr_t)succs[i];
+            if (atomic_compare_exchange_strong(
+                    &preds[i]->next[i], &expected, (uintptr_t)node
+                ))
+                break;
+            skiplist_find(list, key, preds, succs);
+        }
+    }
+linked:
+    // Make sure the node is fully unlinked if it was removed while linking
+    if (marked(atomic_load(&node->next[0])))
+        skiplist_find(list, key, preds, succs);
+    snode_release(list, node);
+    ebr_exit(list->ebr);
+    return true;
+}
+
+/**
+ * Remove an item with the given key from the skip list.
+ *
+ * @param list  Pointer to the skip list.
+ * @param key   Key of the item to remove.
+ * @return      Pointer to the removed data, or `NULL` if the key was not
+ *              found.
+ */
+void *skiplist_remove(struct skiplist *list, const void *key) {
+    if (!list)
+        // Return `NULL` if the skip list is `NULL`
+        return NULL;
+    if (!ebr_enter(list->ebr))
+        // Return `NULL` if unable to register the thread
+        return NULL;
+    struct snode *preds[HEIGHT], *succs[HEIGHT];
+    void *data = NULL;
+    while (skiplist_find(list, key, preds, succs)) {
+        struct snode *curr = succs[0];
+        void *old = atomic_load(&curr->data);
+        if (old == TOMBSTONE) {
+            // Help finish a concurrent removal, then try again
+            snode_mark(curr);
+            continue;
+        }
+        // Logically remove the item by replacing its data with a tombstone
+        if (!atomic_compare_exchange_strong(&curr->data, &old, TOMBSTONE))
+            continue;
+        atomic_fetch_sub(&list->len, 1);
+        data = old;
+        // Physically unlink the node from every level
+        snode_mark(curr);
+        skiplist_find(list, key, preds, succs);
+        snode_release(list, curr);
+        break;
+    }
+    ebr_exit(list->ebr);
+    return data;
+}
+
+/**
+ * Check if a key is in the skip list.
+ *
+ * @param list  Pointer to the skip list.
+ * @param key   Key to search for.
+ * @return      `true` if the key exists in the skip list, `false` otherwise.
+ */
+bool skiplist_contains(const struct skiplist *list, const void *key) {
+    if (!list)
+        // Return `false` if the skip list is `NULL`
+        return false;
+    if (!ebr_enter(list->ebr))
+        // Return `false` if unable to register the thread
+        return false;
+    struct snode *node = skiplist_seek(list, key);
+    bool found = node && list->cmp(node->key, key) == 0;
+    ebr_exit(list->ebr);
+    return found;
+}
+
+/**
+ * Get the data associated with a key in the skip list.
+ *
+ * @param list  Pointer to the skip list.
+ * @param key   Key to look up.
+ * @return      Pointer to the data associated with the key, or `NULL` if the
+ *              key was not found.
+ */
+void *skiplist_get(const struct skiplist *list, const void *key) {
+    if (!list)
+        // Return `NULL` if the skip list is `NULL`
+        return NULL;
+    if (!ebr_enter(list->ebr))
+        // Return `NULL` if unable to register the thread
+        return NULL;
+    struct snode *node = skiplist_seek(list, key);
+    void *data = NULL;
+    if (node && list->cmp(node->key, key) == 0) {
+        data = atomic_load(&node->data);
+        if (data == TOMBSTONE)
+            data = NULL;
+    }
+    ebr_exit(list->ebr);
+    return data;
+}
+
+/**
+ * Find the first item whose key is not less than a given key.
+ *
+ * @param list   Pointer to the skip list.
+ * @param key    Key to search for.
+ * @param found  Optional pointer to store the key of the found item.
+ * @return       Pointer to the data of the found item, or `NULL` if every key
+ *               is less than the given key.
+ */
+void *skiplist_lower_bound(
+    const struct skiplist *list, const void *key, const void **found
+) {
+    if (!list)
+        // Return `NULL` if the skip list is `NULL`
+        return NULL;
+    if (!ebr_enter(list->ebr))
+        // Return `NULL` if unable to register the thread
+        return NULL;
+    struct snode *node = skiplist_seek(list, key);
+    void *data = NULL;
+    if (node) {
+        data = atomic_load(&node->data);
+        if (data == TOMBSTONE)
+            data = NULL;
+        if (found)
+            *found = node->key;
+    }
+    ebr_exit(list->ebr);
+    return data;
+}
+
+/**
+ * Get the number of items in the skip list.
+ *
+ * @param list  Pointer to the skip list.
+ * @return      Number of items in the skip list, or 0 if the list is `NULL`.
+ */
+usize skiplist_len(const struct skiplist *list) {
+    if (!list)
+        // Return zero if the skip list is `NULL`
+        return 0;
+    // Return the number of items in the skip list
+    return atomic_load(&list->len);
+}
+
+/**
+ * Iterate over the items in the skip list in order of their keys.
+ *
+ * @param list      Pointer to the skip list.
+ * @param callback  Callback function to call for each item.
+ * @param context   User-defined context to pass to the callback function.
+ */
+void skiplist_iter(
+    const struct skiplist *list,
+    void (*callback)(const void *key, void *data, void *context),
+    void *context
+) {
+    // Iterate over the unbounded range
+    skiplist_range(list, NULL, NULL, callback, context);
+}
+
+/**
+ * Iterate over the items in a range of keys in order.
+ *
+ * @param list      Pointer to the skip list.
+ * @param lo        First key of the range, or `NULL` for no lower bound.
+ * @param hi        Key one past the end of the range, or `NULL` for no upper
+ *                  bound.
+ * @param callback  Callback function to call for each item.
+ * @param context   User-defined context to pass to the callback function.
+ */
+void skiplist_range(
+    const struct skiplist *list,
+    const void *lo,
+    const void *hi,
+    void (*callback)(const void *key, void *data, void *context),
+    void *context
+) {
+    if (!list || !callback)
+        // Return early if the skip list or callback is `NULL`
+        return;
+    if (!ebr_enter(list->ebr))
+        // Return early if unable to register the thread
+        return;
+    // Walk the bottom level from the start of the range
+    for (struct snode *node = skiplist_seek(list, lo); node;
+         node = skiplist_next(node)) {
+        if (hi && list->cmp(node->key, hi) >= 0)
+            break;
+        void *data = atomic_load(&node->data);
+        if (data != TOMBSTONE)
+            callback(node->key, data, context);
+    }
+    ebr_exit(list->ebr);
+}
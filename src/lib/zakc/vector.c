@@ -5,10 +5,11 @@
 
 #include "zakc/vector.h"
 
-#include <stdlib.h> // for free, {m,re}alloc
-#include <string.h> // for memset
+#include <stdint.h> // for uintptr_t
+#include <stdlib.h> // for free, qsort, {c,m,re}alloc
+#include <string.h> // for mem{cpy,set}
 
-#include "zakc/types.h" // for usize
+#include "zakc/types.h" // for i32, usize
 
 // Vector structure
 struct vector {
@@ -18,8 +19,28 @@ struct vector {
     usize capacity;
     // Length of the array
     usize len;
+    // Number of elements that fit in the inline storage
+    usize ninline;
+    // Destructor for elements, or `NULL` if elements are not owned
+    void (*data_free)(void *data);
+    // Whether the vector lives in caller-provided memory, and never grows
+    // past its inline storage
+    bool fixed;
+    // Inline storage for the first `ninline` elements
+    void *local[];
 };
 
+_Static_assert(
+    sizeof(struct vector) <= VECTOR_SIZEOF(0), "VECTOR_SIZEOF is too small"
+);
+
+// Halve the capacity of the vector once it is less than a quarter full, so
+// that alternating pushes and pops never reallocate every time
+static inline void vector_shrink(struct vector *vec) {
+    if (vec->len < vec->capacity / 4 && vec->capacity > vec->ninline)
+        vector_reserve(vec, vec->capacity / 2);
+}
+
 /**
  * Create a new vector.
  *
@@ -27,23 +48,150 @@ struct vector {
  *          allocation failed.
  */
 struct vector *vector_new(void) {
-    // Allocate memory for the vector
-    struct vector *vec = malloc(sizeof(struct vector));
+    // Create a vector without any inline storage
+    return vector_with_inline(0);
+}
+
+/**
+ * Create a new vector with inline storage.
+ *
+ * The first `n` elements are stored inside the vector itself, so no further
+ * memory is allocated until the vector grows past `n` elements.
+ *
+ * @param n  Number of elements to store inline.
+ * @return   Pointer to the newly-created vector, or `NULL` if memory
+ *           allocation failed.
+ */
+struct vector *vector_with_inline(usize n) {
+    // Allocate memory for the vector and its inline storage
+    struct vector *vec = malloc(sizeof(struct vector) + n * sizeof(void *));
     if (!vec)
         // Return `NULL` if memory allocation failed
         return NULL;
 
-    // Initialize the vector to have no capacity and no length
+    // Initialize the vector to use its inline storage, if any
     *vec = (struct vector){
-        .capacity = 0,
+        .capacity = n,
         .len = 0,
-        .data = NULL,
+        .data = n ? vec->local : NULL,
+        .ninline = n,
     };
 
     // Return the newly-created vector
     return vec;
 }
 
+/**
+ * Create a new fixed-capacity vector in caller-provided memory.
+ *
+ * @param buf  Pointer to the buffer.
+ * @param cap  Number of elements the vector can hold.
+ * @return     Pointer to the vector, which is at the start of the buffer, or
+ *             `NULL` if the buffer is `NULL` or misaligned.
+ */
+struct vector *vector_init_in(void *buf, usize cap) {
+    if (!buf || (uintptr_t)buf % _Alignof(struct vector))
+        // Return `NULL` if the buffer cannot hold a vector
+        return NULL;
+    struct vector *vec = buf;
+
+    // Initialize the vector to use only its inline storage
+    *vec = (struct vector){
+        .capacity = cap,
+        .len = 0,
+        .data = cap ? vec->local : NULL,
+        .ninline = cap,
+        .fixed = true,
+    };
+
+    // Return the vector at the start of the buffer
+    return vec;
+}
+
+/**
+ * Create a new vector which takes ownership of an existing array.
+ *
+ * @param data      Pointer to an array allocated with `malloc()`, or `NULL`
+ *                  if the capacity is 0.
+ * @param len       Number of elements in the array.
+ * @param capacity  Number of elements the array can hold.
+ * @return          Pointer to the newly-created vector, or `NULL` if the
+ *                  arguments are invalid or memory allocation failed, in
+ *                  which case the array is still owned by the caller.
+ */
+struct vector *vector_from_raw(void **data, usize len, usize capacity) {
+    if (len > capacity || (!data && capacity))
+        // Return `NULL` if the array cannot hold its elements
+        return NULL;
+    // Allocate memory for the vector without any inline storage
+    struct vector *vec = malloc(sizeof(struct vector));
+    if (!vec)
+        // Return `NULL` if memory allocation failed
+        return NULL;
+
+    // Initialize the vector to use the array as it is
+    *vec = (struct vector){
+        .data = capacity ? data : NULL,
+        .capacity = capacity,
+        .len = len,
+    };
+
+    // Return the newly-created vector
+    return vec;
+}
+
+/**
+ * Delete the vector, releasing ownership of its array to the caller.
+ *
+ * @param vec       Pointer to the vector to delete.
+ * @param len       Where to store the number of elements, or `NULL`.
+ * @param capacity  Where to store the number of elements the array can hold,
+ *                  or `NULL`.
+ * @return          Pointer to the array, to be freed with `free()`, or `NULL`
+ *                  if the vector is `NULL`, has no array, or memory
+ *                  allocation failed.
+ */
+void **vector_into_raw(struct vector *vec, usize *len, usize *capacity) {
+    if (!vec)
+        // Return `NULL` if the vector is `NULL`
+        return NULL;
+    void **data = vec->data;
+    usize cap = vec->capacity;
+    if (len)
+        *len = vec->len;
+    if (data && data == vec->local) {
+        // Copy the elements out of the inline storage, which is freed along
+        // with the vector
+        cap = vec->len;
+        data = cap ? malloc(cap * sizeof(void *)) : NULL;
+        if (cap && !data)
+            // Return `NULL` if memory allocation failed, keeping the vector
+            return NULL;
+        if (cap)
+            memcpy(data, vec->local, cap * sizeof(void *));
+    }
+    if (capacity)
+        *capacity = cap;
+    if (!vec->fixed)
+        // Free the vector without its array or elements
+        free(vec);
+    return data;
+}
+
+/**
+ * Set the destructor of the vector's elements.
+ *
+ * @param vec        Pointer to the vector.
+ * @param data_free  Destructor for elements, or `NULL` to not free elements.
+ */
+void vector_set_free(struct vector *vec, void (*data_free)(void *data)) {
+    if (!vec)
+        // Return early if the vector is `NULL`
+        return;
+    // Store the destructor
+    vec->data_free = data_free;
+}
+
 /**
  * Delete the vector.
  *
@@ -53,10 +201,31 @@ void vector_drop(struct vector *vec) {
     if (!vec)
         // Return early if the vector is `NULL`
         return;
-    // Free the array of elements
-    free(vec->data);
-    // Free the vector
-    free(vec);
+    // Free the elements
+    vector_clear(vec);
+    // Free the array of elements if it was spilled to the heap
+    if (vec->data != vec->local)
+        free(vec->data);
+    // Free the vector, unless it lives in caller-provided memory
+    if (!vec->fixed)
+        free(vec);
+}
+
+/**
+ * Remove every element from the vector, keeping its capacity.
+ *
+ * @param vec Pointer to the vector.
+ */
+void vector_clear(struct vector *vec) {
+    if (!vec)
+        // Return early if the vector is `NULL`
+        return;
+    if (vec->data_free)
+        // Pass each element to the destructor
+        for (usize i = 0; i < vec->len; i++)
+            vec->data_free(vec->data[i]);
+    // Set the length of the vector to zero
+    vec->len = 0;
 }
 
 /**
@@ -96,19 +265,11 @@ bool vector_append(struct vector *vec, void *data) {
  * @return       `true` if the operation was successful, `false` otherwise.
  */
 bool vector_extend(struct vector *vec, const struct vector *other) {
-    if (!vec || !vec->data || !other || !other->data)
-        // Return `false` if either vector or data array is `NULL`
+    if (!vec || !other)
+        // Return `false` if either vector is `NULL`
         return false;
-    // Increase the capacity of this vector if necessary
-    if (vec->len + other->len > vec->capacity)
-        vector_reserve(vec, vec->len + other->len);
-    // Append the elements from the other vector
-    for (usize i = 0; i < other->len; i++)
-        vec->data[vec->len + i] = other->data[i];
-    // Increase the size of this vector by the size of the other vector
-    vec->len += other->len;
-    // Return `true` to indicate success
-    return true;
+    // Append every element of the other vector
+    return vector_extend_slice(vec, vector_as_slice(other));
 }
 
 /**
@@ -130,9 +291,8 @@ void *vector_pop(struct vector *vec) {
     void *removed = vec->data[vec->len - 1];
     // Reduce the size of the vector by one
     vec->len--;
-    // Resize the vector if necessary
-    if (vec->len < vec->capacity / 2 && vec->capacity > 1)
-        vector_resize(vec, vec->capacity / 2);
+    // Shrink the vector if necessary
+    vector_shrink(vec);
     // Return the removed element
     return removed;
 }
@@ -189,9 +349,8 @@ bool vector_insert(struct vector *vec, usize index, void *data) {
  *               was invalid.
  */
 void *vector_remove(struct vector *vec, usize index) {
-    if (!vec || !vec->data || vec->len == 0)
-        // Return `NULL` if the vector or data array is `NULL` or the vector is
-        // empty
+    if (!vec || index >= vec->len)
+        // Return `NULL` if the vector is `NULL` or the index is out of bounds
         return NULL;
     // Save a pointer to the removed element
     void *removed = vec->data[index];
@@ -200,13 +359,72 @@ void *vector_remove(struct vector *vec, usize index) {
         vec->data[i] = vec->data[i + 1];
     // Reduce the size of the vector by one
     vec->len--;
-    // Resize the vector if necessary
-    if (vec->len < vec->capacity / 2 && vec->capacity > 1)
-        vector_resize(vec, vec->capacity / 2);
+    // Shrink the vector if necessary
+    vector_shrink(vec);
+    // Return the removed element
+    return removed;
+}
+
+/**
+ * Remove an element from the vector by moving the last element into its
+ * place.
+ *
+ * @param vec    Pointer to the vector.
+ * @param index  Index of the element to remove.
+ * @return       Pointer to the removed element, or `NULL` if the operation
+ *               was invalid.
+ */
+void *vector_swap_remove(struct vector *vec, usize index) {
+    if (!vec || index >= vec->len)
+        // Return `NULL` if the vector is `NULL` or the index is out of bounds
+        return NULL;
+    // Save a pointer to the removed element
+    void *removed = vec->data[index];
+    // Move the last element into the gap left by the removed element
+    vec->data[index] = vec->data[--vec->len];
+    // Shrink the vector if necessary
+    vector_shrink(vec);
     // Return the removed element
     return removed;
 }
 
+/**
+ * Keep only the elements of the vector which satisfy a predicate.
+ *
+ * @param vec      Pointer to the vector.
+ * @param pred     Predicate which returns `true` for elements to keep.
+ * @param context  User-defined context to pass to the predicate.
+ * @return         `true` if the operation was successful, `false` otherwise.
+ */
+bool vector_retain(
+    struct vector *vec, bool (*pred)(void *data, void *context), void *context
+) {
+    if (!vec || !pred)
+        // Return `false` if the vector or predicate is `NULL`
+        return false;
+    usize n = 0;
+    if (vec->data_free) {
+        // Compact the kept elements, destroying the others
+        for (usize i = 0; i < vec->len; i++) {
+            void *data = vec->data[i];
+            if (pred(data, context))
+                vec->data[n++] = data;
+            else
+                vec->data_free(data);
+        }
+    } else {
+        // Compact the kept elements without branching on the predicate
+        for (usize i = 0; i < vec->len; i++) {
+            void *data = vec->data[i];
+            vec->data[n] = data;
+            n += pred(data, context);
+        }
+    }
+    // Truncate the vector to the kept elements
+    vec->len = n;
+    return true;
+}
+
 /**
  * Check if the vector contains a given element.
  *
@@ -264,6 +482,9 @@ bool vector_set(struct vector *vec, usize index, void *data) {
     if (index >= vec->len)
         // Return `false` if the index is out of bounds
         return false;
+    // Destroy the element being replaced, unless it is being set again
+    if (vec->data_free && vec->data[index] != data)
+        vec->data_free(vec->data[index]);
     // Set the element
     vec->data[index] = data;
     // Return `true` to indicate success
@@ -348,14 +569,35 @@ bool vector_reserve(struct vector *vec, usize capacity) {
     if (capacity < vec->len)
         // Return `false` if the new capacity is smaller than the current size
         return false;
+    if (capacity < vec->ninline)
+        // Never reserve less than the inline storage
+        capacity = vec->ninline;
+    if (vec->fixed && capacity > vec->ninline)
+        // Return `false` rather than allocate for a fixed-capacity vector
+        return false;
     if (capacity == vec->capacity)
         // Return `true` if the new capacity is the same as the current capacity
         return true;
-    // Resize the array of elements
-    void *data = realloc(vec->data, capacity * sizeof(void *));
-    if (!data)
-        // Return `false` if memory allocation failed
-        return false;
+    void **data;
+    if (vec->ninline && capacity == vec->ninline) {
+        // Move the elements back into the inline storage
+        data = vec->local;
+        memcpy(data, vec->data, vec->len * sizeof(void *));
+        free(vec->data);
+    } else if (vec->data == vec->local) {
+        // Spill the elements from the inline storage to the heap
+        data = malloc(capacity * sizeof(void *));
+        if (!data)
+            // Return `false` if memory allocation failed
+            return false;
+        memcpy(data, vec->local, vec->len * sizeof(void *));
+    } else {
+        // Resize the array of elements
+        data = realloc(vec->data, capacity * sizeof(void *));
+        if (!data)
+            // Return `false` if memory allocation failed
+            return false;
+    }
     // Update the vector with the new capacity and array of elements
     vec->capacity = capacity;
     vec->data = data;
@@ -374,15 +616,16 @@ bool vector_shrink_to_fit(struct vector *vec) {
     if (!vec || vec->len == 0)
         // Return `false` if the vector is `NULL` or empty
         return false;
-    // Resize the vector to its current size
-    return vector_resize(vec, vec->len);
+    // Reserve exactly enough capacity for the current size
+    return vector_reserve(vec, vec->len);
 }
 
 /**
  * Resize the vector to a given length.
  *
  * If the length is less than the current length, the vector will be truncated
- * to the new length. If the length is greater than the current length, the
+ * to the new length, and the dropped elements are passed to the vector's
+ * destructor, if any. If the length is greater than the current length, the
  * vector's capacity will be increased to the new length, and uninitialized
  * elements will be zeroed out.
  *
@@ -401,8 +644,131 @@ bool vector_resize(struct vector *vec, usize len) {
     // Zero out uninitialized elements if the size is being increased
     if (len > vec->len)
         memset(&vec->data[vec->len], 0, (len - vec->len) * sizeof(void *));
+    // Destroy the dropped elements if the size is being decreased
+    if (vec->data_free)
+        for (usize i = len; i < vec->len; i++)
+            vec->data_free(vec->data[i]);
     // Set the new length of the vector
     vec->len = len;
     // Return `true` to indicate success
     return true;
 }
+
+/**
+ * Get a slice of a range of elements of the vector.
+ *
+ * @param vec    Pointer to the vector.
+ * @param start  Index of the first element of the slice.
+ * @param end    Index one past the last element of the slice.
+ * @return       Slice of the elements from `start` up to `end`, or an empty
+ *               slice if the vector is `NULL` or the range is invalid.
+ */
+struct slice vector_slice(const struct vector *vec, usize start, usize end) {
+    if (!vec || start >= end || end > vec->len)
+        // Return an empty slice if the vector is `NULL` or the range is
+        // empty or out of bounds
+        return (struct slice){0};
+    // Return a view of the elements in the range
+    return (struct slice){
+        .data = vec->data + start,
+        .len = end - start,
+    };
+}
+
+/**
+ * Get a slice of every element of the vector.
+ *
+ * @param vec  Pointer to the vector.
+ * @return     Slice of every element, or an empty slice if the vector is
+ *             `NULL`.
+ */
+struct slice vector_as_slice(const struct vector *vec) {
+    if (!vec)
+        // Return an empty slice if the vector is `NULL`
+        return (struct slice){0};
+    // Return a view of every element
+    return (struct slice){
+        .data = vec->data,
+        .len = vec->len,
+    };
+}
+
+/**
+ * Get a slice of a range of elements of another slice.
+ *
+ * @param slice  Slice to take the range from.
+ * @param start  Index of the first element of the slice.
+ * @param end    Index one past the last element of the slice.
+ * @return       Slice of the elements from `start` up to `end`, or an empty
+ *               slice if the range is invalid.
+ */
+struct slice slice_sub(struct slice slice, usize start, usize end) {
+    if (start >= end || end > slice.len)
+        // Return an empty slice if the range is empty or out of bounds
+        return (struct slice){0};
+    // Return a view of the elements in the range
+    return (struct slice){
+        .data = slice.data + start,
+        .len = end - start,
+    };
+}
+
+/**
+ * Append the elements of a slice to the end of the vector.
+ *
+ * @param vec    Pointer to the vector.
+ * @param slice  Slice of the elements to append.
+ * @return       `true` if the operation was successful, `false` otherwise.
+ */
+bool vector_extend_slice(struct vector *vec, struct slice slice) {
+    if (!vec)
+        // Return `false` if the vector is `NULL`
+        return false;
+    if (!slice.len)
+        // Return early if there is nothing to append
+        return true;
+    // Find the offset of a slice of the vector's own elements, since they
+    // may move when its capacity is increased
+    uintptr_t offset = (uintptr_t)slice.data - (uintptr_t)vec->data;
+    bool own = vec->data && offset < vec->len * sizeof(void *);
+    // Increase the capacity of this vector if necessary
+    if (vec->len + slice.len > vec->capacity &&
+        !vector_reserve(vec, vec->len + slice.len))
+        // Return `false` if unable to reserve more capacity
+        return false;
+    if (own)
+        slice.data = (void **)((uintptr_t)vec->data + offset);
+    // Append the elements of the slice
+    memcpy(&vec->data[vec->len], slice.data, slice.len * sizeof(void *));
+    vec->len += slice.len;
+    // Return `true` to indicate success
+    return true;
+}
+
+// Comparison function of the innermost sort running on this thread
+static _Thread_local i32 (*slice_cmp_func)(const void *left, const void *right);
+
+// Compare two elements through the comparison function of the current sort
+static int slice_cmp(const void *left, const void *right) {
+    return slice_cmp_func(*(void *const *)left, *(void *const *)right);
+}
+
+/**
+ * Sort the elements of a slice in place.
+ *
+ * @param slice  Slice of the elements to sort.
+ * @param cmp    Comparison function for elements.
+ */
+void slice_sort(
+    struct slice slice, i32 (*cmp)(const void *left, const void *right)
+) {
+    if (slice.len < 2 || !cmp)
+        // Return early if there is nothing to sort
+        return;
+    // Sort the elements, restoring the comparison function of any sort whose
+    // comparison function started this one
+    i32 (*outer)(const void *left, const void *right) = slice_cmp_func;
+    slice_cmp_func = cmp;
+    qsort(slice.data, slice.len, sizeof(void *), slice_cmp);
+    slice_cmp_func = outer;
+}
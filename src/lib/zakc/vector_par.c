@@ -0,0 +1,459 @@
+// File:        vector_par.c
+// Author:      Zakhary Kaplan <https://zakhary.dev>
+// Created:     17 Oct 2026
+// SPDX-License-Identifier: MIT
+
+#include "zakc/vector.h"
+
+#include <stdint.h> // for uintptr_t
+#include <stdlib.h> // for free, malloc
+#include <string.h> // for memcpy
+
+#include "zakc/pool.h"  // for pool, pool_{nthreads,parallel_for}
+#include "zakc/types.h" // for u8, usize
+
+// Minimum number of elements in each chunk of a parallel algorithm
+#define PAR_MIN_CHUNK 4096
+// Number of chunks per worker thread of a parallel algorithm
+#define PAR_CHUNKS 4
+
+// Parallel algorithm state
+struct par {
+    // Array of input elements
+    void **src;
+    // Array of output elements
+    void **dst;
+    // Number of input elements
+    usize len;
+    // Number of elements in each chunk
+    usize size;
+    // Function to apply to the elements
+    union {
+        void *(*func)(void *data, void *context);
+        bool (*pred)(void *data, void *context);
+        void *(*op)(void *lhs, void *rhs, void *context);
+    };
+    // User-defined context to pass to the function
+    void *context;
+    // Per-chunk partial results
+    void **partial;
+    // Per-chunk number of kept elements
+    usize *counts;
+    // Per-element predicate results
+    u8 *keep;
+    // Whether to compute an inclusive scan
+    bool inclusive;
+};
+
+// Split a slice into chunks, returning the number of chunks
+static usize par_split(struct pool *pool, usize len, usize *size) {
+    // Use several chunks per worker, without making them too small
+    usize nchunks = PAR_CHUNKS * pool_nthreads(pool);
+    usize most = (len + PAR_MIN_CHUNK - 1) / PAR_MIN_CHUNK;
+    if (nchunks > most)
+        nchunks = most;
+    if (nchunks <= 1)
+        return 1;
+    *size = (len + nchunks - 1) / nchunks;
+    return (len + *size - 1) / *size;
+}
+
+// Get the bounds of a chunk
+static inline void par_bounds(
+    const struct par *par, usize chunk, usize *lo, usize *hi
+) {
+    *lo = chunk * par->size;
+    *hi = *lo + par->size < par->len ? *lo + par->size : par->len;
+}
+
+// Map each element of a range of chunks
+static void par_map(usize start, usize end, void *context) {
+    struct par *par = context;
+    for (usize c = start; c < end; c++) {
+        usize lo, hi;
+        par_bounds(par, c, &lo, &hi);
+        for (usize i = lo; i < hi; i++)
+            par->dst[i] = par->func(par->src[i], par->context);
+    }
+}
+
+// Test and count each element of a range of chunks
+static void par_test(usize start, usize end, void *context) {
+    struct par *par = context;
+    for (usize c = start; c < end; c++) {
+        usize lo, hi;
+        par_bounds(par, c, &lo, &hi);
+        usize count = 0;
+        for (usize i = lo; i < hi; i++) {
+            u8 keep = par->pred(par->src[i], par->context);
+            par->keep[i] = keep;
+            count += keep;
+        }
+        par->counts[c] = count;
+    }
+}
+
+// Scatter the kept elements of a range of chunks to their offsets
+static void par_scatter(usize start, usize end, void *context) {
+    struct par *par = context;
+    for (usize c = start; c < end; c++) {
+        usize lo, hi;
+        par_bounds(par, c, &lo, &hi);
+        usize n = par->counts[c];
+        for (usize i = lo; i < hi; i++)
+            if (par->keep[i])
+                par->dst[n++] = par->src[i];
+    }
+}
+
+// Reduce each of a range of chunks
+static void par_reduce(usize start, usize end, void *context) {
+    struct par *par = context;
+    for (usize c = start; c < end; c++) {
+        usize lo, hi;
+        par_bounds(par, c, &lo, &hi);
+        void *acc = par->src[lo];
+        for (usize i = lo + 1; i < hi; i++)
+            acc = par->op(acc, par->src[i], par->context);
+        par->partial[c] = acc;
+    }
+}
+
+// Scan each of a range of chunks, starting from its carried-in value
+static void par_scan(usize start, usize end, void *context) {
+    struct par *par = context;
+    for (usize c = start; c < end; c++) {
+        usize lo, hi;
+        par_bounds(par, c, &lo, &hi);
+        void *acc = par->partial[c];
+        if (par->inclusive) {
+            for (usize i = lo; i < hi; i++)
+                par->dst[i] = acc = par->op(acc, par->src[i], par->context);
+        } else {
+            for (usize i = lo; i < hi; i++) {
+                void *data = par->src[i];
+                par->dst[i] = acc;
+                acc = par->op(acc, data, par->context);
+            }
+        }
+    }
+}
+
+/**
+ * Map each element of a slice through a function in parallel.
+ *
+ * @param pool     Pointer to the thread pool, or `NULL` to run sequentially.
+ * @param dst      Slice to store the results in, at least as long as `src`.
+ * @param src      Slice of the elements to map.
+ * @param func     Function to apply to each element.
+ * @param context  User-defined context to pass to the function.
+ * @return         `true` if the operation was successful, `false` otherwise.
+ */
+bool slice_par_map(
+    struct pool *pool,
+    struct slice dst,
+    struct slice src,
+    void *(*func)(void *data, void *context),
+    void *context
+) {
+    if (!func || dst.len < src.len)
+        // Return `false` if the function is `NULL` or the destination is too
+        // short
+        return false;
+    struct par par = {.len = src.len, .func = func, .context = context};
+    usize nchunks = par_split(pool, src.len, &par.size);
+    if (nchunks == 1)
+        // Run sequentially if the slice is too small to split
+        return slice_map(dst, src, func, context);
+    par.src = src.data;
+    par.dst = dst.data;
+    pool_parallel_for(pool, 0, nchunks, 1, par_map, &par);
+    return true;
+}
+
+/**
+ * Map each element of a vector through a function in parallel.
+ *
+ * @param pool     Pointer to the thread pool, or `NULL` to run sequentially.
+ * @param dst      Pointer to the vector to store the results in.
+ * @param src      Pointer to the vector to map.
+ * @param func     Function to apply to each element.
+ * @param context  User-defined context to pass to the function.
+ * @return         `true` if the operation was successful, `false` otherwise.
+ */
+bool vector_par_map(
+    struct pool *pool,
+    struct vector *dst,
+    const struct vector *src,
+    void *(*func)(void *data, void *context),
+    void *context
+) {
+    if (!dst || !src || !func)
+        // Return `false` if either vector or the function is `NULL`
+        return false;
+    if (dst != src && !vector_resize(dst, vector_len(src)))
+        // Return `false` if unable to resize the destination vector
+        return false;
+    return slice_par_map(
+        pool, vector_as_slice(dst), vector_as_slice(src), func, context
+    );
+}
+
+/**
+ * Keep only the elements of a slice which satisfy a predicate in parallel.
+ *
+ * @param pool     Pointer to the thread pool, or `NULL` to run sequentially.
+ * @param dst      Slice to store the results in, at least as long as `src`.
+ * @param src      Slice of the elements to filter.
+ * @param pred     Predicate which returns `true` for elements to keep.
+ * @param context  User-defined context to pass to the predicate.
+ * @param len      Where to store the number of kept elements.
+ * @return         `true` if the operation was successful, `false` otherwise.
+ */
+bool slice_par_filter(
+    struct pool *pool,
+    struct slice dst,
+    struct slice src,
+    bool (*pred)(void *data, void *context),
+    void *context,
+    usize *len
+) {
+    if (!pred || !len || dst.len < src.len)
+        // Return `false` if the predicate or length is `NULL`, or the
+        // destination is too short
+        return false;
+    struct par par = {.len = src.len, .pred = pred, .context = context};
+    usize nchunks = par_split(pool, src.len, &par.size);
+    if (nchunks == 1) {
+        // Run sequentially if the slice is too small to split
+        *len = slice_filter(dst, src, pred, context);
+        return true;
+    }
+    // Test every element, counting the kept elements in each chunk
+    par.src = src.data;
+    par.keep = malloc(src.len);
+    par.counts = malloc(nchunks * sizeof(usize));
+    if (!par.keep || !par.counts)
+        goto fail;
+    pool_parallel_for(pool, 0, nchunks, 1, par_test, &par);
+    // Turn the counts into the offset of each chunk in the output
+    usize total = 0;
+    for (usize c = 0; c < nchunks; c++) {
+        usize count = par.counts[c];
+        par.counts[c] = total;
+        total += count;
+    }
+    // Scatter the kept elements, via a temporary array when the destination
+    // overlaps the source, since chunks may otherwise overwrite elements not
+    // yet read
+    uintptr_t dlo = (uintptr_t)dst.data;
+    uintptr_t slo = (uintptr_t)src.data;
+    bool overlap = dlo < slo + src.len * sizeof(void *) &&
+                   slo < dlo + dst.len * sizeof(void *);
+    par.dst = overlap ? malloc(total * sizeof(void *)) : dst.data;
+    if (overlap && total && !par.dst)
+        goto fail;
+    pool_parallel_for(pool, 0, nchunks, 1, par_scatter, &par);
+    if (overlap) {
+        if (total)
+            memcpy(dst.data, par.dst, total * sizeof(void *));
+        free(par.dst);
+    }
+    free(par.keep);
+    free(par.counts);
+    *len = total;
+    return true;
+
+fail:
+    // Clean up if memory allocation failed
+    free(par.keep);
+    free(par.counts);
+    return false;
+}
+
+/**
+ * Keep only the elements of a vector which satisfy a predicate in parallel.
+ *
+ * @param pool     Pointer to the thread pool, or `NULL` to run sequentially.
+ * @param dst      Pointer to the vector to store the results in.
+ * @param src      Pointer to the vector to filter.
+ * @param pred     Predicate which returns `true` for elements to keep.
+ * @param context  User-defined context to pass to the predicate.
+ * @return         `true` if the operation was successful, `false` otherwise.
+ */
+bool vector_par_filter(
+    struct pool *pool,
+    struct vector *dst,
+    const struct vector *src,
+    bool (*pred)(void *data, void *context),
+    void *context
+) {
+    if (!dst || !src || !pred)
+        // Return `false` if either vector or the predicate is `NULL`
+        return false;
+    if (dst != src && !vector_resize(dst, vector_len(src)))
+        // Return `false` if unable to resize the destination vector
+        return false;
+    usize len;
+    struct slice out = vector_as_slice(dst);
+    struct slice in = vector_as_slice(src);
+    if (!slice_par_filter(pool, out, in, pred, context, &len))
+        // Return `false` if memory allocation failed
+        return false;
+    return vector_resize(dst, len);
+}
+
+/**
+ * Reduce the elements of a slice to a single value in parallel.
+ *
+ * @param pool     Pointer to the thread pool, or `NULL` to run sequentially.
+ * @param slice    Slice of the elements to reduce.
+ * @param init     Initial value of the reduction.
+ * @param op       Binary operator to combine two values.
+ * @param context  User-defined context to pass to the operator.
+ * @return         The reduced value, or the initial value if the slice is
+ *                 empty.
+ */
+void *slice_par_reduce(
+    struct pool *pool,
+    struct slice slice,
+    void *init,
+    void *(*op)(void *lhs, void *rhs, void *context),
+    void *context
+) {
+    if (!op)
+        // Return the initial value if the operator is `NULL`
+        return init;
+    struct par par = {.len = slice.len, .op = op, .context = context};
+    usize nchunks = par_split(pool, slice.len, &par.size);
+    par.partial = nchunks > 1 ? malloc(nchunks * sizeof(void *)) : NULL;
+    if (!par.partial)
+        // Run sequentially if the slice is too small to split, or if memory
+        // allocation failed
+        return slice_reduce(slice, init, op, context);
+    // Reduce each chunk, then combine the chunks in order
+    par.src = slice.data;
+    pool_parallel_for(pool, 0, nchunks, 1, par_reduce, &par);
+    void *acc = init;
+    for (usize c = 0; c < nchunks; c++)
+        acc = op(acc, par.partial[c], context);
+    free(par.partial);
+    return acc;
+}
+
+/**
+ * Reduce the elements of a vector to a single value in parallel.
+ *
+ * @param pool     Pointer to the thread pool, or `NULL` to run sequentially.
+ * @param vec      Pointer to the vector to reduce.
+ * @param init     Initial value of the reduction.
+ * @param op       Binary operator to combine two values.
+ * @param context  User-defined context to pass to the operator.
+ * @return         The reduced value, or the initial value if the vector is
+ *                 empty or `NULL`.
+ */
+void *vector_par_reduce(
+    struct pool *pool,
+    const struct vector *vec,
+    void *init,
+    void *(*op)(void *lhs, void *rhs, void *context),
+    void *context
+) {
+    if (!vec || !op)
+        // Return the initial value if the vector or operator is `NULL`
+        return init;
+    return slice_par_reduce(pool, vector_as_slice(vec), init, op, context);
+}
+
+/**
+ * Compute the prefix scan of a slice in parallel.
+ *
+ * @param pool       Pointer to the thread pool, or `NULL` to run sequentially.
+ * @param dst        Slice to store the results in, at least as long as `src`.
+ * @param src        Slice of the elements to scan.
+ * @param init       Initial value of the scan.
+ * @param op         Binary operator to combine two values.
+ * @param inclusive  Whether to compute an inclusive or exclusive scan.
+ * @param context    User-defined context to pass to the operator.
+ * @return           `true` if the operation was successful, `false` otherwise.
+ */
+bool slice_par_scan(
+    struct pool *pool,
+    struct slice dst,
+    struct slice src,
+    void *init,
+    void *(*op)(void *lhs, void *rhs, void *context),
+    bool inclusive,
+    void *context
+) {
+    if (!op || dst.len < src.len)
+        // Return `false` if the operator is `NULL` or the destination is too
+        // short
+        return false;
+    struct par par = {
+        .len = src.len,
+        .op = op,
+        .context = context,
+        .inclusive = inclusive,
+    };
+    usize nchunks = par_split(pool, src.len, &par.size);
+    if (nchunks == 1)
+        // Run sequentially if the slice is too small to split
+        return slice_scan(dst, src, init, op, inclusive, context);
+    par.partial = malloc(nchunks * sizeof(void *));
+    if (!par.partial)
+        // Return `false` if memory allocation failed
+        return false;
+    // Reduce each chunk, then scan the chunks to find each one's carry-in
+    par.src = src.data;
+    par.dst = dst.data;
+    pool_parallel_for(pool, 0, nchunks, 1, par_reduce, &par);
+    void *acc = init;
+    for (usize c = 0; c < nchunks; c++) {
+        void *sum = par.partial[c];
+        par.partial[c] = acc;
+        acc = op(acc, sum, context);
+    }
+    // Scan each chunk from its carry-in
+    pool_parallel_for(pool, 0, nchunks, 1, par_scan, &par);
+    free(par.partial);
+    return true;
+}
+
+/**
+ * Compute the prefix scan of a vector in parallel.
+ *
+ * @param pool       Pointer to the thread pool, or `NULL` to run sequentially.
+ * @param dst        Pointer to the vector to store the results in.
+ * @param src        Pointer to the vector to scan.
+ * @param init       Initial value of the scan.
+ * @param op         Binary operator to combine two values.
+ * @param inclusive  Whether to compute an inclusive or exclusive scan.
+ * @param context    User-defined context to pass to the operator.
+ * @return           `true` if the operation was successful, `false` otherwise.
+ */
+bool vector_par_scan(
+    struct pool *pool,
+    struct vector *dst,
+    const struct vector *src,
+    void *init,
+    void *(*op)(void *lhs, void *rhs, void *context),
+    bool inclusive,
+    void *context
+) {
+    if (!dst || !src || !op)
+        // Return `false` if either vector or the operator is `NULL`
+        return false;
+    if (dst != src && !vector_resize(dst, vector_len(src)))
+        // Return `false` if unable to resize the destination vector
+        return false;
+    return slice_par_scan(
+        pool,
+        vector_as_slice(dst),
+        vector_as_slice(src),
+        init,
+        op,
+        inclusive,
+        context
+    );
+}
@@ -0,0 +1,39 @@
+#include <stdlib.h> // for EXIT_FAILURE, EXIT_SUCCESS
+#include <string.h> // for strlen
+
+#include <zakc/art.h>   // for art
+#include <zakc/log.h>   // for info
+#include <zakc/types.h> // for usize
+
+// Print a path and its size
+static void show(const void *key, usize len, void *data, void *context) {
+    info("%.*s: %zu bytes", (int)len, (const char *)key, (usize)data);
+}
+
+int main(void) {
+    // Create a new adaptive radix tree
+    struct art *tree = art_new();
+    if (!tree) {
+        // Handle error
+        return EXIT_FAILURE;
+    }
+
+    // Insert some paths with their sizes
+    const char *paths[] = {"/usr/bin/cc", "/usr/lib/libc.so", "/usr/bin/ls"};
+    usize sizes[] = {1024, 2048, 512};
+    for (usize i = 0; i < 3; i++) {
+        art_insert(tree, paths[i], strlen(paths[i]), (void *)sizes[i]);
+    }
+
+    // Print every path under "/usr/bin/" in order
+    art_prefix(tree, "/usr/bin/", strlen("/usr/bin/"), show, NULL);
+
+    // Look up a single path
+    usize size = (usize)art_get(tree, "/usr/lib/libc.so", 16);
+    info("/usr/lib/libc.so is %zu bytes.", size);
+
+    // Clean up
+    art_drop(tree);
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,44 @@
+#include <pthread.h> // for pthread_{create,join}
+#include <stdlib.h>  // for EXIT_FAILURE, EXIT_SUCCESS
+
+#include <zakc/cvec.h>  // for cvec
+#include <zakc/log.h>   // for info
+#include <zakc/types.h> // for i64, usize
+
+// Append some numbers to the shared vector
+static void *produce(void *vec) {
+    for (i64 i = 1; i <= 1000; i++) {
+        cvec_append(vec, (void *)i, NULL);
+    }
+    return NULL;
+}
+
+int main(void) {
+    // Create a new concurrent vector
+    struct cvec *vec = cvec_new();
+    if (!vec) {
+        // Handle error
+        return EXIT_FAILURE;
+    }
+
+    // Append to the vector from several threads at once
+    pthread_t threads[4];
+    for (usize i = 0; i < 4; i++) {
+        pthread_create(&threads[i], NULL, produce, vec);
+    }
+    for (usize i = 0; i < 4; i++) {
+        pthread_join(threads[i], NULL);
+    }
+
+    // Sum the numbers in the vector
+    i64 sum = 0;
+    for (usize i = 0; i < cvec_len(vec); i++) {
+        sum += (i64)cvec_get(vec, i);
+    }
+    info("The vector contains %zu values summing to %lld.", cvec_len(vec), sum);
+
+    // Clean up
+    cvec_drop(vec);
+
+    return EXIT_SUCCESS;
+}
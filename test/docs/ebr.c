@@ -0,0 +1,46 @@
+#include <stdatomic.h> // for atomic_*
+#include <stdlib.h>    // for EXIT_FAILURE, EXIT_SUCCESS, free, malloc
+
+#include <zakc/ebr.h>   // for ebr
+#include <zakc/log.h>   // for info
+#include <zakc/types.h> // for i32
+
+// Configuration shared between threads
+struct config {
+    i32 verbosity;
+};
+
+// Current configuration, replaced as a whole when updated
+static _Atomic(struct config *) current;
+
+int main(void) {
+    // Create a new reclamation domain
+    struct ebr *ebr = ebr_new(EbrEpoch);
+    struct config *config = malloc(sizeof(struct config));
+    if (!ebr || !config) {
+        // Handle error
+        return EXIT_FAILURE;
+    }
+    config->verbosity = 1;
+    atomic_store(&current, config);
+
+    // Read the configuration within a critical section
+    ebr_enter(ebr);
+    info("Verbosity is %d.", atomic_load(&current)->verbosity);
+    ebr_exit(ebr);
+
+    // Replace the configuration, retiring the old one
+    struct config *next = malloc(sizeof(struct config));
+    if (!next) {
+        // Handle error
+        return EXIT_FAILURE;
+    }
+    next->verbosity = 2;
+    ebr_retire(ebr, atomic_exchange(&current, next), free);
+
+    // Clean up, freeing the retired configuration
+    ebr_drop(ebr);
+    free(atomic_load(&current));
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,41 @@
+#include <stdlib.h> // for EXIT_FAILURE, EXIT_SUCCESS
+
+#include <zakc/gvec.h>   // for gvec
+#include <zakc/log.h>    // for info
+#include <zakc/types.h>  // for usize
+#include <zakc/vector.h> // for slice
+
+int main(void) {
+    // Create a new gap vector holding some text
+    struct gvec *text = gvec_new();
+    if (!text) {
+        // Handle error
+        return EXIT_FAILURE;
+    }
+    for (const char *c = "Hello world!"; *c; c++) {
+        gvec_append(text, (void *)c);
+    }
+
+    // Type a word in the middle, one character at a time
+    const char *word = ", dear";
+    for (usize i = 0; word[i]; i++) {
+        gvec_insert(text, 5 + i, (void *)&word[i]);
+    }
+
+    // Delete the exclamation mark
+    gvec_remove(text, gvec_len(text) - 1);
+
+    // View the text as a contiguous slice and print it
+    struct slice slice = gvec_as_slice(text);
+    char buf[32];
+    for (usize i = 0; i < slice.len; i++) {
+        buf[i] = *(char *)slice.data[i];
+    }
+    buf[slice.len] = '\0';
+    info("%s", buf);
+
+    // Clean up
+    gvec_drop(text);
+
+    return EXIT_SUCCESS;
+}
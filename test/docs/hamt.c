@@ -0,0 +1,54 @@
+#include <stdlib.h> // for EXIT_FAILURE, EXIT_SUCCESS
+
+#include <zakc/hamt.h>    // for hamt
+#include <zakc/hashmap.h> // for str_cmp, str_hash
+#include <zakc/log.h>     // for info
+#include <zakc/types.h>   // for i64
+
+// Print each difference between two versions
+static void print_change(
+    enum hamt_change change,
+    const void *key,
+    void *prev,
+    void *next,
+    void *context
+) {
+    info(
+        "%s: '%s' (%lld -> %lld)",
+        change == HamtAdded     ? "added"
+        : change == HamtRemoved ? "removed"
+                                : "changed",
+        (const char *)key,
+        (i64)prev,
+        (i64)next
+    );
+}
+
+int main(void) {
+    // Build the first version in a batch using a transient
+    struct hamt *map = hamt_new(str_hash, str_cmp);
+    struct hamt *tmp = hamt_transient(map);
+    if (!map || !tmp) {
+        // Handle error
+        return EXIT_FAILURE;
+    }
+    hamt_transient_insert(tmp, "foo", (void *)(i64)1);
+    hamt_transient_insert(tmp, "bar", (void *)(i64)2);
+    hamt_transient_insert(tmp, "baz", (void *)(i64)3);
+    hamt_drop(map);
+    map = hamt_persistent(tmp);
+
+    // Create a new version, leaving the original untouched
+    struct hamt *next = hamt_insert(map, "bar", (void *)(i64)4);
+    struct hamt *last = hamt_remove(next, "baz");
+
+    // Print the differences between the first and last versions
+    hamt_diff(map, last, print_change, NULL);
+
+    // Clean up
+    hamt_drop(last);
+    hamt_drop(next);
+    hamt_drop(map);
+
+    return EXIT_SUCCESS;
+}
@@ -1,8 +1,44 @@
-#include <stdlib.h> // for EXIT_FAILURE, EXIT_SUCCESS
+#include <pthread.h>   // for pthread_{create,join}
+#include <sched.h>     // for sched_yield
+#include <stdatomic.h> // for atomic_*
+#include <stdlib.h>    // for EXIT_FAILURE, EXIT_SUCCESS, free
+#include <string.h>    // for strcmp, strdup
 
 #include <zakc/hashmap.h> // for hashmap
 #include <zakc/log.h>     // for info
-#include <zakc/types.h>   // for i64, usize
+#include <zakc/types.h>   // for i64, u64, usize
+
+// Keys of the concurrent map, which must outlive every reader as removed keys
+// may still be compared by lookups in flight
+static const char *const keys[] = {"a", "b", "c", "d", "e", "f", "g", "h"};
+
+// Whether the writer has finished
+static atomic_bool done;
+
+// Hash every key alike, so that all of them share the same two buckets
+static u64 same_hash(const void *key) {
+    (void)key;
+    return 0;
+}
+
+// Compare two keys, yielding first to let the writer run mid-lookup
+static bool yield_cmp(const void *left, const void *right) {
+    sched_yield();
+    return !strcmp(left, right);
+}
+
+// Look up every key of the shared map until the writer finishes, counting
+// lookups which found the wrong data
+static void *lookup(void *map) {
+    usize wrong = 0;
+    while (!atomic_load(&done)) {
+        for (usize i = 0; i < 8; i++) {
+            i64 data = (i64)hashmap_get(map, keys[i]);
+            wrong += data && data != (i64)i + 1;
+        }
+    }
+    return (void *)wrong;
+}
 
 int main(void) {
     // Create a new hash map
@@ -31,5 +67,68 @@ int main(void) {
     // Clean up
     hashmap_drop(map);
 
+    // Create two hash maps which own their keys
+    struct hashmap *dst = hashmap_new(str_hash, str_cmp);
+    struct hashmap *src = hashmap_new(str_hash, str_cmp);
+    if (!dst || !src) {
+        // Handle error
+        return EXIT_FAILURE;
+    }
+    hashmap_set_free(dst, free, NULL);
+    hashmap_set_free(src, free, NULL);
+    hashmap_insert(dst, strdup("foo"), (void *)(i64)1);
+    hashmap_insert(src, strdup("foo"), (void *)(i64)2);
+    hashmap_insert(src, strdup("qux"), (void *)(i64)3);
+
+    // Move the items of one map into the other, which takes ownership of
+    // their keys and frees those it already has
+    if (!hashmap_merge(dst, src, HashmapReplace)) {
+        // Handle error
+        return EXIT_FAILURE;
+    }
+    info(
+        "The merged map has %zu keys, leaving %zu in the source.",
+        hashmap_len(dst),
+        hashmap_len(src)
+    );
+
+    // Clean up both maps, each of which frees only its own keys
+    hashmap_drop(src);
+    hashmap_drop(dst);
+
+    // Create a cuckoo hash map which allows lookups while it is written
+    struct hashmap *shared = hashmap_new_cuckoo(same_hash, yield_cmp, true);
+    if (!shared) {
+        // Handle error
+        return EXIT_FAILURE;
+    }
+
+    // Look up keys from several threads while one thread removes and
+    // reinserts them
+    pthread_t threads[3];
+    for (usize i = 0; i < 3; i++) {
+        pthread_create(&threads[i], NULL, lookup, shared);
+    }
+    for (usize n = 0; n < 20000; n++) {
+        usize i = n % 8;
+        hashmap_remove(shared, keys[i]);
+        hashmap_insert(shared, keys[i], (void *)((i64)i + 1));
+    }
+    atomic_store(&done, true);
+    usize wrong = 0;
+    for (usize i = 0; i < 3; i++) {
+        void *count;
+        pthread_join(threads[i], &count);
+        wrong += (usize)count;
+    }
+    info("The readers found %zu wrong values.", wrong);
+
+    // Clean up
+    hashmap_drop(shared);
+    if (wrong) {
+        // Handle error
+        return EXIT_FAILURE;
+    }
+
     return EXIT_SUCCESS;
 }
@@ -0,0 +1,66 @@
+#include <stdint.h> // for uintptr_t
+#include <stdlib.h> // for EXIT_FAILURE, EXIT_SUCCESS, free
+#include <string.h> // for strdup
+
+#include <zakc/hashmap.h> // for str_{cmp,hash}
+#include <zakc/hashset.h> // for hashset
+#include <zakc/log.h>     // for info
+#include <zakc/types.h>   // for usize
+
+int main(void) {
+    // Create two sets of user IDs
+    struct hashset *online = hashset_new_u64();
+    struct hashset *admins = hashset_new_u64();
+    if (!online || !admins) {
+        // Handle error
+        return EXIT_FAILURE;
+    }
+
+    // Insert some IDs into each set
+    for (uintptr_t id = 1; id <= 10; id++) {
+        hashset_insert(online, (void *)id);
+    }
+    hashset_insert(admins, (void *)(uintptr_t)3);
+    hashset_insert(admins, (void *)(uintptr_t)42);
+
+    // Find the admins who are online
+    struct hashset *both = hashset_intersection(online, admins);
+    if (!both) {
+        // Handle error
+        return EXIT_FAILURE;
+    }
+    info("%zu admin(s) are online.", hashset_len(both));
+
+    // Check if every admin is online
+    if (!hashset_is_subset(admins, online)) {
+        info("Some admins are offline.");
+    }
+
+    // Clean up
+    hashset_drop(both);
+    hashset_drop(admins);
+    hashset_drop(online);
+
+    // Create a set which owns its keys, to deduplicate batches of names
+    struct hashset *names = hashset_new(str_hash, str_cmp);
+    if (!names) {
+        // Handle error
+        return EXIT_FAILURE;
+    }
+    hashset_set_free(names, free);
+    const char *batches[][3] = {{"ann", "bob", "ann"}, {"cat", "cat", "cat"}};
+    for (usize b = 0; b < 2; b++) {
+        // Insert a copy of each name, freeing the copies of duplicates
+        for (usize i = 0; i < 3; i++) {
+            hashset_insert(names, strdup(batches[b][i]));
+        }
+        info("Batch %zu has %zu distinct name(s).", b, hashset_len(names));
+        // Free the names, keeping the set's capacity for the next batch
+        hashset_clear(names);
+    }
+
+    // Clean up
+    hashset_drop(names);
+
+    return EXIT_SUCCESS;
+}
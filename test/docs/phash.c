@@ -0,0 +1,69 @@
+#include <stdint.h> // for uintptr_t
+#include <stdlib.h> // for EXIT_FAILURE, EXIT_SUCCESS
+
+#include <zakc/log.h>   // for info
+#include <zakc/phash.h> // for phash
+#include <zakc/types.h> // for u32, usize
+
+// Generated by `phash -n colors -p Color` from:
+//
+//     red     0xff0000
+//     green   0x00ff00
+//     blue    0x0000ff
+//     yellow  0xffff00
+//     cyan    0x00ffff
+//     magenta 0xff00ff
+enum colors_key {
+    ColorRed,
+    ColorGreen,
+    ColorBlue,
+    ColorYellow,
+    ColorCyan,
+    ColorMagenta,
+};
+static const u32 colors_seeds[] = {8, 2, 3};
+static const char *const colors_keys[] = {
+    "magenta", "green", "blue", "yellow", "cyan", "red",
+};
+static const usize colors_ranks[] = {5, 1, 2, 3, 4, 0};
+static void *const colors_values[] = {
+    (void *)(0xff00ff), (void *)(0x00ff00), (void *)(0x0000ff),
+    (void *)(0xffff00), (void *)(0x00ffff), (void *)(0xff0000),
+};
+static const struct phash colors = {
+    .len = 6,
+    .nbuckets = 3,
+    .seeds = colors_seeds,
+    .keys = colors_keys,
+    .ranks = colors_ranks,
+    .values = colors_values,
+};
+
+int main(void) {
+    // Look up the data of a key
+    if (!phash_contains(&colors, "cyan")) {
+        // Handle error
+        return EXIT_FAILURE;
+    }
+    uintptr_t rgb = (uintptr_t)phash_get(&colors, "cyan");
+    info("cyan is #%06lx", (unsigned long)rgb);
+
+    // Dispatch on the position of a key
+    switch (phash_index(&colors, "yellow")) {
+    case ColorRed:
+    case ColorYellow:
+    case ColorMagenta:
+        info("yellow has some red in it");
+        break;
+    default:
+        info("yellow has no red in it");
+    }
+
+    // Look up a key which is not in the table
+    if (phash_index(&colors, "purple") != colors.len) {
+        // Handle error
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,35 @@
+#include <stdlib.h> // for EXIT_FAILURE, EXIT_SUCCESS
+
+#include <zakc/log.h>   // for info
+#include <zakc/pool.h>  // for pool
+#include <zakc/types.h> // for i64, usize
+
+// Square each number in a chunk of the array
+static void square(usize start, usize end, void *context) {
+    i64 *nums = context;
+    for (usize i = start; i < end; i++) {
+        nums[i] *= nums[i];
+    }
+}
+
+int main(void) {
+    // Create a new thread pool with one worker per CPU
+    struct pool *pool = pool_new(0, false);
+    if (!pool) {
+        // Handle error
+        return EXIT_FAILURE;
+    }
+
+    // Square some numbers in parallel
+    i64 nums[1000];
+    for (usize i = 0; i < 1000; i++) {
+        nums[i] = i;
+    }
+    pool_parallel_for(pool, 0, 1000, 0, square, nums);
+    info("The square of 999 is %lld.", nums[999]);
+
+    // Clean up
+    pool_drop(pool);
+
+    return EXIT_SUCCESS;
+}
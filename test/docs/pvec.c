@@ -0,0 +1,38 @@
+#include <stdlib.h> // for EXIT_FAILURE, EXIT_SUCCESS
+
+#include <zakc/log.h>   // for info
+#include <zakc/pvec.h>  // for pvec
+#include <zakc/types.h> // for i64, usize
+
+int main(void) {
+    // Build a persistent vector in bulk using a transient
+    struct pvec *vec = pvec_new();
+    struct pvec *tmp = pvec_transient(vec);
+    if (!vec || !tmp) {
+        // Handle error
+        return EXIT_FAILURE;
+    }
+    for (i64 i = 0; i < 100; i++) {
+        pvec_transient_append(tmp, (void *)i);
+    }
+    pvec_drop(vec);
+    vec = pvec_persistent(tmp);
+
+    // Take a snapshot, then update the vector
+    struct pvec *snap = pvec_snapshot(vec);
+    struct pvec *next = pvec_set(vec, 42, (void *)(i64)-1);
+
+    // The snapshot is unaffected by the update
+    info(
+        "The snapshot contains %lld, the new version contains %lld.",
+        (i64)pvec_get(snap, 42),
+        (i64)pvec_get(next, 42)
+    );
+
+    // Clean up
+    pvec_drop(next);
+    pvec_drop(snap);
+    pvec_drop(vec);
+
+    return EXIT_SUCCESS;
+}
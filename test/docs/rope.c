@@ -0,0 +1,39 @@
+#include <stdlib.h> // for EXIT_FAILURE, EXIT_SUCCESS
+
+#include <zakc/log.h>   // for info
+#include <zakc/rope.h>  // for rope
+#include <zakc/types.h> // for i64
+
+int main(void) {
+    // Create a new rope
+    struct rope *rope = rope_new();
+    if (!rope) {
+        // Handle error
+        return EXIT_FAILURE;
+    }
+
+    // Add some elements to the rope
+    for (i64 i = 0; i < 1000; i++) {
+        rope_append(rope, (void *)i);
+    }
+
+    // Edit the middle of the rope
+    rope_insert(rope, 500, (void *)(i64)-1);
+    rope_remove(rope, 100);
+
+    // Split the rope in two, then join the halves back together
+    struct rope *rest = rope_split(rope, 600);
+    info(
+        "The halves have %zu and %zu elements.", rope_len(rope), rope_len(rest)
+    );
+    rope_concat(rope, rest);
+
+    // Print the element which was inserted
+    info("The element at index 499 is %lld.", (i64)rope_get(rope, 499));
+
+    // Clean up
+    rope_drop(rest);
+    rope_drop(rope);
+
+    return EXIT_SUCCESS;
+}
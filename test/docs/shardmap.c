@@ -0,0 +1,38 @@
+#include <stdint.h> // for uintptr_t
+#include <stdlib.h> // for EXIT_FAILURE, EXIT_SUCCESS
+
+#include <zakc/hashmap.h>  // for hashmap, u64_{cmp,hash}
+#include <zakc/log.h>      // for info
+#include <zakc/shardmap.h> // for shardmap
+#include <zakc/types.h>    // for usize
+
+// Count a hit for a key, on the thread owning its shard
+static void hit(struct hashmap *shard, const void *key, void *context) {
+    usize hits = (usize)hashmap_get(shard, key);
+    hashmap_insert(shard, key, (void *)(hits + 1));
+}
+
+int main(void) {
+    // Create a sharded hash map with one shard per NUMA node
+    struct shardmap *map = shardmap_new(u64_hash, u64_cmp, 0);
+    if (!map) {
+        // Handle error
+        return EXIT_FAILURE;
+    }
+
+    // Route a hit for each page to the owner of its shard
+    uintptr_t pages[] = {7, 3, 7, 7, 3, 9};
+    for (usize i = 0; i < 6; i++) {
+        shardmap_submit(map, (void *)pages[i], hit, NULL);
+    }
+    shardmap_wait(map);
+
+    // Look up the number of hits directly
+    info("Page 7 has %zu hits.", (usize)shardmap_get(map, (void *)7));
+    info("%zu pages were hit.", shardmap_len(map));
+
+    // Clean up
+    shardmap_drop(map);
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,52 @@
+#include <stdlib.h> // for EXIT_FAILURE, EXIT_SUCCESS
+
+#include <zakc/hashmap.h> // for str_hash
+#include <zakc/log.h>     // for info
+#include <zakc/sketch.h>  // for cms, hll
+#include <zakc/types.h>   // for u8, usize
+
+int main(void) {
+    // Create a HyperLogLog and a Count-Min sketch for each of two workers
+    struct hll *hlls[2] = {hll_new(12), hll_new(12)};
+    struct cms *cmss[2] = {cms_new(1024, 4, true), cms_new(1024, 4, true)};
+    if (!hlls[0] || !hlls[1] || !cmss[0] || !cmss[1]) {
+        // Handle error
+        return EXIT_FAILURE;
+    }
+
+    // Count the words each worker sees
+    const char *words[2][4] = {
+        {"apple", "banana", "apple", "cherry"},
+        {"apple", "durian", "apple", "banana"},
+    };
+    for (usize w = 0; w < 2; w++) {
+        for (usize i = 0; i < 4; i++) {
+            hll_add(hlls[w], str_hash(words[w][i]));
+            cms_add(cmss[w], str_hash(words[w][i]), 1);
+        }
+    }
+
+    // Send the second worker's sketch as bytes, as if to another process
+    u8 buf[64];
+    usize len = hll_serialize(hlls[1], buf, sizeof(buf));
+    struct hll *copy = hll_deserialize(buf, len);
+    if (!copy) {
+        // Handle error
+        return EXIT_FAILURE;
+    }
+
+    // Combine the counts of both workers
+    hll_merge(hlls[0], copy);
+    cms_merge(cmss[0], cmss[1]);
+    info("distinct words: %llu", (unsigned long long)hll_count(hlls[0]));
+    info("apples: %u", cms_estimate(cmss[0], str_hash("apple")));
+
+    // Clean up
+    for (usize w = 0; w < 2; w++) {
+        hll_drop(hlls[w]);
+        cms_drop(cmss[w]);
+    }
+    hll_drop(copy);
+
+    return EXIT_SUCCESS;
+}
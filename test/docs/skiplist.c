@@ -0,0 +1,44 @@
+#include <stdlib.h> // for EXIT_FAILURE, EXIT_SUCCESS
+
+#include <zakc/log.h>      // for info
+#include <zakc/skiplist.h> // for skiplist
+#include <zakc/types.h>    // for i32, u64
+
+// Compare two timestamps
+static i32 cmp(const void *left, const void *right) {
+    u64 lhs = (u64)left;
+    u64 rhs = (u64)right;
+    return (lhs > rhs) - (lhs < rhs);
+}
+
+// Print an event
+static void show(const void *key, void *data, void *context) {
+    info("%llu: %s", (u64)key, (char *)data);
+}
+
+int main(void) {
+    // Create a new skip list ordered by timestamp
+    struct skiplist *list = skiplist_new(cmp);
+    if (!list) {
+        // Handle error
+        return EXIT_FAILURE;
+    }
+
+    // Insert some events out of order
+    skiplist_insert(list, (void *)30, "stop");
+    skiplist_insert(list, (void *)10, "start");
+    skiplist_insert(list, (void *)20, "pause");
+
+    // Print the events from timestamp 15 onwards
+    skiplist_range(list, (void *)15, NULL, show, NULL);
+
+    // Find the first event at or after timestamp 11
+    const void *key;
+    char *event = skiplist_lower_bound(list, (void *)11, &key);
+    info("The first event after 11 is %s at %llu.", event, (u64)key);
+
+    // Clean up
+    skiplist_drop(list);
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,34 @@
+#include <stdlib.h> // for EXIT_FAILURE, EXIT_SUCCESS
+
+#include <zakc/log.h>   // for info
+#include <zakc/soa.h>   // for ZAKC_SOA_DEFINE
+#include <zakc/types.h> // for f64, u64, usize
+
+// Define a container of events, with one column per field
+ZAKC_SOA_DEFINE(events, (u64, ts), (u32, kind), (f64, value))
+
+int main(void) {
+    // Create a new container
+    struct events *evs = events_new();
+    if (!evs) {
+        // Handle error
+        return EXIT_FAILURE;
+    }
+
+    // Append some records to the container
+    events_append(evs, 100, 1, 0.5);
+    events_append(evs, 200, 2, 1.5);
+    events_append(evs, 300, 1, 2.5);
+
+    // Scan a single column
+    usize recent = 0;
+    for (usize i = 0; i < events_len(evs); i++) {
+        recent += evs->ts[i] >= 200;
+    }
+    info("%zu events are recent.", recent);
+
+    // Clean up
+    events_drop(evs);
+
+    return EXIT_SUCCESS;
+}